@@ -0,0 +1,23 @@
+@echo off
+rem Compile runtime shaders in this directory to SPIR-V (output next to the sources).
+rem eden_vulkan_helpers.cpp looks for them in shaders/, ../shaders/ and ../../shaders/.
+
+setlocal
+cd /d "%~dp0"
+
+if not defined VULKAN_SDK (
+    echo VULKAN_SDK is not set. Please set it to your Vulkan SDK root, e.g. C:\VulkanSDK\1.4.328.1
+    goto :eof
+)
+
+set GLSLC="%VULKAN_SDK%\Bin\glslc.exe"
+
+%GLSLC% -fshader-stage=vertex vert_cube_instanced.glsl -o vert_cube_instanced.spv
+if errorlevel 1 goto :eof
+
+%GLSLC% -fshader-stage=fragment --target-env=vulkan1.2 frag_cube_bindless.glsl -o frag_cube_bindless.spv
+if errorlevel 1 goto :eof
+
+echo Runtime shaders compiled.
+
+endlocal
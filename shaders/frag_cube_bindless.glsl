@@ -0,0 +1,27 @@
+#version 450
+#extension GL_EXT_nonuniform_qualifier : require
+
+// Bindless cube fragment shader: same shading as frag_cube.spv, but the texture comes from the
+// texture table (set 1) indexed by the instance's slot instead of the per-batch sampler.
+
+layout(set = 1, binding = 0) uniform sampler2D textureTable[];
+
+layout(location = 0) in vec2 fragUV;
+layout(location = 1) in vec3 fragColor;
+layout(location = 2) flat in uint fragTextureSlot;
+
+layout(location = 0) out vec4 outColor;
+
+void main() {
+    // UV (0,0) marks vertex-color-only geometry
+    if (abs(fragUV.x) < 0.01 && abs(fragUV.y) < 0.01) {
+        outColor = vec4(fragColor, 1.0);
+        return;
+    }
+
+    vec4 tex = texture(textureTable[nonuniformEXT(fragTextureSlot)], fragUV);
+    if (tex.a < 0.01) {
+        discard;
+    }
+    outColor = vec4(tex.rgb * fragColor, tex.a);
+}
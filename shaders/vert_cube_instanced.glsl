@@ -0,0 +1,52 @@
+#version 450
+
+// Instanced cube vertex shader.
+// Binding 0: unit cube (same layout as Vertex in eden_vulkan_helpers.cpp)
+// Binding 1: CubeInstance (position, Euler rotation in degrees, scale, tint, texture slot)
+// Pairs with frag_cube.spv (fragUV at location 0, fragColor at location 1).
+
+layout(binding = 0) uniform UniformBufferObject {
+    mat4 view;
+    mat4 proj;
+} ubo;
+
+layout(push_constant) uniform PushConsts {
+    mat4 model;  // Identity for instanced batches, kept so the pipeline layout is shared
+} push;
+
+layout(location = 0) in vec3 inPosition;
+layout(location = 1) in vec2 inUV;
+layout(location = 2) in vec3 inColor;
+
+layout(location = 3) in vec3 instPos;
+layout(location = 4) in vec3 instRot;
+layout(location = 5) in vec3 instScale;
+layout(location = 6) in vec3 instColor;
+layout(location = 7) in uint instTextureSlot;
+
+layout(location = 0) out vec2 fragUV;
+layout(location = 1) out vec3 fragColor;
+layout(location = 2) flat out uint fragTextureSlot;
+layout(location = 3) flat out uint vMeshID;  // Read by frag_cube.spv; instanced cubes have no mesh ID
+
+vec3 rotateX(vec3 p, float s, float c) { return vec3(p.x, c * p.y - s * p.z, s * p.y + c * p.z); }
+vec3 rotateY(vec3 p, float s, float c) { return vec3(c * p.x + s * p.z, p.y, -s * p.x + c * p.z); }
+vec3 rotateZ(vec3 p, float s, float c) { return vec3(c * p.x - s * p.y, s * p.x + c * p.y, p.z); }
+
+void main() {
+    // Same order as the CPU path: translate * rotX * rotY * rotZ * scale
+    vec3 r = radians(instRot);
+    vec3 sr = sin(r);
+    vec3 cr = cos(r);
+    vec3 p = inPosition * instScale;
+    p = rotateZ(p, sr.z, cr.z);
+    p = rotateY(p, sr.y, cr.y);
+    p = rotateX(p, sr.x, cr.x);
+    p += instPos;
+
+    gl_Position = ubo.proj * ubo.view * push.model * vec4(p, 1.0);
+    fragUV = inUV;
+    fragColor = inColor * instColor;
+    fragTextureSlot = instTextureSlot;
+    vMeshID = 0u;
+}
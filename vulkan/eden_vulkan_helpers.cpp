@@ -9,16 +9,43 @@
 #include <thread>
 #include <chrono>
 #include <cmath>
+#include <cfloat>  // For FLT_MAX
 #include <algorithm>
 #include <array>
 #include <fstream>
 #include <cstdlib>  // For std::abs
 #include <map>  // For combination tracking
+#include <unordered_map>  // For vertex welding
 #include <functional>  // For std::function
 #include <set>  // For tracking begun windows
 #include <stack>  // For tracking open windows stack
 #include <string>  // For window name tracking
 #include <queue>  // For BFS in combination logic
+#include <deque>  // For texture streaming queues
+#include <mutex>  // For texture streaming workers
+#include <condition_variable>  // For texture streaming workers
+
+// SIMD: AVX when the compiler targets it (-mavx / /arch:AVX), otherwise SSE on x86-64, otherwise
+// scalar. Define EDEN_NO_SIMD to force the scalar paths.
+#if !defined(EDEN_NO_SIMD) && defined(__AVX__)
+#include <immintrin.h>
+#define EDEN_SIMD_AVX 1
+#elif !defined(EDEN_NO_SIMD) && (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+#include <emmintrin.h>
+#define EDEN_SIMD_SSE 1
+#endif
+// SIMD (frustum culling, ray-box kernel): additionally an AVX2 path on any x86 build, compiled
+// with a target attribute and selected at runtime from CPUID (cpuSupportsAvx2).
+#if !defined(EDEN_NO_SIMD) && (defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86))
+#include <immintrin.h>
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#define EDEN_TARGET_AVX2
+#else
+#define EDEN_TARGET_AVX2 __attribute__((target("avx2")))
+#endif
+#define EDEN_SIMD_AVX2_DISPATCH 1
+#endif
 #define STB_IMAGE_IMPLEMENTATION
 #include "../third_party/stb_image.h"
 #include <sstream>
@@ -29,6 +56,9 @@
 #include <GLFW/glfw3native.h>  // For glfwGetWin32Window
 #else
 #include <sys/stat.h>  // For mkdir on Unix
+#include <sys/mman.h>  // For mapping cooked textures
+#include <fcntl.h>
+#include <unistd.h>
 #endif
 
 // Native File Dialog Extended
@@ -90,6 +120,95 @@ struct Vertex {
     }
 };
 
+// Packed mesh vertex (16 bytes instead of 32) for the packed mesh pipeline.
+// Positions are snorm16 relative to the mesh bounds; the per-mesh dequantisation (center + extent)
+// is folded into the model matrix, so the regular cube shaders consume it unchanged - the vertex
+// fetch converts snorm16 / half / unorm8 to the float inputs they declare.
+struct PackedVertex {
+    int16_t pos[4];     // x, y, z snorm16 (w unused, keeps the attribute 8-byte aligned)
+    uint16_t uv[2];     // Half-float UVs
+    uint8_t color[4];   // RGBA8 unorm (alpha unused)
+
+    static VkVertexInputBindingDescription getBindingDescription() {
+        VkVertexInputBindingDescription bindingDescription = {};
+        bindingDescription.binding = 0;
+        bindingDescription.stride = sizeof(PackedVertex);
+        bindingDescription.inputRate = VK_VERTEX_INPUT_RATE_VERTEX;
+        return bindingDescription;
+    }
+
+    static std::array<VkVertexInputAttributeDescription, 3> getAttributeDescriptions() {
+        std::array<VkVertexInputAttributeDescription, 3> attributeDescriptions = {};
+
+        attributeDescriptions[0].binding = 0;
+        attributeDescriptions[0].location = 0;
+        attributeDescriptions[0].format = VK_FORMAT_R16G16B16A16_SNORM;
+        attributeDescriptions[0].offset = offsetof(PackedVertex, pos);
+
+        attributeDescriptions[1].binding = 0;
+        attributeDescriptions[1].location = 1;
+        attributeDescriptions[1].format = VK_FORMAT_R16G16_SFLOAT;
+        attributeDescriptions[1].offset = offsetof(PackedVertex, uv);
+
+        attributeDescriptions[2].binding = 0;
+        attributeDescriptions[2].location = 2;
+        attributeDescriptions[2].format = VK_FORMAT_R8G8B8A8_UNORM;
+        attributeDescriptions[2].offset = offsetof(PackedVertex, color);
+
+        return attributeDescriptions;
+    }
+};
+
+// Per-instance cube data for the instanced cube pipeline (binding 1, one entry per cube).
+// The vertex shader expands the unit cube (binding 0) with T * Rx * Ry * Rz * S, matching the
+// glm::rotate chain used by the per-vertex path. Rotations are in degrees.
+struct CubeInstance {
+    float pos[3];
+    float rot[3];
+    float scale[3];
+    float color[3];      // Tint, multiplied with the texture
+    uint32_t textureSlot;  // Texture table slot (0 = default texture)
+
+    static VkVertexInputBindingDescription getBindingDescription() {
+        VkVertexInputBindingDescription bindingDescription = {};
+        bindingDescription.binding = 1;
+        bindingDescription.stride = sizeof(CubeInstance);
+        bindingDescription.inputRate = VK_VERTEX_INPUT_RATE_INSTANCE;
+        return bindingDescription;
+    }
+
+    static std::array<VkVertexInputAttributeDescription, 5> getAttributeDescriptions() {
+        std::array<VkVertexInputAttributeDescription, 5> attributeDescriptions = {};
+
+        attributeDescriptions[0].binding = 1;
+        attributeDescriptions[0].location = 3;
+        attributeDescriptions[0].format = VK_FORMAT_R32G32B32_SFLOAT;
+        attributeDescriptions[0].offset = offsetof(CubeInstance, pos);
+
+        attributeDescriptions[1].binding = 1;
+        attributeDescriptions[1].location = 4;
+        attributeDescriptions[1].format = VK_FORMAT_R32G32B32_SFLOAT;
+        attributeDescriptions[1].offset = offsetof(CubeInstance, rot);
+
+        attributeDescriptions[2].binding = 1;
+        attributeDescriptions[2].location = 5;
+        attributeDescriptions[2].format = VK_FORMAT_R32G32B32_SFLOAT;
+        attributeDescriptions[2].offset = offsetof(CubeInstance, scale);
+
+        attributeDescriptions[3].binding = 1;
+        attributeDescriptions[3].location = 6;
+        attributeDescriptions[3].format = VK_FORMAT_R32G32B32_SFLOAT;
+        attributeDescriptions[3].offset = offsetof(CubeInstance, color);
+
+        attributeDescriptions[4].binding = 1;
+        attributeDescriptions[4].location = 7;
+        attributeDescriptions[4].format = VK_FORMAT_R32_UINT;
+        attributeDescriptions[4].offset = offsetof(CubeInstance, textureSlot);
+
+        return attributeDescriptions;
+    }
+};
+
 // Uniform buffer object (View/Proj only)
 struct UniformBufferObject {
     glm::mat4 view;
@@ -110,6 +229,8 @@ static VkSwapchainKHR g_swapchain = VK_NULL_HANDLE;
 static VkRenderPass g_renderPass = VK_NULL_HANDLE;
 static VkPipeline g_pipeline = VK_NULL_HANDLE;
 static VkPipeline g_linePipeline = VK_NULL_HANDLE; // Line Pipeline
+static VkPipeline g_packedMeshPipeline = VK_NULL_HANDLE; // Triangle pipeline fed with PackedVertex (null if the formats are unsupported)
+static VkPipeline g_cubeInstancedPipeline = VK_NULL_HANDLE; // Instanced cube pipeline (null if vert_cube_instanced.spv is missing)
 static VkPipelineLayout g_pipelineLayout = VK_NULL_HANDLE;
 static std::vector<VkFramebuffer> g_framebuffers;
 static VkCommandPool g_commandPool = VK_NULL_HANDLE;
@@ -118,8 +239,332 @@ static VkQueue g_graphicsQueue = VK_NULL_HANDLE;
 static uint32_t g_graphicsQueueFamilyIndex = 0;
 static bool g_commandBufferStarted = false;  // Track if command buffer was started this frame
 
+// Null backend (heidic_init_renderer_null): no instance, device or command buffer. Handles that CPU
+// paths test or sort by (pipelines, cube/mesh buffers, descriptor sets) get unique non-null
+// placeholders that are never passed to Vulkan.
+static bool g_nullRenderer = false;
+static uint64_t g_nullHandleCounter = 0;
+
+template <typename T>
+static T nullRendererHandle() {
+    return (T)(uintptr_t)++g_nullHandleCounter;
+}
+
+
+// ============================================================================
+// GPU MEMORY SUB-ALLOCATOR
+// ============================================================================
+// Buffers and images are placed in large VkDeviceMemory blocks instead of owning one allocation
+// each. Blocks are kept per memory type and per resource class (buffers and optimal-tiling images
+// never share a block, so bufferImageGranularity never applies). Two pools:
+//   - general: first-fit free list with neighbour merging, for anything that may be freed
+//   - linear:  bump allocation for resources that live until shutdown; a block rewinds once every
+//              allocation in it has been freed
+// Host-visible blocks are mapped once; GpuAllocation::mapped points at the allocation's bytes.
+// Requests larger than half a block get a dedicated block of their own.
+
+static const VkDeviceSize GPU_MEMORY_BLOCK_SIZE = 64 * 1024 * 1024;
+static const VkDeviceSize GPU_MEMORY_MIN_FREE_RANGE = 256;  // Smaller leftovers are folded into the allocation (counted as waste)
+
+enum GpuResourceClass {
+    GPU_RESOURCE_BUFFER = 0,
+    GPU_RESOURCE_TEXTURE = 1,     // Sampled images (counted by heidic_get_texture_memory_mb)
+    GPU_RESOURCE_ATTACHMENT = 2,  // Depth and other render targets (images, own blocks like textures)
+};
+
+// A range of a memory block; memory/offset are what vkBind*Memory received
+struct GpuAllocation {
+    VkDeviceMemory memory = VK_NULL_HANDLE;
+    VkDeviceSize offset = 0;       // Bind offset (aligned)
+    VkDeviceSize rangeOffset = 0;  // Start of the range taken from the block (<= offset)
+    VkDeviceSize size = 0;         // Bytes taken from the block, padding included
+    VkDeviceSize wasted = 0;       // Alignment padding and leftovers too small to reuse
+    char* mapped = nullptr;        // Host pointer at offset (host-visible memory only)
+    int32_t block = -1;            // Index into g_memoryBlocks, -1 = nothing allocated
+    GpuResourceClass resourceClass = GPU_RESOURCE_BUFFER;
+};
+
+struct MemoryBlock {
+    VkDeviceMemory memory = VK_NULL_HANDLE;  // VK_NULL_HANDLE = unused slot
+    VkDeviceSize size = 0;
+    uint32_t memoryType = 0;
+    bool imageBlock = false;
+    bool linear = false;
+    bool dedicated = false;
+    char* mapped = nullptr;
+    VkDeviceSize linearHead = 0;
+    uint32_t allocationCount = 0;
+    std::map<VkDeviceSize, VkDeviceSize> freeRanges;  // Offset -> size (general pool only)
+};
+
+struct GpuMemoryStats {
+    uint64_t blockBytes = 0;    // Reserved with vkAllocateMemory
+    uint64_t usedBytes = 0;     // Handed out to resources (waste included)
+    uint64_t wastedBytes = 0;   // Alignment padding and leftovers too small to reuse
+    uint64_t textureBytes = 0;  // usedBytes of sampled images
+    uint32_t blockCount = 0;
+    uint32_t allocationCount = 0;
+};
+
+static std::vector<MemoryBlock> g_memoryBlocks;
+static GpuMemoryStats g_gpuMemoryStats;
+
+static uint32_t findMemoryType(uint32_t typeFilter, VkMemoryPropertyFlags properties);
+
+static VkDeviceSize alignUp(VkDeviceSize value, VkDeviceSize alignment) {
+    return alignment > 1 ? (value + alignment - 1) / alignment * alignment : value;
+}
+
+static int32_t createMemoryBlock(uint32_t memoryType, VkDeviceSize size, bool imageBlock, bool linear, bool dedicated) {
+    VkMemoryAllocateInfo allocInfo = {};
+    allocInfo.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
+    allocInfo.allocationSize = size;
+    allocInfo.memoryTypeIndex = memoryType;
+    
+    MemoryBlock block;
+    if (vkAllocateMemory(g_device, &allocInfo, nullptr, &block.memory) != VK_SUCCESS) {
+        std::cerr << "[EDEN] Failed to allocate " << size << " bytes of device memory (type " << memoryType << ")" << std::endl;
+        return -1;
+    }
+    
+    VkPhysicalDeviceMemoryProperties memProperties;
+    vkGetPhysicalDeviceMemoryProperties(g_physicalDevice, &memProperties);
+    if (memProperties.memoryTypes[memoryType].propertyFlags & VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT) {
+        void* mapped = nullptr;
+        if (vkMapMemory(g_device, block.memory, 0, VK_WHOLE_SIZE, 0, &mapped) == VK_SUCCESS) {
+            block.mapped = static_cast<char*>(mapped);
+        }
+    }
+    
+    block.size = size;
+    block.memoryType = memoryType;
+    block.imageBlock = imageBlock;
+    block.linear = linear;
+    block.dedicated = dedicated;
+    if (!linear) block.freeRanges[0] = size;
+    
+    g_gpuMemoryStats.blockBytes += size;
+    g_gpuMemoryStats.blockCount++;
+    
+    for (size_t i = 0; i < g_memoryBlocks.size(); i++) {
+        if (g_memoryBlocks[i].memory == VK_NULL_HANDLE) {
+            g_memoryBlocks[i] = block;
+            return (int32_t)i;
+        }
+    }
+    g_memoryBlocks.push_back(block);
+    return (int32_t)g_memoryBlocks.size() - 1;
+}
+
+static void destroyMemoryBlock(int32_t index) {
+    MemoryBlock& block = g_memoryBlocks[index];
+    vkFreeMemory(g_device, block.memory, nullptr);  // Unmaps implicitly
+    g_gpuMemoryStats.blockBytes -= block.size;
+    g_gpuMemoryStats.blockCount--;
+    block = MemoryBlock();
+}
+
+// Carve size bytes at the given alignment out of a block; false if it does not fit
+static bool allocateFromBlock(int32_t index, VkDeviceSize size, VkDeviceSize alignment, GpuAllocation& out) {
+    MemoryBlock& block = g_memoryBlocks[index];
+    VkDeviceSize offset;
+    VkDeviceSize start;
+    VkDeviceSize end;
+    
+    if (block.linear) {
+        offset = alignUp(block.linearHead, alignment);
+        if (offset + size > block.size) return false;
+        start = block.linearHead;
+        end = offset + size;
+        block.linearHead = end;
+    } else {
+        // First fit
+        auto it = block.freeRanges.begin();
+        for (; it != block.freeRanges.end(); ++it) {
+            offset = alignUp(it->first, alignment);
+            if (offset + size <= it->first + it->second) break;
+        }
+        if (it == block.freeRanges.end()) return false;
+        
+        VkDeviceSize rangeStart = it->first;
+        VkDeviceSize rangeEnd = it->first + it->second;
+        block.freeRanges.erase(it);
+        
+        start = rangeStart;
+        if (offset - rangeStart >= GPU_MEMORY_MIN_FREE_RANGE) {
+            block.freeRanges[rangeStart] = offset - rangeStart;
+            start = offset;
+        }
+        end = offset + size;
+        if (rangeEnd - end >= GPU_MEMORY_MIN_FREE_RANGE) {
+            block.freeRanges[end] = rangeEnd - end;
+        } else {
+            end = rangeEnd;
+        }
+    }
+    
+    out.memory = block.memory;
+    out.offset = offset;
+    out.rangeOffset = start;
+    out.size = end - start;
+    out.wasted = out.size - size;
+    out.mapped = block.mapped ? block.mapped + offset : nullptr;
+    out.block = index;
+    block.allocationCount++;
+    return true;
+}
+
+// Sub-allocate memory for a resource. linear = lives until shutdown (bump-allocated pool).
+static bool allocateGpuMemory(const VkMemoryRequirements& requirements, VkMemoryPropertyFlags properties,
+                              GpuResourceClass resourceClass, GpuAllocation& out, bool linear = false) {
+    uint32_t memoryType = findMemoryType(requirements.memoryTypeBits, properties);
+    bool imageBlock = resourceClass != GPU_RESOURCE_BUFFER;
+    
+    int32_t index = -1;
+    if (requirements.size > GPU_MEMORY_BLOCK_SIZE / 2) {
+        index = createMemoryBlock(memoryType, requirements.size, imageBlock, false, true);
+        if (index < 0 || !allocateFromBlock(index, requirements.size, requirements.alignment, out)) return false;
+    } else {
+        for (size_t i = 0; i < g_memoryBlocks.size(); i++) {
+            const MemoryBlock& block = g_memoryBlocks[i];
+            if (block.memory == VK_NULL_HANDLE || block.dedicated || block.memoryType != memoryType ||
+                block.imageBlock != imageBlock || block.linear != linear) {
+                continue;
+            }
+            if (allocateFromBlock((int32_t)i, requirements.size, requirements.alignment, out)) {
+                index = (int32_t)i;
+                break;
+            }
+        }
+        if (index < 0) {
+            index = createMemoryBlock(memoryType, GPU_MEMORY_BLOCK_SIZE, imageBlock, linear, false);
+            if (index < 0 || !allocateFromBlock(index, requirements.size, requirements.alignment, out)) return false;
+        }
+    }
+    
+    out.resourceClass = resourceClass;
+    g_gpuMemoryStats.usedBytes += out.size;
+    g_gpuMemoryStats.wastedBytes += out.wasted;
+    if (resourceClass == GPU_RESOURCE_TEXTURE) g_gpuMemoryStats.textureBytes += out.size;
+    g_gpuMemoryStats.allocationCount++;
+    return true;
+}
+
+// Return an allocation to its block (the resource bound to it must already be destroyed)
+static void freeGpuMemory(GpuAllocation& alloc) {
+    if (alloc.block < 0) return;
+    MemoryBlock& block = g_memoryBlocks[alloc.block];
+    
+    g_gpuMemoryStats.usedBytes -= alloc.size;
+    g_gpuMemoryStats.wastedBytes -= alloc.wasted;
+    if (alloc.resourceClass == GPU_RESOURCE_TEXTURE) g_gpuMemoryStats.textureBytes -= alloc.size;
+    g_gpuMemoryStats.allocationCount--;
+    block.allocationCount--;
+    
+    if (!block.linear) {
+        // Insert the range, merging with free neighbours
+        VkDeviceSize start = alloc.rangeOffset;
+        VkDeviceSize size = alloc.size;
+        auto next = block.freeRanges.lower_bound(start);
+        if (next != block.freeRanges.end() && start + size == next->first) {
+            size += next->second;
+            next = block.freeRanges.erase(next);
+        }
+        if (next != block.freeRanges.begin()) {
+            auto prev = std::prev(next);
+            if (prev->first + prev->second == start) {
+                start = prev->first;
+                size += prev->second;
+            }
+        }
+        block.freeRanges[start] = size;
+    }
+    
+    if (block.allocationCount == 0) {
+        bool keep = !block.dedicated;
+        if (keep) {
+            // Keep one empty block per pool to avoid allocate/free churn
+            for (size_t i = 0; i < g_memoryBlocks.size(); i++) {
+                const MemoryBlock& other = g_memoryBlocks[i];
+                if ((int32_t)i != alloc.block && other.memory != VK_NULL_HANDLE && !other.dedicated &&
+                    other.memoryType == block.memoryType && other.imageBlock == block.imageBlock && other.linear == block.linear) {
+                    keep = false;
+                    break;
+                }
+            }
+        }
+        if (keep) {
+            block.linearHead = 0;
+        } else {
+            destroyMemoryBlock(alloc.block);
+        }
+    }
+    alloc = GpuAllocation();
+}
+
+static bool allocateBufferMemory(VkBuffer buffer, VkMemoryPropertyFlags properties, GpuAllocation& out, bool linear = false) {
+    VkMemoryRequirements memRequirements;
+    vkGetBufferMemoryRequirements(g_device, buffer, &memRequirements);
+    if (!allocateGpuMemory(memRequirements, properties, GPU_RESOURCE_BUFFER, out, linear)) return false;
+    vkBindBufferMemory(g_device, buffer, out.memory, out.offset);
+    return true;
+}
+
+static bool allocateImageMemory(VkImage image, VkMemoryPropertyFlags properties, GpuResourceClass resourceClass, GpuAllocation& out, bool linear = false) {
+    VkMemoryRequirements memRequirements;
+    vkGetImageMemoryRequirements(g_device, image, &memRequirements);
+    if (!allocateGpuMemory(memRequirements, properties, resourceClass, out, linear)) return false;
+    vkBindImageMemory(g_device, image, out.memory, out.offset);
+    return true;
+}
+
+static void destroyBuffer(VkBuffer& buffer, GpuAllocation& alloc) {
+    if (buffer != VK_NULL_HANDLE && !g_nullRenderer) vkDestroyBuffer(g_device, buffer, nullptr);
+    buffer = VK_NULL_HANDLE;
+    freeGpuMemory(alloc);
+}
+
+static void destroyImage(VkImage& image, GpuAllocation& alloc) {
+    if (image != VK_NULL_HANDLE) vkDestroyImage(g_device, image, nullptr);
+    image = VK_NULL_HANDLE;
+    freeGpuMemory(alloc);
+}
+
+// Memory stats (sizes in MB)
+extern "C" float heidic_get_texture_memory_mb() {
+    return (float)(g_gpuMemoryStats.textureBytes / (1024.0 * 1024.0));
+}
+
+extern "C" float heidic_get_gpu_memory_reserved_mb() {
+    return (float)(g_gpuMemoryStats.blockBytes / (1024.0 * 1024.0));
+}
+
+extern "C" float heidic_get_gpu_memory_used_mb() {
+    return (float)(g_gpuMemoryStats.usedBytes / (1024.0 * 1024.0));
+}
+
+extern "C" float heidic_get_gpu_memory_wasted_mb() {
+    return (float)(g_gpuMemoryStats.wastedBytes / (1024.0 * 1024.0));
+}
+
+extern "C" int heidic_get_gpu_memory_block_count() {
+    return static_cast<int>(g_gpuMemoryStats.blockCount);
+}
+
+extern "C" int heidic_get_gpu_allocation_count() {
+    return static_cast<int>(g_gpuMemoryStats.allocationCount);
+}
+
 // Dock ID tracking removed - no longer needed
+// Frames-in-flight ring: g_currentFrame indexes per-frame resources (fence, acquire semaphore,
+// command buffer, UBO, descriptor sets); g_currentImageIndex is the acquired swapchain image
+// (framebuffer, render-finished semaphore, present). The two are deliberately decoupled.
+#ifndef EDEN_MAX_FRAMES_IN_FLIGHT
+#define EDEN_MAX_FRAMES_IN_FLIGHT 2
+#endif
+static uint32_t g_maxFramesInFlight = EDEN_MAX_FRAMES_IN_FLIGHT;  // Set before init via heidic_set_frames_in_flight()
 static uint32_t g_currentFrame = 0;
+static uint32_t g_currentImageIndex = 0;
 static VkExtent2D g_swapchainExtent = {};
 
 // Simple combination rename state (for new Outliner2)
@@ -138,16 +583,39 @@ static std::stack<std::string> g_openWindowsStack;
 // Additional state
 static std::vector<VkImage> g_swapchainImages;
 static std::vector<VkImageView> g_swapchainImageViews;
-static std::vector<VkSemaphore> g_imageAvailableSemaphores;  // Per swapchain image
-static std::vector<VkSemaphore> g_renderFinishedSemaphores;  // Per swapchain image
-static VkFence g_inFlightFence = VK_NULL_HANDLE;
-static VkFence g_imageAvailableFence = VK_NULL_HANDLE;  // Separate fence for image acquisition
+static std::vector<VkSemaphore> g_imageAvailableSemaphores;  // Per frame in flight
+static std::vector<VkSemaphore> g_renderFinishedSemaphores;  // Per swapchain image (present may still hold it)
+static std::vector<VkFence> g_inFlightFences;  // Per frame in flight
+static std::vector<VkFence> g_imagesInFlight;  // Per swapchain image: fence of the frame last rendering it
 static uint32_t g_swapchainImageCount = 0;
 static VkFormat g_swapchainImageFormat = VK_FORMAT_UNDEFINED;
 
+// Headless mode (heidic_init_renderer_headless): offscreen color images stand in for the swapchain
+// images, one per frame in flight. No surface, swapchain, present or GLFW call is made.
+static bool g_headless = false;
+static std::vector<GpuAllocation> g_offscreenImageMemory;
+static int32_t g_lastSubmittedImage = -1;  // Offscreen image of the last submitted frame (readback source)
+
+// Frame timing (every mode): wall time between consecutive heidic_begin_frame() calls, and the CPU
+// time heidic_end_frame() spends before submission (batching, culling, sorting, recording, ImGui)
+static std::chrono::high_resolution_clock::time_point g_lastFrameBegin;
+static double g_frameTimeMs = 0.0;
+static double g_endFrameCpuMs = 0.0;
+
+// Null backend run totals, reported by heidic_cleanup_renderer()
+struct NullRendererTotals {
+    uint64_t frames = 0;
+    double frameMs = 0.0;
+    double endFrameCpuMs = 0.0;
+    uint64_t packets = 0;
+    uint64_t drawCalls = 0;
+    uint64_t instances = 0;
+};
+static NullRendererTotals g_nullTotals;
+
 // Depth buffer
 static VkImage g_depthImage = VK_NULL_HANDLE;
-static VkDeviceMemory g_depthImageMemory = VK_NULL_HANDLE;
+static GpuAllocation g_depthImageMemory;
 static VkImageView g_depthImageView = VK_NULL_HANDLE;
 static VkFormat g_depthFormat = VK_FORMAT_D32_SFLOAT;
 
@@ -160,25 +628,52 @@ static VkDescriptorPool g_descriptorPool = VK_NULL_HANDLE;
 static VkDescriptorPool g_imguiDescriptorPool = VK_NULL_HANDLE;
 static std::vector<VkDescriptorSet> g_descriptorSets;
 static std::vector<VkBuffer> g_uniformBuffers;
-static std::vector<VkDeviceMemory> g_uniformBuffersMemory;
-
-// Dynamic Texture Descriptor Pool System
-// Allows switching textures multiple times per frame by having a pool of descriptor sets
-static const int MAX_TEXTURE_SWITCHES_PER_FRAME = 256;
-static std::vector<std::vector<VkDescriptorSet>> g_batchDescriptorSets; // [frame][batch]
-static std::vector<int> g_currentBatchIndex; // [frame]
+static std::vector<GpuAllocation> g_uniformBuffersMemory;
+
+// Bindless Texture Table (descriptor indexing)
+// Every texture gets a stable slot in one large sampler array (set 1, binding 0) that is written
+// once when the texture is created. Cube instances carry their slot, so a whole level of mixed
+// textures draws in one call with no per-frame descriptor writes. Slot 0 is the default texture.
+static const uint32_t MAX_BINDLESS_TEXTURES = 4096;
+static bool g_bindlessSupported = false;  // Device supports the descriptor indexing features we need
+static bool g_textureCompressionBC = false;  // textureCompressionBC enabled (BC cooked texture payloads)
+static uint32_t g_bindlessTextureCapacity = 0;
+static VkDescriptorSetLayout g_bindlessSetLayout = VK_NULL_HANDLE;
+static VkDescriptorPool g_bindlessDescriptorPool = VK_NULL_HANDLE;
+static VkDescriptorSet g_bindlessDescriptorSet = VK_NULL_HANDLE;
+static VkPipelineLayout g_bindlessPipelineLayout = VK_NULL_HANDLE;  // Set 0 (UBO + sampler) + set 1 (texture table)
+static VkPipeline g_cubeBindlessPipeline = VK_NULL_HANDLE;  // Instanced cubes sampling the texture table
+static uint32_t g_nextTextureSlot = 0;
+static std::vector<uint32_t> g_freeTextureSlots;
+static uint32_t g_currentTextureSlot = 0;  // Slot of the texture selected by heidic_load_texture_for_rendering
+
+// Per-texture descriptor sets (fallback when bindless is unavailable)
+// Each texture owns one set per frame in flight (UBO + its sampler), written once at creation, so
+// switching textures is just a bind - no per-flush vkUpdateDescriptorSets and no per-frame limit.
+static const uint32_t TEXTURE_SETS_PER_POOL = 64;
+static std::vector<VkDescriptorPool> g_textureDescriptorPools;
 
 // Texture Cache - keeps all loaded textures alive
 struct TextureResource {
-    VkImage image;
-    VkDeviceMemory memory;
-    VkImageView view;
+    VkImage image = VK_NULL_HANDLE;
+    GpuAllocation memory;
+    VkImageView view = VK_NULL_HANDLE;
+    VkFormat format = VK_FORMAT_R8G8B8A8_UNORM;  // Block-compressed when loaded from a cooked texture
+    uint32_t slot = 0;  // Bindless texture table slot
+    bool resident = true;  // false while streaming in (the default texture is bound instead)
+    bool failed = false;   // Decode failed - heidic_load_texture_for_rendering() returns 0
+    bool evicted = false;  // GPU resources released by the residency budget - reloaded on next use
+    uint64_t lastUsedSerial = 0;  // Last frame submit that could have sampled it
+    uint64_t uploadSerial = 0;   // Upload context serial its pixels were recorded with
+    std::vector<VkDescriptorSet> descriptorSets;  // Fallback per-frame sets (allocated on first use)
+    VkDescriptorPool descriptorPool = VK_NULL_HANDLE;  // Pool descriptorSets came from
 };
 static std::map<std::string, TextureResource> g_textureCache;
+static TextureResource* g_currentTexture = nullptr;  // Cache entry selected for rendering (nullptr = init default texture)
 
 // Texture resources (current global texture - points to cached texture)
 static VkImage g_textureImage = VK_NULL_HANDLE;
-static VkDeviceMemory g_textureImageMemory = VK_NULL_HANDLE;
+static GpuAllocation g_textureImageMemory;
 static VkImageView g_textureImageView = VK_NULL_HANDLE;
 static VkSampler g_textureSampler = VK_NULL_HANDLE;
 // Deferred descriptor set update (to avoid updating during command buffer recording)
@@ -186,10 +681,6 @@ static VkImageView g_pendingDescriptorTextureImageView = VK_NULL_HANDLE;
 static bool g_pendingDescriptorUpdate = false;
 // Track which texture is currently bound to the descriptor set
 static VkImageView g_currentBoundTextureImageView = VK_NULL_HANDLE;
-// Pending texture destruction (deferred until GPU is done)
-static VkImage g_pendingTextureImage = VK_NULL_HANDLE;
-static VkDeviceMemory g_pendingTextureImageMemory = VK_NULL_HANDLE;
-static VkImageView g_pendingTextureImageView = VK_NULL_HANDLE;
 
 // Camera matrices for raycasting
 static glm::mat4 g_currentView = glm::mat4(1.0f);
@@ -198,25 +689,110 @@ static glm::vec3 g_currentCamPos = glm::vec3(0.0f);
 
 // Forward declarations
 static uint32_t findMemoryType(uint32_t typeFilter, VkMemoryPropertyFlags properties);
-static void createBuffer(VkDeviceSize size, VkBufferUsageFlags usage, VkMemoryPropertyFlags properties, VkBuffer& buffer, VkDeviceMemory& bufferMemory);
+static void createBuffer(VkDeviceSize size, VkBufferUsageFlags usage, VkMemoryPropertyFlags properties, VkBuffer& buffer, GpuAllocation& bufferMemory, bool persistent = false);
 static void createTextureAndDescriptors(GLFWwindow* window);
+static void createProfilerQueries();  // Defined with the profiler
+static void destroyProfilerQueries();
+
+// ============================================================================
+// UPLOAD CONTEXT
+// ============================================================================
+// Buffer and texture uploads (and their layout transitions) are recorded into one shared command
+// buffer and submitted together by flushUploads() - from heidic_end_frame() just ahead of the frame's
+// own submission, or at the end of a load phase. Staging data is written into a persistently mapped
+// arena of fixed-size blocks; a submission keeps its blocks until its fence signals, then they are
+// reused. Queue order plus the barriers recorded here make the data visible to every later
+// submission, so nothing waits on the queue.
+
+static const VkDeviceSize UPLOAD_STAGING_BLOCK_SIZE = 16 * 1024 * 1024;
+static const VkDeviceSize UPLOAD_STAGING_ALIGNMENT = 16;  // Covers buffer-image copy offset rules for RGBA8
+
+struct StagingBlock {
+    VkBuffer buffer = VK_NULL_HANDLE;
+    GpuAllocation memory;
+    char* mapped = nullptr;
+    VkDeviceSize size = 0;
+    VkDeviceSize used = 0;
+};
+
+struct UploadSubmission {
+    VkCommandBuffer cmd;
+    VkFence fence;
+    uint64_t serial;
+    std::vector<StagingBlock> blocks;
+};
+
+static VkCommandBuffer g_uploadCmd = VK_NULL_HANDLE;       // Open (recording) upload command buffer
+static std::vector<StagingBlock> g_uploadBlocks;           // Staging blocks written by the open command buffer
+static std::vector<StagingBlock> g_freeStagingBlocks;      // Standard-size blocks ready for reuse
+static std::vector<UploadSubmission> g_uploadSubmissions;  // Submitted, oldest first
+static std::vector<VkFence> g_freeUploadFences;
+static uint64_t g_uploadSerial = 0;           // Serial of the last submission (the open one is g_uploadSerial + 1)
+static uint64_t g_uploadCompletedSerial = 0;  // Every submission up to this serial has finished on the GPU
+static uint32_t g_uploadSubmitCount = 0;      // Submissions since startup (for profiling)
+static uint32_t g_uploadCopyCount = 0;        // Copies recorded since startup (for profiling)
 
-// Helper: transition image layout
-static void transitionImageLayout(VkImage image, VkFormat format, VkImageLayout oldLayout, VkImageLayout newLayout) {
+static VkCommandBuffer uploadCommandBuffer() {
+    if (g_uploadCmd != VK_NULL_HANDLE) return g_uploadCmd;
+    
     VkCommandBufferAllocateInfo allocInfo = {};
     allocInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
     allocInfo.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
     allocInfo.commandPool = g_commandPool;
     allocInfo.commandBufferCount = 1;
-
-    VkCommandBuffer cmd;
-    vkAllocateCommandBuffers(g_device, &allocInfo, &cmd);
-
+    vkAllocateCommandBuffers(g_device, &allocInfo, &g_uploadCmd);
+    
     VkCommandBufferBeginInfo beginInfo = {};
     beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
     beginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
-    vkBeginCommandBuffer(cmd, &beginInfo);
+    vkBeginCommandBuffer(g_uploadCmd, &beginInfo);
+    return g_uploadCmd;
+}
+
+// Serial the currently recorded uploads will complete with
+static uint64_t pendingUploadSerial() {
+    return g_uploadSerial + 1;
+}
+
+static bool isUploadSerialComplete(uint64_t serial) {
+    return serial <= g_uploadCompletedSerial;
+}
+
+// Copy data into the staging arena; returns the staging buffer and offset to copy from
+static bool stageUploadData(const void* data, VkDeviceSize size, VkBuffer& srcBuffer, VkDeviceSize& srcOffset) {
+    StagingBlock* block = g_uploadBlocks.empty() ? nullptr : &g_uploadBlocks.back();
+    VkDeviceSize offset = block ? (block->used + UPLOAD_STAGING_ALIGNMENT - 1) & ~(UPLOAD_STAGING_ALIGNMENT - 1) : 0;
+    if (!block || offset + size > block->size) {
+        StagingBlock fresh;
+        if (size <= UPLOAD_STAGING_BLOCK_SIZE && !g_freeStagingBlocks.empty()) {
+            fresh = g_freeStagingBlocks.back();
+            g_freeStagingBlocks.pop_back();
+        } else {
+            // Oversized uploads get a dedicated block, released when their submission completes
+            fresh.size = std::max(size, UPLOAD_STAGING_BLOCK_SIZE);
+            createBuffer(fresh.size, VK_BUFFER_USAGE_TRANSFER_SRC_BIT, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT, fresh.buffer, fresh.memory);
+            if (fresh.buffer == VK_NULL_HANDLE || fresh.memory.mapped == nullptr) {
+                std::cerr << "[EDEN] Failed to allocate upload staging block (" << fresh.size << " bytes)" << std::endl;
+                destroyBuffer(fresh.buffer, fresh.memory);
+                return false;
+            }
+            fresh.mapped = fresh.memory.mapped;
+        }
+        fresh.used = 0;
+        g_uploadBlocks.push_back(fresh);
+        block = &g_uploadBlocks.back();
+        offset = 0;
+    }
+    
+    memcpy(block->mapped + offset, data, (size_t)size);
+    block->used = offset + size;
+    srcBuffer = block->buffer;
+    srcOffset = offset;
+    return true;
+}
 
+// Record an image layout transition (of mip levels [baseMip, baseMip + levelCount)) into the upload command buffer
+static void transitionImageLayout(VkImage image, VkImageLayout oldLayout, VkImageLayout newLayout, uint32_t baseMip = 0, uint32_t levelCount = 1) {
     VkImageMemoryBarrier barrier = {};
     barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
     barrier.oldLayout = oldLayout;
@@ -225,8 +801,8 @@ static void transitionImageLayout(VkImage image, VkFormat format, VkImageLayout
     barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
     barrier.image = image;
     barrier.subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
-    barrier.subresourceRange.baseMipLevel = 0;
-    barrier.subresourceRange.levelCount = 1;
+    barrier.subresourceRange.baseMipLevel = baseMip;
+    barrier.subresourceRange.levelCount = levelCount;
     barrier.subresourceRange.baseArrayLayer = 0;
     barrier.subresourceRange.layerCount = 1;
 
@@ -238,188 +814,510 @@ static void transitionImageLayout(VkImage image, VkFormat format, VkImageLayout
         barrier.dstAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
         srcStage = VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT;
         dstStage = VK_PIPELINE_STAGE_TRANSFER_BIT;
+    } else if (oldLayout == VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL && newLayout == VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL) {
+        // Level just written becomes the source of the next blit
+        barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+        barrier.dstAccessMask = VK_ACCESS_TRANSFER_READ_BIT;
+        srcStage = VK_PIPELINE_STAGE_TRANSFER_BIT;
+        dstStage = VK_PIPELINE_STAGE_TRANSFER_BIT;
     } else if (oldLayout == VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL && newLayout == VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL) {
         barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
         barrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
         srcStage = VK_PIPELINE_STAGE_TRANSFER_BIT;
         dstStage = VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT;
+    } else if (oldLayout == VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL && newLayout == VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL) {
+        // Rewriting part of a sampled image (frames already submitted may still be reading it)
+        barrier.srcAccessMask = 0;
+        barrier.dstAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+        srcStage = VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT;
+        dstStage = VK_PIPELINE_STAGE_TRANSFER_BIT;
+    } else if (oldLayout == VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL && newLayout == VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL) {
+        barrier.srcAccessMask = VK_ACCESS_TRANSFER_READ_BIT;
+        barrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
+        srcStage = VK_PIPELINE_STAGE_TRANSFER_BIT;
+        dstStage = VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT;
     } else {
         srcStage = VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT;
         dstStage = VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT;
     }
 
     vkCmdPipelineBarrier(
-        cmd,
+        uploadCommandBuffer(),
         srcStage, dstStage,
         0,
         0, nullptr,
         0, nullptr,
         1, &barrier
     );
+}
+
+// Record a copy of data into dst (which must have TRANSFER_DST usage)
+static bool uploadToBuffer(VkBuffer dst, const void* data, VkDeviceSize size) {
+    VkBuffer src;
+    VkDeviceSize srcOffset;
+    if (!stageUploadData(data, size, src, srcOffset)) return false;
+    
+    VkBufferCopy copyRegion = {};
+    copyRegion.srcOffset = srcOffset;
+    copyRegion.dstOffset = 0;
+    copyRegion.size = size;
+    vkCmdCopyBuffer(uploadCommandBuffer(), src, dst, 1, &copyRegion);
+    g_uploadCopyCount++;
+    return true;
+}
 
-    vkEndCommandBuffer(cmd);
+// ============================================================================
+// TEXTURE MIPMAPS
+// ============================================================================
+// Cached textures get a full mip chain, generated while the upload is recorded: a vkCmdBlitImage
+// chain where RGBA8 supports linear blits on this device, otherwise a CPU 2x2 box filter whose
+// levels are staged and copied like level 0. The texture sampler uses the whole chain, so distant
+// and glancing surfaces (long corridors, floors) fetch from small levels instead of thrashing the
+// texture cache with level 0.
 
-    VkSubmitInfo submitInfo = {};
-    submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
-    submitInfo.commandBufferCount = 1;
-    submitInfo.pCommandBuffers = &cmd;
-    vkQueueSubmit(g_graphicsQueue, 1, &submitInfo, VK_NULL_HANDLE);
-    vkQueueWaitIdle(g_graphicsQueue);
+static bool g_textureMipmapsEnabled = true;  // Read at texture creation and sampler creation
+static int g_textureMipBlitSupport = -1;     // -1 = not queried yet, 0 = CPU fallback, 1 = blit chain
 
-    vkFreeCommandBuffers(g_device, g_commandPool, 1, &cmd);
+// Number of levels in a full chain down to 1x1 (1 if mipmaps are disabled)
+static uint32_t textureMipLevels(uint32_t width, uint32_t height) {
+    if (!g_textureMipmapsEnabled) return 1;
+    uint32_t levels = 1;
+    for (uint32_t size = std::max(width, height); size > 1; size >>= 1) {
+        levels++;
+    }
+    return levels;
 }
 
-static void createTextureAndDescriptors(GLFWwindow* /*window*/) {
-    if (g_textureImage != VK_NULL_HANDLE) {
-        // Already created
-        // Still need to write descriptors for UBO + sampler
+static bool canBlitTextureMips() {
+    if (g_textureMipBlitSupport < 0) {
+        VkFormatProperties props;
+        vkGetPhysicalDeviceFormatProperties(g_physicalDevice, VK_FORMAT_R8G8B8A8_UNORM, &props);
+        const VkFormatFeatureFlags needed = VK_FORMAT_FEATURE_BLIT_SRC_BIT | VK_FORMAT_FEATURE_BLIT_DST_BIT |
+                                            VK_FORMAT_FEATURE_SAMPLED_IMAGE_FILTER_LINEAR_BIT;
+        g_textureMipBlitSupport = (props.optimalTilingFeatures & needed) == needed ? 1 : 0;
+        if (!g_textureMipBlitSupport) {
+            std::cout << "[EDEN] RGBA8 linear blit unsupported - generating texture mipmaps on the CPU" << std::endl;
+        }
+    }
+    return g_textureMipBlitSupport == 1;
+}
+
+// Halve a tightly packed RGBA8 image with a 2x2 box filter (odd edges reuse the last row/column)
+static void downsampleRgba8(const unsigned char* src, uint32_t srcWidth, uint32_t srcHeight,
+                            unsigned char* dst, uint32_t dstWidth, uint32_t dstHeight) {
+    for (uint32_t y = 0; y < dstHeight; y++) {
+        uint32_t y0 = std::min(y * 2, srcHeight - 1);
+        uint32_t y1 = std::min(y * 2 + 1, srcHeight - 1);
+        for (uint32_t x = 0; x < dstWidth; x++) {
+            uint32_t x0 = std::min(x * 2, srcWidth - 1);
+            uint32_t x1 = std::min(x * 2 + 1, srcWidth - 1);
+            const unsigned char* p00 = src + ((size_t)y0 * srcWidth + x0) * 4;
+            const unsigned char* p01 = src + ((size_t)y0 * srcWidth + x1) * 4;
+            const unsigned char* p10 = src + ((size_t)y1 * srcWidth + x0) * 4;
+            const unsigned char* p11 = src + ((size_t)y1 * srcWidth + x1) * 4;
+            unsigned char* out = dst + ((size_t)y * dstWidth + x) * 4;
+            for (int c = 0; c < 4; c++) {
+                out[c] = (unsigned char)((p00[c] + p01[c] + p10[c] + p11[c] + 2) / 4);
+            }
+        }
     }
+}
 
-    // Load default.bmp from gateway_editor_v1/textures/ - try multiple paths
-    int texWidth, texHeight, texChannels;
-    stbi_uc* pixels = nullptr;
-    
-    const char* paths[] = {
-        "examples/gateway_editor_v1/textures/default.bmp",  // From heidic_v2 root
-        "../examples/gateway_editor_v1/textures/default.bmp", // From examples/gateway_editor_v1/
-        "textures/default.bmp",                              // From gateway_editor_v1/
-        "default.bmp"                                        // Fallback
-    };
+// Record a copy of one tightly packed mip level (RGBA8 pixels or compressed blocks) into an image
+// in TRANSFER_DST layout; size defaults to width * height * 4
+static bool copyToImageLevel(VkImage image, uint32_t mipLevel, uint32_t width, uint32_t height, const void* pixels, VkDeviceSize size = 0) {
+    VkBuffer src;
+    VkDeviceSize srcOffset;
+    if (size == 0) size = (VkDeviceSize)width * height * 4;
+    if (!stageUploadData(pixels, size, src, srcOffset)) return false;
     
-    bool usingFallback = false;
-    for (int i = 0; i < 4; i++) {
-        pixels = stbi_load(paths[i], &texWidth, &texHeight, &texChannels, STBI_rgb_alpha);
-        if (pixels) {
-            std::cout << "[EDEN] Loaded texture from: " << paths[i] << " (" << texWidth << "x" << texHeight << ")" << std::endl;
-            std::cout.flush();
-            break;
+    VkBufferImageCopy region = {};
+    region.bufferOffset = srcOffset;
+    region.bufferRowLength = 0;
+    region.bufferImageHeight = 0;
+    region.imageSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+    region.imageSubresource.mipLevel = mipLevel;
+    region.imageSubresource.baseArrayLayer = 0;
+    region.imageSubresource.layerCount = 1;
+    region.imageOffset = {0, 0, 0};
+    region.imageExtent = {width, height, 1};
+    vkCmdCopyBufferToImage(uploadCommandBuffer(), src, image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1, &region);
+    g_uploadCopyCount++;
+    return true;
+}
+
+// Record UNDEFINED -> TRANSFER_DST, the copy of tightly packed RGBA8 pixels, generation of the
+// remaining mip levels (see textureMipLevels) and -> SHADER_READ_ONLY for the whole chain
+static bool uploadToImage(VkImage image, uint32_t width, uint32_t height, const void* pixels) {
+    uint32_t mipLevels = textureMipLevels(width, height);
+    transitionImageLayout(image, VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 0, mipLevels);
+    bool ok = copyToImageLevel(image, 0, width, height, pixels);
+    
+    if (ok && mipLevels > 1 && canBlitTextureMips()) {
+        VkCommandBuffer cmd = uploadCommandBuffer();
+        int32_t mipWidth = (int32_t)width;
+        int32_t mipHeight = (int32_t)height;
+        for (uint32_t level = 1; level < mipLevels; level++) {
+            int32_t nextWidth = std::max(mipWidth / 2, 1);
+            int32_t nextHeight = std::max(mipHeight / 2, 1);
+            transitionImageLayout(image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, level - 1, 1);
+            
+            VkImageBlit blit = {};
+            blit.srcSubresource = {VK_IMAGE_ASPECT_COLOR_BIT, level - 1, 0, 1};
+            blit.srcOffsets[1] = {mipWidth, mipHeight, 1};
+            blit.dstSubresource = {VK_IMAGE_ASPECT_COLOR_BIT, level, 0, 1};
+            blit.dstOffsets[1] = {nextWidth, nextHeight, 1};
+            vkCmdBlitImage(cmd, image, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+                           1, &blit, VK_FILTER_LINEAR);
+            
+            transitionImageLayout(image, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, level - 1, 1);
+            mipWidth = nextWidth;
+            mipHeight = nextHeight;
+        }
+        transitionImageLayout(image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, mipLevels - 1, 1);
+        return true;
+    }
+    
+    if (ok && mipLevels > 1) {
+        // CPU fallback: filter each level from the previous one and copy it like level 0
+        std::vector<unsigned char> previous((const unsigned char*)pixels, (const unsigned char*)pixels + (size_t)width * height * 4);
+        std::vector<unsigned char> next;
+        uint32_t mipWidth = width;
+        uint32_t mipHeight = height;
+        for (uint32_t level = 1; level < mipLevels && ok; level++) {
+            uint32_t nextWidth = std::max(mipWidth / 2, 1u);
+            uint32_t nextHeight = std::max(mipHeight / 2, 1u);
+            next.resize((size_t)nextWidth * nextHeight * 4);
+            downsampleRgba8(previous.data(), mipWidth, mipHeight, next.data(), nextWidth, nextHeight);
+            ok = copyToImageLevel(image, level, nextWidth, nextHeight, next.data());
+            previous.swap(next);
+            mipWidth = nextWidth;
+            mipHeight = nextHeight;
         }
     }
     
-    // Fallback to white texture if loading failed
-    if (!pixels) {
-        std::cerr << "[EDEN] Failed to load default.bmp from all paths. Using fallback 1x1 white texture." << std::endl;
-        usingFallback = true;
-        texWidth = 1;
-        texHeight = 1;
-        texChannels = 4;
-        pixels = new stbi_uc[4];
-        pixels[0] = 255; // R
-        pixels[1] = 255; // G
-        pixels[2] = 255; // B
-        pixels[3] = 255; // A
-    }
+    transitionImageLayout(image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, 0, mipLevels);
+    return ok;
+}
 
-    VkDeviceSize imageSize = (VkDeviceSize)(texWidth) * texHeight * 4;
+// Build textures with (1) or without (0) mip chains. Call before heidic_init_renderer() - the
+// sampler and every texture are created with the setting in effect at that time.
+extern "C" void heidic_set_texture_mipmaps(int enabled) {
+    g_textureMipmapsEnabled = enabled != 0;
+}
 
-    VkBuffer stagingBuffer;
-    VkDeviceMemory stagingBufferMemory;
-    createBuffer(imageSize, VK_BUFFER_USAGE_TRANSFER_SRC_BIT, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT, stagingBuffer, stagingBufferMemory);
+extern "C" int heidic_get_texture_mipmaps() {
+    return g_textureMipmapsEnabled ? 1 : 0;
+}
 
-    void* data;
-    vkMapMemory(g_device, stagingBufferMemory, 0, imageSize, 0, &data);
-    memcpy(data, pixels, (size_t)imageSize);
-    vkUnmapMemory(g_device, stagingBufferMemory);
-
-    // Free pixels - use appropriate method based on how we loaded it
-    if (usingFallback) {
-        delete[] pixels;
+// Submit everything recorded since the last flush (no-op if nothing was recorded)
+static void flushUploads() {
+    if (g_uploadCmd == VK_NULL_HANDLE) return;
+    
+    // Buffer copies -> vertex/index fetch and shader reads of later submissions
+    VkMemoryBarrier memoryBarrier = {};
+    memoryBarrier.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+    memoryBarrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+    memoryBarrier.dstAccessMask = VK_ACCESS_VERTEX_ATTRIBUTE_READ_BIT | VK_ACCESS_INDEX_READ_BIT | VK_ACCESS_SHADER_READ_BIT;
+    vkCmdPipelineBarrier(g_uploadCmd, VK_PIPELINE_STAGE_TRANSFER_BIT,
+                         VK_PIPELINE_STAGE_VERTEX_INPUT_BIT | VK_PIPELINE_STAGE_VERTEX_SHADER_BIT | VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT,
+                         0, 1, &memoryBarrier, 0, nullptr, 0, nullptr);
+    vkEndCommandBuffer(g_uploadCmd);
+    
+    UploadSubmission submission;
+    submission.cmd = g_uploadCmd;
+    submission.serial = ++g_uploadSerial;
+    submission.blocks.swap(g_uploadBlocks);
+    if (!g_freeUploadFences.empty()) {
+        submission.fence = g_freeUploadFences.back();
+        g_freeUploadFences.pop_back();
     } else {
-        stbi_image_free(pixels);
+        VkFenceCreateInfo fenceInfo = {};
+        fenceInfo.sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO;
+        vkCreateFence(g_device, &fenceInfo, nullptr, &submission.fence);
+    }
+    
+    VkSubmitInfo submitInfo = {};
+    submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+    submitInfo.commandBufferCount = 1;
+    submitInfo.pCommandBuffers = &submission.cmd;
+    vkQueueSubmit(g_graphicsQueue, 1, &submitInfo, submission.fence);
+    g_uploadSubmitCount++;
+    
+    g_uploadSubmissions.push_back(std::move(submission));
+    g_uploadCmd = VK_NULL_HANDLE;
+}
+
+// Recycle submissions whose fence has signalled (oldest first, so completion stays in serial order)
+static void collectUploads(bool wait = false) {
+    size_t done = 0;
+    for (; done < g_uploadSubmissions.size(); done++) {
+        UploadSubmission& submission = g_uploadSubmissions[done];
+        if (wait) {
+            vkWaitForFences(g_device, 1, &submission.fence, VK_TRUE, UINT64_MAX);
+        } else if (vkGetFenceStatus(g_device, submission.fence) != VK_SUCCESS) {
+            break;
+        }
+        vkResetFences(g_device, 1, &submission.fence);
+        g_freeUploadFences.push_back(submission.fence);
+        vkFreeCommandBuffers(g_device, g_commandPool, 1, &submission.cmd);
+        for (StagingBlock& block : submission.blocks) {
+            if (block.size == UPLOAD_STAGING_BLOCK_SIZE) {
+                g_freeStagingBlocks.push_back(block);
+            } else {
+                destroyBuffer(block.buffer, block.memory);
+            }
+        }
+        g_uploadCompletedSerial = submission.serial;
     }
+    g_uploadSubmissions.erase(g_uploadSubmissions.begin(), g_uploadSubmissions.begin() + done);
+}
+
+// Submit pending uploads and block until all of them have completed (shutdown, tools)
+static void finishUploads() {
+    flushUploads();
+    collectUploads(true);
+}
+
+// Submit uploads recorded so far, e.g. at the end of a level load (heidic_end_frame() also flushes)
+extern "C" void heidic_flush_uploads() {
+    flushUploads();
+}
 
+extern "C" int heidic_get_upload_submit_count() {
+    return static_cast<int>(g_uploadSubmitCount);
+}
+
+extern "C" int heidic_get_upload_copy_count() {
+    return static_cast<int>(g_uploadCopyCount);
+}
+
+// Create a device-local sampled image with room for its mip chain (TRANSFER_SRC/DST for uploads and blits).
+// mipLevels = 0 sizes the chain for uploadToImage() (see textureMipLevels).
+static bool createTextureImage(uint32_t width, uint32_t height, VkImage& image, GpuAllocation& memory,
+                               VkFormat format = VK_FORMAT_R8G8B8A8_UNORM, uint32_t mipLevels = 0) {
     VkImageCreateInfo imageInfo = {};
     imageInfo.sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
     imageInfo.imageType = VK_IMAGE_TYPE_2D;
-    imageInfo.extent.width = texWidth;
-    imageInfo.extent.height = texHeight;
+    imageInfo.extent.width = width;
+    imageInfo.extent.height = height;
     imageInfo.extent.depth = 1;
-    imageInfo.mipLevels = 1;
+    imageInfo.mipLevels = mipLevels ? mipLevels : textureMipLevels(width, height);
     imageInfo.arrayLayers = 1;
-    imageInfo.format = VK_FORMAT_R8G8B8A8_UNORM;
+    imageInfo.format = format;
     imageInfo.tiling = VK_IMAGE_TILING_OPTIMAL;
     imageInfo.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
-    imageInfo.usage = VK_IMAGE_USAGE_TRANSFER_DST_BIT | VK_IMAGE_USAGE_SAMPLED_BIT;
+    imageInfo.usage = VK_IMAGE_USAGE_TRANSFER_SRC_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT | VK_IMAGE_USAGE_SAMPLED_BIT;
     imageInfo.samples = VK_SAMPLE_COUNT_1_BIT;
     imageInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+    if (vkCreateImage(g_device, &imageInfo, nullptr, &image) != VK_SUCCESS) {
+        std::cerr << "[EDEN] Failed to create texture image (" << width << "x" << height << ")" << std::endl;
+        return false;
+    }
+    
+    if (!allocateImageMemory(image, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, GPU_RESOURCE_TEXTURE, memory)) {
+        std::cerr << "[EDEN] Failed to allocate texture memory (" << width << "x" << height << ")" << std::endl;
+        vkDestroyImage(g_device, image, nullptr);
+        image = VK_NULL_HANDLE;
+        return false;
+    }
+    return true;
+}
 
-    vkCreateImage(g_device, &imageInfo, nullptr, &g_textureImage);
-
-    VkMemoryRequirements memRequirements;
-    vkGetImageMemoryRequirements(g_device, g_textureImage, &memRequirements);
-
-    VkMemoryAllocateInfo allocInfo = {};
-    allocInfo.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
-    allocInfo.allocationSize = memRequirements.size;
-    allocInfo.memoryTypeIndex = findMemoryType(memRequirements.memoryTypeBits, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
-
-    vkAllocateMemory(g_device, &allocInfo, nullptr, &g_textureImageMemory);
-    vkBindImageMemory(g_device, g_textureImage, g_textureImageMemory, 0);
-
-    // Transition, copy, transition
-    transitionImageLayout(g_textureImage, imageInfo.format, VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL);
-
-    VkCommandBufferAllocateInfo cbAlloc = {};
-    cbAlloc.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
-    cbAlloc.commandPool = g_commandPool;
-    cbAlloc.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
-    cbAlloc.commandBufferCount = 1;
-
-    VkCommandBuffer cmd;
-    vkAllocateCommandBuffers(g_device, &cbAlloc, &cmd);
-
-    VkCommandBufferBeginInfo beginInfo = {};
-    beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
-    beginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
-    vkBeginCommandBuffer(cmd, &beginInfo);
-
-    VkBufferImageCopy region = {};
-    region.bufferOffset = 0;
-    region.imageSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
-    region.imageSubresource.mipLevel = 0;
-    region.imageSubresource.baseArrayLayer = 0;
-    region.imageSubresource.layerCount = 1;
-    region.imageOffset = {0, 0, 0};
-    region.imageExtent = { (uint32_t)texWidth, (uint32_t)texHeight, 1 };
-
-    vkCmdCopyBufferToImage(
-        cmd,
-        stagingBuffer,
-        g_textureImage,
-        VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
-        1,
-        &region
-    );
-
-    vkEndCommandBuffer(cmd);
-
-    VkSubmitInfo submitInfo = {};
-    submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
-    submitInfo.commandBufferCount = 1;
-    submitInfo.pCommandBuffers = &cmd;
-    vkQueueSubmit(g_graphicsQueue, 1, &submitInfo, VK_NULL_HANDLE);
-    vkQueueWaitIdle(g_graphicsQueue);
-
-    vkFreeCommandBuffers(g_device, g_commandPool, 1, &cmd);
-
-    transitionImageLayout(g_textureImage, imageInfo.format, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
-
-    vkDestroyBuffer(g_device, stagingBuffer, nullptr);
-    vkFreeMemory(g_device, stagingBufferMemory, nullptr);
-
-    // Create image view
+static VkImageView createTextureView(VkImage image, VkFormat format = VK_FORMAT_R8G8B8A8_UNORM) {
     VkImageViewCreateInfo viewInfo = {};
     viewInfo.sType = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
-    viewInfo.image = g_textureImage;
+    viewInfo.image = image;
     viewInfo.viewType = VK_IMAGE_VIEW_TYPE_2D;
-    viewInfo.format = imageInfo.format;
+    viewInfo.format = format;
     viewInfo.subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
     viewInfo.subresourceRange.baseMipLevel = 0;
-    viewInfo.subresourceRange.levelCount = 1;
+    viewInfo.subresourceRange.levelCount = VK_REMAINING_MIP_LEVELS;  // Whole mip chain
     viewInfo.subresourceRange.baseArrayLayer = 0;
     viewInfo.subresourceRange.layerCount = 1;
+    
+    VkImageView view = VK_NULL_HANDLE;
+    vkCreateImageView(g_device, &viewInfo, nullptr, &view);
+    return view;
+}
+
+// Give a texture a slot in the bindless table and write its descriptor (once).
+// Returns 0 (the default texture's slot) if bindless is unavailable or the table is full.
+static uint32_t registerTextureSlot(VkImageView view) {
+    if (!g_bindlessSupported || g_bindlessDescriptorSet == VK_NULL_HANDLE || view == VK_NULL_HANDLE) {
+        return 0;
+    }
+    uint32_t slot;
+    if (!g_freeTextureSlots.empty()) {
+        slot = g_freeTextureSlots.back();
+        g_freeTextureSlots.pop_back();
+    } else if (g_nextTextureSlot < g_bindlessTextureCapacity) {
+        slot = g_nextTextureSlot++;
+    } else {
+        std::cerr << "[EDEN] Bindless texture table full (" << g_bindlessTextureCapacity << " slots), using default texture" << std::endl;
+        return 0;
+    }
+    
+    VkDescriptorImageInfo imageInfo = {};
+    imageInfo.imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+    imageInfo.imageView = view;
+    imageInfo.sampler = g_textureSampler;
+    
+    // Safe while the set is bound in frames still in flight: the binding is UPDATE_AFTER_BIND
+    VkWriteDescriptorSet write = {};
+    write.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+    write.dstSet = g_bindlessDescriptorSet;
+    write.dstBinding = 0;
+    write.dstArrayElement = slot;
+    write.descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+    write.descriptorCount = 1;
+    write.pImageInfo = &imageInfo;
+    vkUpdateDescriptorSets(g_device, 1, &write, 0, nullptr);
+    return slot;
+}
+
+// Return a slot to the free list (the caller must ensure no frame in flight still samples it)
+static void releaseTextureSlot(uint32_t slot) {
+    if (g_bindlessSupported && slot != 0) {
+        g_freeTextureSlots.push_back(slot);
+    }
+}
+
+// Fallback path: per-frame descriptor set (UBO + this texture) for a cached texture, written on first use
+static VkDescriptorSet getTextureDescriptorSet(TextureResource& tex) {
+    if (!tex.resident) {
+        return g_descriptorSets[g_currentFrame];  // Still streaming - draw with the default texture
+    }
+    if (g_currentFrame < tex.descriptorSets.size()) {
+        return tex.descriptorSets[g_currentFrame];
+    }
+    
+    std::vector<VkDescriptorSetLayout> layouts(g_maxFramesInFlight, g_descriptorSetLayout);
+    std::vector<VkDescriptorSet> sets(g_maxFramesInFlight, VK_NULL_HANDLE);
+    VkDescriptorSetAllocateInfo allocInfo = {};
+    allocInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+    allocInfo.descriptorSetCount = g_maxFramesInFlight;
+    allocInfo.pSetLayouts = layouts.data();
+    
+    VkResult result = VK_ERROR_OUT_OF_POOL_MEMORY;
+    if (!g_textureDescriptorPools.empty()) {
+        allocInfo.descriptorPool = g_textureDescriptorPools.back();
+        result = vkAllocateDescriptorSets(g_device, &allocInfo, sets.data());
+    }
+    if (result != VK_SUCCESS) {
+        // Current pool exhausted (or none yet) - add another one
+        uint32_t poolSets = TEXTURE_SETS_PER_POOL * g_maxFramesInFlight;
+        VkDescriptorPoolSize poolSizes[2] = {};
+        poolSizes[0].type = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
+        poolSizes[0].descriptorCount = poolSets;
+        poolSizes[1].type = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+        poolSizes[1].descriptorCount = poolSets;
+        
+        VkDescriptorPoolCreateInfo poolInfo = {};
+        poolInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+        poolInfo.flags = VK_DESCRIPTOR_POOL_CREATE_FREE_DESCRIPTOR_SET_BIT;
+        poolInfo.poolSizeCount = 2;
+        poolInfo.pPoolSizes = poolSizes;
+        poolInfo.maxSets = poolSets;
+        VkDescriptorPool pool;
+        if (vkCreateDescriptorPool(g_device, &poolInfo, nullptr, &pool) != VK_SUCCESS) {
+            std::cerr << "[EDEN] Failed to create texture descriptor pool" << std::endl;
+            return g_descriptorSets[g_currentFrame];
+        }
+        g_textureDescriptorPools.push_back(pool);
+        allocInfo.descriptorPool = pool;
+        if (vkAllocateDescriptorSets(g_device, &allocInfo, sets.data()) != VK_SUCCESS) {
+            std::cerr << "[EDEN] Failed to allocate texture descriptor sets" << std::endl;
+            return g_descriptorSets[g_currentFrame];
+        }
+    }
+    
+    for (uint32_t i = 0; i < g_maxFramesInFlight; i++) {
+        VkDescriptorBufferInfo bufferInfo = {};
+        bufferInfo.buffer = g_uniformBuffers[i];
+        bufferInfo.offset = 0;
+        bufferInfo.range = sizeof(UniformBufferObject);
+        
+        VkDescriptorImageInfo imageInfo = {};
+        imageInfo.imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+        imageInfo.imageView = tex.view;
+        imageInfo.sampler = g_textureSampler;
+        
+        VkWriteDescriptorSet writes[2] = {};
+        writes[0].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+        writes[0].dstSet = sets[i];
+        writes[0].dstBinding = 0;
+        writes[0].descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
+        writes[0].descriptorCount = 1;
+        writes[0].pBufferInfo = &bufferInfo;
+        
+        writes[1].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+        writes[1].dstSet = sets[i];
+        writes[1].dstBinding = 1;
+        writes[1].descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+        writes[1].descriptorCount = 1;
+        writes[1].pImageInfo = &imageInfo;
+        
+        vkUpdateDescriptorSets(g_device, 2, writes, 0, nullptr);
+    }
+    tex.descriptorSets = sets;
+    tex.descriptorPool = allocInfo.descriptorPool;
+    return tex.descriptorSets[g_currentFrame];
+}
+
+static void createTextureAndDescriptors(GLFWwindow* /*window*/) {
+    if (g_textureImage != VK_NULL_HANDLE) {
+        // Already created
+        // Still need to write descriptors for UBO + sampler
+    }
+
+    // Load default.bmp from gateway_editor_v1/textures/ - try multiple paths
+    int texWidth, texHeight, texChannels;
+    stbi_uc* pixels = nullptr;
+    
+    const char* paths[] = {
+        "examples/gateway_editor_v1/textures/default.bmp",  // From heidic_v2 root
+        "../examples/gateway_editor_v1/textures/default.bmp", // From examples/gateway_editor_v1/
+        "textures/default.bmp",                              // From gateway_editor_v1/
+        "default.bmp"                                        // Fallback
+    };
+    
+    bool usingFallback = false;
+    for (int i = 0; i < 4; i++) {
+        pixels = stbi_load(paths[i], &texWidth, &texHeight, &texChannels, STBI_rgb_alpha);
+        if (pixels) {
+            std::cout << "[EDEN] Loaded texture from: " << paths[i] << " (" << texWidth << "x" << texHeight << ")" << std::endl;
+            std::cout.flush();
+            break;
+        }
+    }
+    
+    // Fallback to white texture if loading failed
+    if (!pixels) {
+        std::cerr << "[EDEN] Failed to load default.bmp from all paths. Using fallback 1x1 white texture." << std::endl;
+        usingFallback = true;
+        texWidth = 1;
+        texHeight = 1;
+        texChannels = 4;
+        pixels = new stbi_uc[4];
+        pixels[0] = 255; // R
+        pixels[1] = 255; // G
+        pixels[2] = 255; // B
+        pixels[3] = 255; // A
+    }
 
-    vkCreateImageView(g_device, &viewInfo, nullptr, &g_textureImageView);
+    // Recorded into the upload context; submitted with the first flush, ahead of the first frame
+    if (createTextureImage((uint32_t)texWidth, (uint32_t)texHeight, g_textureImage, g_textureImageMemory)) {
+        uploadToImage(g_textureImage, (uint32_t)texWidth, (uint32_t)texHeight, pixels);
+        g_textureImageView = createTextureView(g_textureImage);
+    }
+
+    // Free pixels - use appropriate method based on how we loaded it
+    if (usingFallback) {
+        delete[] pixels;
+    } else {
+        stbi_image_free(pixels);
+    }
 
     // Create sampler
     VkSamplerCreateInfo samplerInfo = {};
@@ -435,11 +1333,16 @@ static void createTextureAndDescriptors(GLFWwindow* /*window*/) {
     samplerInfo.unnormalizedCoordinates = VK_FALSE;
     samplerInfo.compareEnable = VK_FALSE;
     samplerInfo.mipmapMode = VK_SAMPLER_MIPMAP_MODE_LINEAR;
+    samplerInfo.minLod = 0.0f;
+    samplerInfo.maxLod = g_textureMipmapsEnabled ? VK_LOD_CLAMP_NONE : 0.0f;  // Trilinear over the full chain
 
     vkCreateSampler(g_device, &samplerInfo, nullptr, &g_textureSampler);
 
+    // The default texture is always slot 0 of the bindless table
+    g_currentTextureSlot = registerTextureSlot(g_textureImageView);
+
     // Write descriptors: UBO + texture sampler
-    for (size_t i = 0; i < g_swapchainImageCount; i++) {
+    for (size_t i = 0; i < g_maxFramesInFlight; i++) {
         VkDescriptorBufferInfo bufferInfo = {};
         bufferInfo.buffer = g_uniformBuffers[i];
         bufferInfo.offset = 0;
@@ -471,30 +1374,45 @@ static void createTextureAndDescriptors(GLFWwindow* /*window*/) {
 
 // Cube resources
 static VkBuffer g_cubeVertexBuffer = VK_NULL_HANDLE;
-static VkDeviceMemory g_cubeVertexMemory = VK_NULL_HANDLE;
+static GpuAllocation g_cubeVertexMemory;
 static uint32_t g_cubeVertexCount = 0;
 
 // Static grey cube buffer for ground plane
 static VkBuffer g_greyCubeVertexBuffer = VK_NULL_HANDLE;
-static VkDeviceMemory g_greyCubeVertexMemory = VK_NULL_HANDLE;
+static GpuAllocation g_greyCubeVertexMemory;
 static uint32_t g_greyCubeVertexCount = 0;
 
 // Static blue cube buffer for created cubes
 static VkBuffer g_blueCubeVertexBuffer = VK_NULL_HANDLE;
-static VkDeviceMemory g_blueCubeVertexMemory = VK_NULL_HANDLE;
+static GpuAllocation g_blueCubeVertexMemory;
 static uint32_t g_blueCubeVertexCount = 0;
 
 // Line resources
 static std::vector<Vertex> g_lineVertices;
-static VkBuffer g_lineVertexBuffer = VK_NULL_HANDLE;
-static VkDeviceMemory g_lineVertexMemory = VK_NULL_HANDLE;
 
 // Colored cube batching system (similar to lines)
-static std::vector<Vertex> g_coloredCubeVertices;
+static std::vector<Vertex> g_coloredCubeVertices;  // CPU-transformed fallback (no instanced pipeline)
+static std::vector<CubeInstance> g_coloredCubeInstances;  // Instanced path: 52 bytes per cube instead of 36 vertices
 static std::vector<glm::mat4> g_coloredCubeTransforms;
-static VkBuffer g_coloredCubeVertexBuffer = VK_NULL_HANDLE;
-static VkDeviceMemory g_coloredCubeVertexMemory = VK_NULL_HANDLE;
-static VkDeviceSize g_lineBufferSize = 1024 * 1024; // 1MB buffer for lines
+
+// Transient Vertex Ring
+// One persistently mapped, host-visible vertex buffer per frame in flight. All per-frame geometry
+// (colored cube batches, lines) is bump-allocated from the current frame's buffer; the head is
+// reset once the frame's fence has signalled. When a frame outgrows its buffer a larger one is
+// created and the old one is retired until the slot comes around again (earlier draws this frame
+// still reference it), so there are no fixed batch slots and no silent overwrites.
+struct TransientVertexRing {
+    VkBuffer buffer = VK_NULL_HANDLE;
+    GpuAllocation memory;
+    uint8_t* mapped = nullptr;
+    VkDeviceSize capacity = 0;
+    VkDeviceSize head = 0;
+    std::vector<std::pair<VkBuffer, GpuAllocation>> retired;  // Destroyed when this slot is reused
+    std::vector<uint8_t> hostStorage;  // Null backend: stands in for the mapped buffer
+};
+static std::vector<TransientVertexRing> g_transientRings;  // Per frame in flight
+static const VkDeviceSize TRANSIENT_RING_INITIAL_SIZE = 4 * 1024 * 1024;  // Grows on demand
+static const VkDeviceSize TRANSIENT_RING_ALIGNMENT = 256;
 
 // Helper to read binary file (for shaders)
 static std::vector<char> readFile(const std::string& filename) {
@@ -506,7 +1424,8 @@ static std::vector<char> readFile(const std::string& filename) {
         "examples/top_down/" + filename,
         "examples/ascii_import_test/" + filename,
         "shaders/" + filename,
-        "../shaders/" + filename
+        "../shaders/" + filename,
+        "../../shaders/" + filename
     };
     
     for (const auto& path : paths) {
@@ -523,6 +1442,107 @@ static std::vector<char> readFile(const std::string& filename) {
     return {};
 }
 
+// Pipeline Cache
+// One VkPipelineCache shared by every pipeline the runtime creates (including ImGui's). It is
+// seeded from disk at startup and written back at shutdown, or right after a cold start so a
+// crash doesn't lose it. The file starts with our own header so data from another GPU or driver
+// version is discarded instead of being handed to the driver.
+static VkPipelineCache g_pipelineCache = VK_NULL_HANDLE;
+static bool g_pipelineCacheWarm = false;  // Valid data was loaded from disk
+static const char* PIPELINE_CACHE_FILE = "eden_pipeline_cache.bin";
+static const uint32_t PIPELINE_CACHE_MAGIC = 0x43504445;  // "EDPC"
+static const uint32_t PIPELINE_CACHE_FORMAT_VERSION = 1;
+static double g_rendererInitMs = 0.0;
+
+struct PipelineCacheFileHeader {
+    uint32_t magic;
+    uint32_t formatVersion;
+    uint32_t vendorID;
+    uint32_t deviceID;
+    uint32_t driverVersion;
+    uint8_t pipelineCacheUUID[VK_UUID_SIZE];
+    uint32_t reserved;  // Explicit padding so the header can be compared with memcmp
+    uint64_t dataSize;
+};
+
+static PipelineCacheFileHeader makePipelineCacheHeader(uint64_t dataSize) {
+    VkPhysicalDeviceProperties props;
+    vkGetPhysicalDeviceProperties(g_physicalDevice, &props);
+    PipelineCacheFileHeader header = {};
+    header.magic = PIPELINE_CACHE_MAGIC;
+    header.formatVersion = PIPELINE_CACHE_FORMAT_VERSION;
+    header.vendorID = props.vendorID;
+    header.deviceID = props.deviceID;
+    header.driverVersion = props.driverVersion;
+    memcpy(header.pipelineCacheUUID, props.pipelineCacheUUID, VK_UUID_SIZE);
+    header.dataSize = dataSize;
+    return header;
+}
+
+// Create g_pipelineCache, seeded with the on-disk data when it matches this device and driver
+static void createPipelineCache() {
+    std::vector<char> initialData;
+    std::ifstream file(PIPELINE_CACHE_FILE, std::ios::binary | std::ios::ate);
+    if (file.is_open()) {
+        size_t fileSize = (size_t)file.tellg();
+        file.seekg(0);
+        PipelineCacheFileHeader stored = {};
+        PipelineCacheFileHeader expected = makePipelineCacheHeader(0);
+        if (fileSize >= sizeof(stored) && file.read(reinterpret_cast<char*>(&stored), sizeof(stored))) {
+            expected.dataSize = stored.dataSize;
+            if (memcmp(&stored, &expected, sizeof(stored)) == 0 && stored.dataSize == fileSize - sizeof(stored)) {
+                initialData.resize((size_t)stored.dataSize);
+                if (!file.read(initialData.data(), initialData.size())) initialData.clear();
+            } else {
+                std::cout << "[EDEN] Pipeline cache is from another device or driver, rebuilding" << std::endl;
+            }
+        }
+    }
+    
+    VkPipelineCacheCreateInfo cacheInfo = {};
+    cacheInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO;
+    cacheInfo.initialDataSize = initialData.size();
+    cacheInfo.pInitialData = initialData.empty() ? nullptr : initialData.data();
+    if (vkCreatePipelineCache(g_device, &cacheInfo, nullptr, &g_pipelineCache) != VK_SUCCESS) {
+        // The driver rejected the data - start empty
+        cacheInfo.initialDataSize = 0;
+        cacheInfo.pInitialData = nullptr;
+        initialData.clear();
+        if (vkCreatePipelineCache(g_device, &cacheInfo, nullptr, &g_pipelineCache) != VK_SUCCESS) {
+            g_pipelineCache = VK_NULL_HANDLE;
+        }
+    }
+    g_pipelineCacheWarm = !initialData.empty();
+}
+
+// Write g_pipelineCache to disk (through a temporary file so a partial write never replaces good data)
+static void savePipelineCache() {
+    if (g_pipelineCache == VK_NULL_HANDLE) return;
+    size_t dataSize = 0;
+    if (vkGetPipelineCacheData(g_device, g_pipelineCache, &dataSize, nullptr) != VK_SUCCESS || dataSize == 0) return;
+    std::vector<char> data(dataSize);
+    if (vkGetPipelineCacheData(g_device, g_pipelineCache, &dataSize, data.data()) != VK_SUCCESS) return;
+    
+    PipelineCacheFileHeader header = makePipelineCacheHeader(dataSize);
+    std::string tempPath = std::string(PIPELINE_CACHE_FILE) + ".tmp";
+    {
+        std::ofstream out(tempPath, std::ios::binary | std::ios::trunc);
+        if (!out.is_open()) return;
+        out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        out.write(data.data(), dataSize);
+        if (!out) return;
+    }
+    std::error_code ec;
+    std::filesystem::rename(tempPath, PIPELINE_CACHE_FILE, ec);
+    if (ec) {
+        std::cerr << "[EDEN] Failed to save pipeline cache: " << ec.message() << std::endl;
+    }
+}
+
+extern "C" double heidic_get_renderer_init_ms() {
+    return g_rendererInitMs;
+}
+
 // Memory Helper
 static uint32_t findMemoryType(uint32_t typeFilter, VkMemoryPropertyFlags properties) {
     VkPhysicalDeviceMemoryProperties memProperties;
@@ -536,7 +1556,9 @@ static uint32_t findMemoryType(uint32_t typeFilter, VkMemoryPropertyFlags proper
     return 0;
 }
 
-static void createBuffer(VkDeviceSize size, VkBufferUsageFlags usage, VkMemoryPropertyFlags properties, VkBuffer& buffer, VkDeviceMemory& bufferMemory) {
+// Create a buffer in sub-allocated memory (persistent = lives until shutdown, linear pool).
+// On failure buffer is VK_NULL_HANDLE.
+static void createBuffer(VkDeviceSize size, VkBufferUsageFlags usage, VkMemoryPropertyFlags properties, VkBuffer& buffer, GpuAllocation& bufferMemory, bool persistent) {
     VkBufferCreateInfo bufferInfo = {};
     bufferInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
     bufferInfo.size = size;
@@ -545,21 +1567,99 @@ static void createBuffer(VkDeviceSize size, VkBufferUsageFlags usage, VkMemoryPr
     
     if (vkCreateBuffer(g_device, &bufferInfo, nullptr, &buffer) != VK_SUCCESS) {
         std::cerr << "failed to create buffer!" << std::endl;
+        buffer = VK_NULL_HANDLE;
+        return;
     }
     
-    VkMemoryRequirements memRequirements;
-    vkGetBufferMemoryRequirements(g_device, buffer, &memRequirements);
-    
-    VkMemoryAllocateInfo allocInfo = {};
-    allocInfo.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
-    allocInfo.allocationSize = memRequirements.size;
-    allocInfo.memoryTypeIndex = findMemoryType(memRequirements.memoryTypeBits, properties);
-    
-    if (vkAllocateMemory(g_device, &allocInfo, nullptr, &bufferMemory) != VK_SUCCESS) {
+    if (!allocateBufferMemory(buffer, properties, bufferMemory, persistent)) {
         std::cerr << "failed to allocate buffer memory!" << std::endl;
+        vkDestroyBuffer(g_device, buffer, nullptr);
+        buffer = VK_NULL_HANDLE;
+    }
+}
+
+// Create a device-local buffer (usage | TRANSFER_DST) and record its fill into the upload context
+static bool createDeviceLocalBuffer(const void* data, VkDeviceSize size, VkBufferUsageFlags usage, VkBuffer& buffer, GpuAllocation& memory, bool persistent = false) {
+    if (g_nullRenderer) {
+        buffer = nullRendererHandle<VkBuffer>();  // Nothing to upload to; callers stay on their normal path
+        return true;
+    }
+    createBuffer(size, VK_BUFFER_USAGE_TRANSFER_DST_BIT | usage, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, buffer, memory, persistent);
+    if (buffer == VK_NULL_HANDLE) return false;
+    return uploadToBuffer(buffer, data, size);
+}
+
+// Create (or replace) the backing buffer of a transient ring and map it for the lifetime of the buffer
+static bool createTransientRingBuffer(TransientVertexRing& ring, VkDeviceSize size) {
+    if (g_nullRenderer) {
+        // Same copies as a mapped buffer, into host memory
+        ring.hostStorage.assign(static_cast<size_t>(size), 0);
+        ring.buffer = nullRendererHandle<VkBuffer>();
+        ring.mapped = ring.hostStorage.data();
+        ring.capacity = size;
+        ring.head = 0;
+        return true;
+    }
+    VkBuffer buffer = VK_NULL_HANDLE;
+    GpuAllocation memory;
+    createBuffer(size, VK_BUFFER_USAGE_VERTEX_BUFFER_BIT, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT, buffer, memory);
+    if (buffer == VK_NULL_HANDLE) {
+        std::cerr << "[EDEN] Failed to create transient vertex buffer (" << size << " bytes)" << std::endl;
+        return false;
+    }
+    if (memory.mapped == nullptr) {
+        std::cerr << "[EDEN] Failed to map transient vertex buffer" << std::endl;
+        destroyBuffer(buffer, memory);
+        return false;
+    }
+    if (ring.buffer != VK_NULL_HANDLE) {
+        ring.retired.push_back({ring.buffer, ring.memory});
+    }
+    ring.buffer = buffer;
+    ring.memory = memory;
+    ring.mapped = reinterpret_cast<uint8_t*>(memory.mapped);
+    ring.capacity = size;
+    ring.head = 0;
+    return true;
+}
+
+// Called after the frame's fence has been waited on: nothing from this slot is in use any more
+static void resetTransientRing(TransientVertexRing& ring) {
+    for (auto& old : ring.retired) {
+        destroyBuffer(old.first, old.second);
     }
-    
-    vkBindBufferMemory(g_device, buffer, bufferMemory, 0);
+    ring.retired.clear();
+    ring.head = 0;
+}
+
+// Copy vertex/instance data into the current frame's transient ring. Returns the buffer/offset
+// to bind, or false if the allocation could not be satisfied.
+static bool uploadTransientData(const void* src, VkDeviceSize size, VkBuffer& outBuffer, VkDeviceSize& outOffset) {
+    if (g_currentFrame >= g_transientRings.size() || size == 0) {
+        return false;
+    }
+    TransientVertexRing& ring = g_transientRings[g_currentFrame];
+    VkDeviceSize offset = (ring.head + TRANSIENT_RING_ALIGNMENT - 1) & ~(TRANSIENT_RING_ALIGNMENT - 1);
+    if (ring.buffer == VK_NULL_HANDLE || offset + size > ring.capacity) {
+        // Double so the rest of this frame (and later frames) fit without growing again
+        VkDeviceSize newCapacity = ring.capacity > 0 ? ring.capacity * 2 : TRANSIENT_RING_INITIAL_SIZE;
+        while (newCapacity < size) {
+            newCapacity *= 2;
+        }
+        if (!createTransientRingBuffer(ring, newCapacity)) {
+            return false;
+        }
+        offset = 0;
+    }
+    memcpy(ring.mapped + offset, src, static_cast<size_t>(size));
+    ring.head = offset + size;
+    outBuffer = ring.buffer;
+    outOffset = offset;
+    return true;
+}
+
+static bool uploadTransientVertices(const Vertex* vertices, size_t count, VkBuffer& outBuffer, VkDeviceSize& outOffset) {
+    return uploadTransientData(vertices, sizeof(Vertex) * count, outBuffer, outOffset);
 }
 
 // Create Cube Vertex Buffer
@@ -618,52 +1718,7 @@ static void createCube() {
     g_cubeVertexCount = static_cast<uint32_t>(vertices.size());
     VkDeviceSize bufferSize = sizeof(vertices[0]) * vertices.size();
     
-    VkBuffer stagingBuffer;
-    VkDeviceMemory stagingBufferMemory;
-    createBuffer(bufferSize, VK_BUFFER_USAGE_TRANSFER_SRC_BIT, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT, stagingBuffer, stagingBufferMemory);
-    
-    void* data;
-    vkMapMemory(g_device, stagingBufferMemory, 0, bufferSize, 0, &data);
-    memcpy(data, vertices.data(), (size_t)bufferSize);
-    vkUnmapMemory(g_device, stagingBufferMemory);
-    
-    createBuffer(bufferSize, VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_VERTEX_BUFFER_BIT, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, g_cubeVertexBuffer, g_cubeVertexMemory);
-    
-    VkCommandBufferAllocateInfo allocInfo = {};
-    allocInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
-    allocInfo.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
-    allocInfo.commandPool = g_commandPool;
-    allocInfo.commandBufferCount = 1;
-    
-    VkCommandBuffer commandBuffer;
-    vkAllocateCommandBuffers(g_device, &allocInfo, &commandBuffer);
-    
-    VkCommandBufferBeginInfo beginInfo = {};
-    beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
-    beginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
-    
-    vkBeginCommandBuffer(commandBuffer, &beginInfo);
-    
-    VkBufferCopy copyRegion = {};
-    copyRegion.srcOffset = 0;
-    copyRegion.dstOffset = 0;
-    copyRegion.size = bufferSize;
-    vkCmdCopyBuffer(commandBuffer, stagingBuffer, g_cubeVertexBuffer, 1, &copyRegion);
-    
-    vkEndCommandBuffer(commandBuffer);
-    
-    VkSubmitInfo submitInfo = {};
-    submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
-    submitInfo.commandBufferCount = 1;
-    submitInfo.pCommandBuffers = &commandBuffer;
-    
-    vkQueueSubmit(g_graphicsQueue, 1, &submitInfo, VK_NULL_HANDLE);
-    vkQueueWaitIdle(g_graphicsQueue);
-    
-    vkFreeCommandBuffers(g_device, g_commandPool, 1, &commandBuffer);
-    
-    vkDestroyBuffer(g_device, stagingBuffer, nullptr);
-    vkFreeMemory(g_device, stagingBufferMemory, nullptr);
+    createDeviceLocalBuffer(vertices.data(), bufferSize, VK_BUFFER_USAGE_VERTEX_BUFFER_BIT, g_cubeVertexBuffer, g_cubeVertexMemory, true);
 }
 
 // Internal Helper for Depth
@@ -680,7 +1735,7 @@ static VkFormat findSupportedFormat(const std::vector<VkFormat>& candidates, VkI
     throw std::runtime_error("failed to find supported format!");
 }
 
-static void createImage(uint32_t width, uint32_t height, VkFormat format, VkImageTiling tiling, VkImageUsageFlags usage, VkMemoryPropertyFlags properties, VkImage& image, VkDeviceMemory& imageMemory) {
+static void createImage(uint32_t width, uint32_t height, VkFormat format, VkImageTiling tiling, VkImageUsageFlags usage, VkMemoryPropertyFlags properties, VkImage& image, GpuAllocation& imageMemory) {
     VkImageCreateInfo imageInfo = {};
     imageInfo.sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
     imageInfo.imageType = VK_IMAGE_TYPE_2D;
@@ -700,19 +1755,41 @@ static void createImage(uint32_t width, uint32_t height, VkFormat format, VkImag
         throw std::runtime_error("failed to create image!");
     }
     
-    VkMemoryRequirements memRequirements;
-    vkGetImageMemoryRequirements(g_device, image, &memRequirements);
-    
-    VkMemoryAllocateInfo allocInfo = {};
-    allocInfo.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
-    allocInfo.allocationSize = memRequirements.size;
-    allocInfo.memoryTypeIndex = findMemoryType(memRequirements.memoryTypeBits, properties);
-    
-    if (vkAllocateMemory(g_device, &allocInfo, nullptr, &imageMemory) != VK_SUCCESS) {
+    if (!allocateImageMemory(image, properties, GPU_RESOURCE_ATTACHMENT, imageMemory)) {
         throw std::runtime_error("failed to allocate image memory!");
     }
+}
+
+// Headless stand-ins for swapchain images: one B8G8R8A8 color target per frame in flight (the format the
+// swapchain path uses, so every pipeline is shared). TRANSFER_SRC allows heidic_save_frame() readback.
+static bool createOffscreenImages() {
+    g_swapchainImageFormat = VK_FORMAT_B8G8R8A8_UNORM;
+    g_swapchainImageCount = std::max(g_maxFramesInFlight, 1u);
+    g_swapchainImages.assign(g_swapchainImageCount, VK_NULL_HANDLE);
+    g_swapchainImageViews.assign(g_swapchainImageCount, VK_NULL_HANDLE);
+    g_offscreenImageMemory.assign(g_swapchainImageCount, GpuAllocation());
     
-    vkBindImageMemory(g_device, image, imageMemory, 0);
+    for (uint32_t i = 0; i < g_swapchainImageCount; i++) {
+        createImage(g_swapchainExtent.width, g_swapchainExtent.height, g_swapchainImageFormat, VK_IMAGE_TILING_OPTIMAL,
+                    VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT | VK_IMAGE_USAGE_TRANSFER_SRC_BIT,
+                    VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, g_swapchainImages[i], g_offscreenImageMemory[i]);
+        
+        VkImageViewCreateInfo viewInfo = {};
+        viewInfo.sType = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
+        viewInfo.image = g_swapchainImages[i];
+        viewInfo.viewType = VK_IMAGE_VIEW_TYPE_2D;
+        viewInfo.format = g_swapchainImageFormat;
+        viewInfo.subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+        viewInfo.subresourceRange.levelCount = 1;
+        viewInfo.subresourceRange.layerCount = 1;
+        if (vkCreateImageView(g_device, &viewInfo, nullptr, &g_swapchainImageViews[i]) != VK_SUCCESS) {
+            std::cerr << "[EDEN] Failed to create offscreen image view!" << std::endl;
+            return false;
+        }
+    }
+    std::cout << "[EDEN] Headless: " << g_swapchainImageCount << " offscreen " << g_swapchainExtent.width << "x"
+              << g_swapchainExtent.height << " color targets" << std::endl;
+    return true;
 }
 
 static void createDepthResources() {
@@ -742,7 +1819,7 @@ static void createDepthResources() {
     }
 }
 
-// Queue Family Helper
+// Queue Family Helper (surface == VK_NULL_HANDLE: headless, any graphics family will do)
 static uint32_t findGraphicsQueueFamily(VkPhysicalDevice device, VkSurfaceKHR surface) {
     uint32_t queueFamilyCount = 0;
     vkGetPhysicalDeviceQueueFamilyProperties(device, &queueFamilyCount, nullptr);
@@ -751,6 +1828,7 @@ static uint32_t findGraphicsQueueFamily(VkPhysicalDevice device, VkSurfaceKHR su
     
     for (uint32_t i = 0; i < queueFamilyCount; i++) {
         if (queueFamilies[i].queueFlags & VK_QUEUE_GRAPHICS_BIT) {
+            if (surface == VK_NULL_HANDLE) return i;
             VkBool32 presentSupport = false;
             vkGetPhysicalDeviceSurfaceSupportKHR(device, i, surface, &presentSupport);
             if (presentSupport) {
@@ -888,9 +1966,11 @@ extern "C" void heidic_destroy_window(GLFWwindow* window) { glfwDestroyWindow(wi
 extern "C" void heidic_set_window_should_close(GLFWwindow* window, int value) { glfwSetWindowShouldClose(window, value); }
 extern "C" int heidic_get_key(GLFWwindow* window, int key) { return glfwGetKey(window, key); }
 
-// Initialize Vulkan renderer
-extern "C" int heidic_init_renderer(GLFWwindow* window) {
-    if (window == nullptr) return 0;
+// Initialize Vulkan renderer. window == nullptr sets up the headless path (g_headless, with
+// g_swapchainExtent already set): no surface extensions, no present support required, offscreen
+// color images instead of a swapchain and no ImGui platform backend.
+static int initRenderer(GLFWwindow* window) {
+    auto initStart = std::chrono::high_resolution_clock::now();
     
     try {
         // ... (Instance, Device, Swapchain, etc. - mostly same) ...
@@ -899,7 +1979,7 @@ extern "C" int heidic_init_renderer(GLFWwindow* window) {
         
         // 1. Instance
         uint32_t glfwExtensionCount = 0;
-        const char** glfwExtensions = glfwGetRequiredInstanceExtensions(&glfwExtensionCount);
+        const char** glfwExtensions = window ? glfwGetRequiredInstanceExtensions(&glfwExtensionCount) : nullptr;
         
         // Check validation layer support
         if (g_enableValidationLayers && !checkValidationLayerSupport()) {
@@ -908,13 +1988,29 @@ extern "C" int heidic_init_renderer(GLFWwindow* window) {
         }
         
         // Build extension list (GLFW extensions + debug utils if needed)
-        std::vector<const char*> extensions(glfwExtensions, glfwExtensions + glfwExtensionCount);
+        std::vector<const char*> extensions;
+        if (glfwExtensions) extensions.assign(glfwExtensions, glfwExtensions + glfwExtensionCount);
         if (g_enableValidationLayers) {
             extensions.insert(extensions.end(), g_debugUtilsExtensions.begin(), g_debugUtilsExtensions.end());
         }
         
+        // Request Vulkan 1.2 when the loader supports it (descriptor indexing for the bindless
+        // texture table is core there); a 1.0 loader rejects anything newer, so stay on 1.0
+        uint32_t loaderVersion = VK_API_VERSION_1_0;
+        auto enumerateInstanceVersion = reinterpret_cast<PFN_vkEnumerateInstanceVersion>(
+            vkGetInstanceProcAddr(nullptr, "vkEnumerateInstanceVersion"));
+        if (enumerateInstanceVersion) {
+            enumerateInstanceVersion(&loaderVersion);
+        }
+        VkApplicationInfo appInfo = {};
+        appInfo.sType = VK_STRUCTURE_TYPE_APPLICATION_INFO;
+        appInfo.pApplicationName = "EDEN";
+        appInfo.pEngineName = "EDEN";
+        appInfo.apiVersion = loaderVersion >= VK_API_VERSION_1_2 ? VK_API_VERSION_1_2 : VK_API_VERSION_1_0;
+        
         VkInstanceCreateInfo instanceInfo = {};
         instanceInfo.sType = VK_STRUCTURE_TYPE_INSTANCE_CREATE_INFO;
+        instanceInfo.pApplicationInfo = &appInfo;
         instanceInfo.enabledExtensionCount = static_cast<uint32_t>(extensions.size());
         instanceInfo.ppEnabledExtensionNames = extensions.data();
         
@@ -933,18 +2029,26 @@ extern "C" int heidic_init_renderer(GLFWwindow* window) {
         // Setup debug messenger (must be after instance creation)
         setupDebugMessenger();
 
-        // 2. Surface
-        if (glfwCreateWindowSurface(g_instance, window, nullptr, &g_surface) != VK_SUCCESS) return 0;
+        // 2. Surface (none when headless)
+        if (window && glfwCreateWindowSurface(g_instance, window, nullptr, &g_surface) != VK_SUCCESS) return 0;
 
         // 3. Physical Device
         uint32_t deviceCount = 0;
         vkEnumeratePhysicalDevices(g_instance, &deviceCount, nullptr);
+        if (deviceCount == 0) {
+            std::cerr << "[EDEN] No Vulkan device found" << std::endl;
+            return 0;
+        }
         std::vector<VkPhysicalDevice> devices(deviceCount);
         vkEnumeratePhysicalDevices(g_instance, &deviceCount, devices.data());
         g_physicalDevice = devices[0];
 
         // 4. Queue Family
         g_graphicsQueueFamilyIndex = findGraphicsQueueFamily(g_physicalDevice, g_surface);
+        if (g_graphicsQueueFamilyIndex == UINT32_MAX) {
+            std::cerr << "[EDEN] No graphics queue family" << (window ? " with present support" : "") << std::endl;
+            return 0;
+        }
         
         // 5. Logical Device
         float queuePriority = 1.0f;
@@ -954,55 +2058,91 @@ extern "C" int heidic_init_renderer(GLFWwindow* window) {
         queueInfo.queueCount = 1;
         queueInfo.pQueuePriorities = &queuePriority;
         
+        // Descriptor indexing features for the bindless texture table (Vulkan 1.2 core)
+        VkPhysicalDeviceProperties deviceProperties;
+        vkGetPhysicalDeviceProperties(g_physicalDevice, &deviceProperties);
+        VkPhysicalDeviceDescriptorIndexingFeatures indexingFeatures = {};
+        indexingFeatures.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DESCRIPTOR_INDEXING_FEATURES;
+        if (appInfo.apiVersion >= VK_API_VERSION_1_2 && deviceProperties.apiVersion >= VK_API_VERSION_1_2) {
+            VkPhysicalDeviceFeatures2 features2 = {};
+            features2.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2;
+            features2.pNext = &indexingFeatures;
+            vkGetPhysicalDeviceFeatures2(g_physicalDevice, &features2);
+            g_bindlessSupported = indexingFeatures.runtimeDescriptorArray &&
+                                  indexingFeatures.shaderSampledImageArrayNonUniformIndexing &&
+                                  indexingFeatures.descriptorBindingPartiallyBound &&
+                                  indexingFeatures.descriptorBindingSampledImageUpdateAfterBind;
+        }
+        VkPhysicalDeviceDescriptorIndexingFeatures enabledIndexingFeatures = {};
+        enabledIndexingFeatures.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DESCRIPTOR_INDEXING_FEATURES;
+        enabledIndexingFeatures.runtimeDescriptorArray = VK_TRUE;
+        enabledIndexingFeatures.shaderSampledImageArrayNonUniformIndexing = VK_TRUE;
+        enabledIndexingFeatures.descriptorBindingPartiallyBound = VK_TRUE;
+        enabledIndexingFeatures.descriptorBindingSampledImageUpdateAfterBind = VK_TRUE;
+        
+        // BC-compressed cooked textures (uncompressed payloads are used without it)
+        VkPhysicalDeviceFeatures supportedFeatures;
+        vkGetPhysicalDeviceFeatures(g_physicalDevice, &supportedFeatures);
+        VkPhysicalDeviceFeatures enabledFeatures = {};
+        enabledFeatures.textureCompressionBC = supportedFeatures.textureCompressionBC;
+        g_textureCompressionBC = supportedFeatures.textureCompressionBC == VK_TRUE;
+        
         const char* deviceExtensions[] = { VK_KHR_SWAPCHAIN_EXTENSION_NAME };
         VkDeviceCreateInfo deviceInfo = {};
         deviceInfo.sType = VK_STRUCTURE_TYPE_DEVICE_CREATE_INFO;
+        deviceInfo.pNext = g_bindlessSupported ? &enabledIndexingFeatures : nullptr;
         deviceInfo.pQueueCreateInfos = &queueInfo;
         deviceInfo.queueCreateInfoCount = 1;
-        deviceInfo.enabledExtensionCount = 1;
-        deviceInfo.ppEnabledExtensionNames = deviceExtensions;
+        deviceInfo.enabledExtensionCount = g_headless ? 0 : 1;
+        deviceInfo.ppEnabledExtensionNames = g_headless ? nullptr : deviceExtensions;
+        deviceInfo.pEnabledFeatures = &enabledFeatures;
         
         if (vkCreateDevice(g_physicalDevice, &deviceInfo, nullptr, &g_device) != VK_SUCCESS) return 0;
         vkGetDeviceQueue(g_device, g_graphicsQueueFamilyIndex, 0, &g_graphicsQueue);
+        createPipelineCache();
         
-        // 6. Swapchain
-        VkSurfaceCapabilitiesKHR capabilities;
-        vkGetPhysicalDeviceSurfaceCapabilitiesKHR(g_physicalDevice, g_surface, &capabilities);
-        g_swapchainExtent = capabilities.currentExtent;
-        g_swapchainImageCount = 3; 
+        // 6. Swapchain (offscreen images when headless)
+        if (g_headless) {
+            if (!createOffscreenImages()) return 0;
+        } else {
+            VkSurfaceCapabilitiesKHR capabilities;
+            vkGetPhysicalDeviceSurfaceCapabilitiesKHR(g_physicalDevice, g_surface, &capabilities);
+            g_swapchainExtent = capabilities.currentExtent;
+            g_swapchainImageCount = 3; 
         
-        VkSwapchainCreateInfoKHR swapchainInfo = {};
-        swapchainInfo.sType = VK_STRUCTURE_TYPE_SWAPCHAIN_CREATE_INFO_KHR;
-        swapchainInfo.surface = g_surface;
-        swapchainInfo.minImageCount = g_swapchainImageCount;
-        swapchainInfo.imageFormat = VK_FORMAT_B8G8R8A8_UNORM;
-        swapchainInfo.imageColorSpace = VK_COLOR_SPACE_SRGB_NONLINEAR_KHR;
-        swapchainInfo.imageExtent = g_swapchainExtent;
-        swapchainInfo.imageArrayLayers = 1;
-        swapchainInfo.imageUsage = VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT;
-        swapchainInfo.preTransform = capabilities.currentTransform;
-        swapchainInfo.compositeAlpha = VK_COMPOSITE_ALPHA_OPAQUE_BIT_KHR;
-        swapchainInfo.presentMode = VK_PRESENT_MODE_FIFO_KHR;
-        swapchainInfo.clipped = VK_TRUE;
+            VkSwapchainCreateInfoKHR swapchainInfo = {};
+            swapchainInfo.sType = VK_STRUCTURE_TYPE_SWAPCHAIN_CREATE_INFO_KHR;
+            swapchainInfo.surface = g_surface;
+            swapchainInfo.minImageCount = g_swapchainImageCount;
+            swapchainInfo.imageFormat = VK_FORMAT_B8G8R8A8_UNORM;
+            swapchainInfo.imageColorSpace = VK_COLOR_SPACE_SRGB_NONLINEAR_KHR;
+            swapchainInfo.imageExtent = g_swapchainExtent;
+            swapchainInfo.imageArrayLayers = 1;
+            swapchainInfo.imageUsage = VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT;
+            swapchainInfo.preTransform = capabilities.currentTransform;
+            swapchainInfo.compositeAlpha = VK_COMPOSITE_ALPHA_OPAQUE_BIT_KHR;
+            swapchainInfo.presentMode = VK_PRESENT_MODE_FIFO_KHR;
+            swapchainInfo.clipped = VK_TRUE;
         
-        if (vkCreateSwapchainKHR(g_device, &swapchainInfo, nullptr, &g_swapchain) != VK_SUCCESS) return 0;
-        g_swapchainImageFormat = VK_FORMAT_B8G8R8A8_UNORM;
-
-        vkGetSwapchainImagesKHR(g_device, g_swapchain, &g_swapchainImageCount, nullptr);
-        g_swapchainImages.resize(g_swapchainImageCount);
-        vkGetSwapchainImagesKHR(g_device, g_swapchain, &g_swapchainImageCount, g_swapchainImages.data());
-
-        g_swapchainImageViews.resize(g_swapchainImageCount);
-        for (size_t i = 0; i < g_swapchainImageCount; i++) {
-            VkImageViewCreateInfo viewInfo = {};
-            viewInfo.sType = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
-            viewInfo.image = g_swapchainImages[i];
-            viewInfo.viewType = VK_IMAGE_VIEW_TYPE_2D;
-            viewInfo.format = g_swapchainImageFormat;
-            viewInfo.subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
-            viewInfo.subresourceRange.levelCount = 1;
-            viewInfo.subresourceRange.layerCount = 1;
-            vkCreateImageView(g_device, &viewInfo, nullptr, &g_swapchainImageViews[i]);
+            if (vkCreateSwapchainKHR(g_device, &swapchainInfo, nullptr, &g_swapchain) != VK_SUCCESS) return 0;
+            g_swapchainImageFormat = VK_FORMAT_B8G8R8A8_UNORM;
+
+            vkGetSwapchainImagesKHR(g_device, g_swapchain, &g_swapchainImageCount, nullptr);
+            g_swapchainImages.resize(g_swapchainImageCount);
+            vkGetSwapchainImagesKHR(g_device, g_swapchain, &g_swapchainImageCount, g_swapchainImages.data());
+
+            g_swapchainImageViews.resize(g_swapchainImageCount);
+            for (size_t i = 0; i < g_swapchainImageCount; i++) {
+                VkImageViewCreateInfo viewInfo = {};
+                viewInfo.sType = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
+                viewInfo.image = g_swapchainImages[i];
+                viewInfo.viewType = VK_IMAGE_VIEW_TYPE_2D;
+                viewInfo.format = g_swapchainImageFormat;
+                viewInfo.subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+                viewInfo.subresourceRange.levelCount = 1;
+                viewInfo.subresourceRange.layerCount = 1;
+                vkCreateImageView(g_device, &viewInfo, nullptr, &g_swapchainImageViews[i]);
+            }
         }
 
         // 7. Command Pool
@@ -1022,7 +2162,8 @@ extern "C" int heidic_init_renderer(GLFWwindow* window) {
         colorAttachment.loadOp = VK_ATTACHMENT_LOAD_OP_CLEAR;
         colorAttachment.storeOp = VK_ATTACHMENT_STORE_OP_STORE;
         colorAttachment.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
-        colorAttachment.finalLayout = VK_IMAGE_LAYOUT_PRESENT_SRC_KHR;
+        // Offscreen images are left ready for heidic_save_frame() readback
+        colorAttachment.finalLayout = g_headless ? VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL : VK_IMAGE_LAYOUT_PRESENT_SRC_KHR;
 
         VkAttachmentDescription depthAttachment = {};
         depthAttachment.format = g_depthFormat;
@@ -1070,7 +2211,65 @@ extern "C" int heidic_init_renderer(GLFWwindow* window) {
         layoutInfo.pBindings = bindings;
         vkCreateDescriptorSetLayout(g_device, &layoutInfo, nullptr, &g_descriptorSetLayout);
 
+        // 10b. Bindless Texture Table (set 1) - one update-after-bind sampler array for all textures
+        if (g_bindlessSupported) {
+            VkPhysicalDeviceDescriptorIndexingProperties indexingProps = {};
+            indexingProps.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DESCRIPTOR_INDEXING_PROPERTIES;
+            VkPhysicalDeviceProperties2 props2 = {};
+            props2.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PROPERTIES_2;
+            props2.pNext = &indexingProps;
+            vkGetPhysicalDeviceProperties2(g_physicalDevice, &props2);
+            g_bindlessTextureCapacity = std::min({MAX_BINDLESS_TEXTURES,
+                                                  indexingProps.maxDescriptorSetUpdateAfterBindSampledImages,
+                                                  indexingProps.maxPerStageDescriptorUpdateAfterBindSamplers});
+            
+            VkDescriptorSetLayoutBinding tableBinding = {};
+            tableBinding.binding = 0;
+            tableBinding.descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+            tableBinding.descriptorCount = g_bindlessTextureCapacity;
+            tableBinding.stageFlags = VK_SHADER_STAGE_FRAGMENT_BIT;
+            
+            VkDescriptorBindingFlags tableFlags = VK_DESCRIPTOR_BINDING_PARTIALLY_BOUND_BIT | VK_DESCRIPTOR_BINDING_UPDATE_AFTER_BIND_BIT;
+            VkDescriptorSetLayoutBindingFlagsCreateInfo bindingFlagsInfo = {};
+            bindingFlagsInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_BINDING_FLAGS_CREATE_INFO;
+            bindingFlagsInfo.bindingCount = 1;
+            bindingFlagsInfo.pBindingFlags = &tableFlags;
+            
+            VkDescriptorSetLayoutCreateInfo tableLayoutInfo = {};
+            tableLayoutInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
+            tableLayoutInfo.pNext = &bindingFlagsInfo;
+            tableLayoutInfo.flags = VK_DESCRIPTOR_SET_LAYOUT_CREATE_UPDATE_AFTER_BIND_POOL_BIT;
+            tableLayoutInfo.bindingCount = 1;
+            tableLayoutInfo.pBindings = &tableBinding;
+            
+            VkDescriptorPoolSize tablePoolSize = {VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, g_bindlessTextureCapacity};
+            VkDescriptorPoolCreateInfo tablePoolInfo = {};
+            tablePoolInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+            tablePoolInfo.flags = VK_DESCRIPTOR_POOL_CREATE_UPDATE_AFTER_BIND_BIT;
+            tablePoolInfo.poolSizeCount = 1;
+            tablePoolInfo.pPoolSizes = &tablePoolSize;
+            tablePoolInfo.maxSets = 1;
+            
+            bool tableOk = vkCreateDescriptorSetLayout(g_device, &tableLayoutInfo, nullptr, &g_bindlessSetLayout) == VK_SUCCESS &&
+                           vkCreateDescriptorPool(g_device, &tablePoolInfo, nullptr, &g_bindlessDescriptorPool) == VK_SUCCESS;
+            if (tableOk) {
+                VkDescriptorSetAllocateInfo tableAllocInfo = {};
+                tableAllocInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+                tableAllocInfo.descriptorPool = g_bindlessDescriptorPool;
+                tableAllocInfo.descriptorSetCount = 1;
+                tableAllocInfo.pSetLayouts = &g_bindlessSetLayout;
+                tableOk = vkAllocateDescriptorSets(g_device, &tableAllocInfo, &g_bindlessDescriptorSet) == VK_SUCCESS;
+            }
+            if (!tableOk) {
+                std::cerr << "[EDEN] Failed to create bindless texture table, using per-texture descriptor sets" << std::endl;
+                g_bindlessSupported = false;
+            } else {
+                std::cout << "[EDEN] Bindless texture table: " << g_bindlessTextureCapacity << " slots" << std::endl;
+            }
+        }
+
         // 11. Pipeline (Triangles)
+        auto pipelinesStart = std::chrono::high_resolution_clock::now();
         auto vertCode = readFile("vert_cube.spv");
         auto fragCode = readFile("frag_cube.spv");
         if (vertCode.empty() || fragCode.empty()) return 0;
@@ -1156,6 +2355,17 @@ extern "C" int heidic_init_renderer(GLFWwindow* window) {
         pipelineLayoutInfo.pPushConstantRanges = &pushConstantRange;
 
         vkCreatePipelineLayout(g_device, &pipelineLayoutInfo, nullptr, &g_pipelineLayout);
+        
+        // Bindless layout: identical set 0 and push constants, so sets bound with either layout stay compatible
+        if (g_bindlessSupported) {
+            VkDescriptorSetLayout bindlessLayouts[] = {g_descriptorSetLayout, g_bindlessSetLayout};
+            VkPipelineLayoutCreateInfo bindlessLayoutInfo = pipelineLayoutInfo;
+            bindlessLayoutInfo.setLayoutCount = 2;
+            bindlessLayoutInfo.pSetLayouts = bindlessLayouts;
+            if (vkCreatePipelineLayout(g_device, &bindlessLayoutInfo, nullptr, &g_bindlessPipelineLayout) != VK_SUCCESS) {
+                g_bindlessSupported = false;
+            }
+        }
 
         VkGraphicsPipelineCreateInfo pipelineInfo = {};
         pipelineInfo.sType = VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_CREATE_INFO;
@@ -1172,16 +2382,99 @@ extern "C" int heidic_init_renderer(GLFWwindow* window) {
         pipelineInfo.renderPass = g_renderPass;
         pipelineInfo.subpass = 0;
         
-        vkCreateGraphicsPipelines(g_device, VK_NULL_HANDLE, 1, &pipelineInfo, nullptr, &g_pipeline);
+        vkCreateGraphicsPipelines(g_device, g_pipelineCache, 1, &pipelineInfo, nullptr, &g_pipeline);
+
+        // PACKED MESH PIPELINE (same shaders and state, PackedVertex input)
+        {
+            auto packedBinding = PackedVertex::getBindingDescription();
+            auto packedAttributes = PackedVertex::getAttributeDescriptions();
+            bool formatsSupported = true;
+            for (const auto& attribute : packedAttributes) {
+                VkFormatProperties props;
+                vkGetPhysicalDeviceFormatProperties(g_physicalDevice, attribute.format, &props);
+                if (!(props.bufferFeatures & VK_FORMAT_FEATURE_VERTEX_BUFFER_BIT)) formatsSupported = false;
+            }
+            if (formatsSupported) {
+                VkPipelineVertexInputStateCreateInfo packedVertexInput = vertexInputInfo;
+                packedVertexInput.pVertexBindingDescriptions = &packedBinding;
+                packedVertexInput.vertexAttributeDescriptionCount = static_cast<uint32_t>(packedAttributes.size());
+                packedVertexInput.pVertexAttributeDescriptions = packedAttributes.data();
+                VkGraphicsPipelineCreateInfo packedPipelineInfo = pipelineInfo;
+                packedPipelineInfo.pVertexInputState = &packedVertexInput;
+                if (vkCreateGraphicsPipelines(g_device, g_pipelineCache, 1, &packedPipelineInfo, nullptr, &g_packedMeshPipeline) != VK_SUCCESS) {
+                    g_packedMeshPipeline = VK_NULL_HANDLE;
+                }
+            }
+            if (g_packedMeshPipeline == VK_NULL_HANDLE) {
+                std::cout << "[EDEN] Packed vertex formats unavailable, meshes use the full Vertex layout" << std::endl;
+            }
+        }
 
         // LINE PIPELINE
         inputAssembly.topology = VK_PRIMITIVE_TOPOLOGY_LINE_LIST;
         rasterizer.cullMode = VK_CULL_MODE_NONE; // No culling for lines
         depthStencil.depthTestEnable = VK_FALSE; // Disable depth test for lines (draw on top)
-        vkCreateGraphicsPipelines(g_device, VK_NULL_HANDLE, 1, &pipelineInfo, nullptr, &g_linePipeline);
+        vkCreateGraphicsPipelines(g_device, g_pipelineCache, 1, &pipelineInfo, nullptr, &g_linePipeline);
+
+        // INSTANCED CUBE PIPELINE (optional - heidic_draw_cube_colored falls back to CPU-transformed vertices without it)
+        auto instancedVertCode = readFile("vert_cube_instanced.spv");
+        if (!instancedVertCode.empty()) {
+            VkShaderModule instancedVertModule;
+            createInfo2.codeSize = instancedVertCode.size();
+            createInfo2.pCode = reinterpret_cast<const uint32_t*>(instancedVertCode.data());
+            if (vkCreateShaderModule(g_device, &createInfo2, nullptr, &instancedVertModule) == VK_SUCCESS) {
+                VkPipelineShaderStageCreateInfo instancedStages[] = {
+                    {VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO, nullptr, 0, VK_SHADER_STAGE_VERTEX_BIT, instancedVertModule, "main", nullptr},
+                    shaderStages[1]
+                };
+                
+                VkVertexInputBindingDescription instancedBindings[] = {bindingDescription, CubeInstance::getBindingDescription()};
+                auto instanceAttributes = CubeInstance::getAttributeDescriptions();
+                std::vector<VkVertexInputAttributeDescription> instancedAttributes(attributeDescriptions.begin(), attributeDescriptions.end());
+                instancedAttributes.insert(instancedAttributes.end(), instanceAttributes.begin(), instanceAttributes.end());
+                
+                VkPipelineVertexInputStateCreateInfo instancedVertexInput = vertexInputInfo;
+                instancedVertexInput.vertexBindingDescriptionCount = 2;
+                instancedVertexInput.pVertexBindingDescriptions = instancedBindings;
+                instancedVertexInput.vertexAttributeDescriptionCount = static_cast<uint32_t>(instancedAttributes.size());
+                instancedVertexInput.pVertexAttributeDescriptions = instancedAttributes.data();
+                
+                // Same state as the triangle pipeline
+                inputAssembly.topology = VK_PRIMITIVE_TOPOLOGY_TRIANGLE_LIST;
+                depthStencil.depthTestEnable = VK_TRUE;
+                VkGraphicsPipelineCreateInfo instancedPipelineInfo = pipelineInfo;
+                instancedPipelineInfo.pStages = instancedStages;
+                instancedPipelineInfo.pVertexInputState = &instancedVertexInput;
+                if (vkCreateGraphicsPipelines(g_device, g_pipelineCache, 1, &instancedPipelineInfo, nullptr, &g_cubeInstancedPipeline) != VK_SUCCESS) {
+                    std::cerr << "[EDEN] Failed to create instanced cube pipeline, using per-vertex cubes" << std::endl;
+                    g_cubeInstancedPipeline = VK_NULL_HANDLE;
+                }
+                
+                // Bindless variant: same vertex stage, fragment shader indexes the texture table by instance slot
+                auto bindlessFragCode = readFile("frag_cube_bindless.spv");
+                if (g_bindlessSupported && g_cubeInstancedPipeline != VK_NULL_HANDLE && !bindlessFragCode.empty()) {
+                    VkShaderModule bindlessFragModule;
+                    createInfo2.codeSize = bindlessFragCode.size();
+                    createInfo2.pCode = reinterpret_cast<const uint32_t*>(bindlessFragCode.data());
+                    if (vkCreateShaderModule(g_device, &createInfo2, nullptr, &bindlessFragModule) == VK_SUCCESS) {
+                        instancedStages[1].module = bindlessFragModule;
+                        instancedPipelineInfo.layout = g_bindlessPipelineLayout;
+                        if (vkCreateGraphicsPipelines(g_device, g_pipelineCache, 1, &instancedPipelineInfo, nullptr, &g_cubeBindlessPipeline) != VK_SUCCESS) {
+                            std::cerr << "[EDEN] Failed to create bindless cube pipeline, using per-texture descriptor sets" << std::endl;
+                            g_cubeBindlessPipeline = VK_NULL_HANDLE;
+                        }
+                        vkDestroyShaderModule(g_device, bindlessFragModule, nullptr);
+                    }
+                }
+                vkDestroyShaderModule(g_device, instancedVertModule, nullptr);
+            }
+        } else {
+            std::cout << "[EDEN] vert_cube_instanced.spv not found, colored cubes use CPU-transformed vertices" << std::endl;
+        }
 
         vkDestroyShaderModule(g_device, vertModule, nullptr);
         vkDestroyShaderModule(g_device, fragModule, nullptr);
+        double pipelinesMs = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - pipelinesStart).count();
 
         // 12. Framebuffers
         g_framebuffers.resize(g_swapchainImageCount);
@@ -1198,17 +2491,20 @@ extern "C" int heidic_init_renderer(GLFWwindow* window) {
             vkCreateFramebuffer(g_device, &fbInfo, nullptr, &g_framebuffers[i]);
         }
 
-        // 13. Uniform Buffers
+        // 13. Uniform Buffers (one per frame in flight)
+        if (g_maxFramesInFlight > g_swapchainImageCount) {
+            g_maxFramesInFlight = g_swapchainImageCount;
+        }
         VkDeviceSize bufferSize = sizeof(UniformBufferObject);
-        g_uniformBuffers.resize(g_swapchainImageCount);
-        g_uniformBuffersMemory.resize(g_swapchainImageCount);
-        for (size_t i = 0; i < g_swapchainImageCount; i++) {
-            createBuffer(bufferSize, VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT, g_uniformBuffers[i], g_uniformBuffersMemory[i]);
+        g_uniformBuffers.resize(g_maxFramesInFlight);
+        g_uniformBuffersMemory.resize(g_maxFramesInFlight);
+        for (size_t i = 0; i < g_maxFramesInFlight; i++) {
+            createBuffer(bufferSize, VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT, g_uniformBuffers[i], g_uniformBuffersMemory[i], true);
         }
 
         // 14. Descriptor Pool
-        // We need enough descriptors for MAX_TEXTURE_SWITCHES_PER_FRAME per frame
-        uint32_t totalSets = static_cast<uint32_t>(g_swapchainImageCount * (1 + MAX_TEXTURE_SWITCHES_PER_FRAME));
+        // Only the default per-frame sets live here; textures get their own sets (or bindless slots)
+        uint32_t totalSets = static_cast<uint32_t>(g_maxFramesInFlight);
         
         VkDescriptorPoolSize poolSizes[2] = {};
         poolSizes[0].type = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
@@ -1225,85 +2521,56 @@ extern "C" int heidic_init_renderer(GLFWwindow* window) {
 
         // 15. Descriptor Sets
         // A. Create Global/Default Descriptor Sets (1 per frame) - kept for compatibility/default use
-        std::vector<VkDescriptorSetLayout> layouts(g_swapchainImageCount, g_descriptorSetLayout);
+        std::vector<VkDescriptorSetLayout> layouts(g_maxFramesInFlight, g_descriptorSetLayout);
         VkDescriptorSetAllocateInfo allocInfo = {};
         allocInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
         allocInfo.descriptorPool = g_descriptorPool;
-        allocInfo.descriptorSetCount = static_cast<uint32_t>(g_swapchainImageCount);
+        allocInfo.descriptorSetCount = static_cast<uint32_t>(g_maxFramesInFlight);
         allocInfo.pSetLayouts = layouts.data();
-        g_descriptorSets.resize(g_swapchainImageCount);
+        g_descriptorSets.resize(g_maxFramesInFlight);
         vkAllocateDescriptorSets(g_device, &allocInfo, g_descriptorSets.data());
 
-        // B. Create Batch Descriptor Sets (MAX_TEXTURE_SWITCHES_PER_FRAME per frame)
-        g_batchDescriptorSets.resize(g_swapchainImageCount);
-        g_currentBatchIndex.resize(g_swapchainImageCount, 0);
-        
-        for (size_t i = 0; i < g_swapchainImageCount; i++) {
-            g_batchDescriptorSets[i].resize(MAX_TEXTURE_SWITCHES_PER_FRAME);
-            std::vector<VkDescriptorSetLayout> batchLayouts(MAX_TEXTURE_SWITCHES_PER_FRAME, g_descriptorSetLayout);
-            
-            VkDescriptorSetAllocateInfo batchAllocInfo = {};
-            batchAllocInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
-            batchAllocInfo.descriptorPool = g_descriptorPool;
-            batchAllocInfo.descriptorSetCount = static_cast<uint32_t>(MAX_TEXTURE_SWITCHES_PER_FRAME);
-            batchAllocInfo.pSetLayouts = batchLayouts.data();
-            
-            vkAllocateDescriptorSets(g_device, &batchAllocInfo, g_batchDescriptorSets[i].data());
-            
-            // Initialize UBO binding for all batch sets (it's constant for the frame)
-            for (int b = 0; b < MAX_TEXTURE_SWITCHES_PER_FRAME; b++) {
-                VkDescriptorBufferInfo bufferInfo = {};
-                bufferInfo.buffer = g_uniformBuffers[i];
-                bufferInfo.offset = 0;
-                bufferInfo.range = sizeof(UniformBufferObject);
-                
-                VkWriteDescriptorSet descriptorWrite = {};
-                descriptorWrite.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
-                descriptorWrite.dstSet = g_batchDescriptorSets[i][b];
-                descriptorWrite.dstBinding = 0; // UBO Binding
-                descriptorWrite.descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
-                descriptorWrite.descriptorCount = 1;
-                descriptorWrite.pBufferInfo = &bufferInfo;
-                
-                vkUpdateDescriptorSets(g_device, 1, &descriptorWrite, 0, nullptr);
-            }
-        }
-
         // Create texture and write descriptors (UBO + sampler) for default sets
         createTextureAndDescriptors(window);
 
-        // 16. Command Buffers
-        g_commandBuffers.resize(g_swapchainImageCount);
+        // 16. Command Buffers (one per frame in flight)
+        g_commandBuffers.resize(g_maxFramesInFlight);
         VkCommandBufferAllocateInfo cbAllocInfo = {};
         cbAllocInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
         cbAllocInfo.commandPool = g_commandPool;
         cbAllocInfo.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
         cbAllocInfo.commandBufferCount = (uint32_t)g_commandBuffers.size();
         vkAllocateCommandBuffers(g_device, &cbAllocInfo, g_commandBuffers.data());
+        createProfilerQueries();
 
-        // 17. Sync Objects (per swapchain image to avoid semaphore reuse)
+        // 17. Sync Objects
+        // Acquire semaphores and fences are per frame in flight; render-finished semaphores are
+        // per swapchain image because the presentation engine may still hold one after our fence signals
         VkSemaphoreCreateInfo semaphoreInfo = {};
         semaphoreInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO;
         VkFenceCreateInfo fenceInfo = {};
         fenceInfo.sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO;
         fenceInfo.flags = VK_FENCE_CREATE_SIGNALED_BIT;
         
-        g_imageAvailableSemaphores.resize(g_swapchainImageCount);
-        g_renderFinishedSemaphores.resize(g_swapchainImageCount);
+        g_imageAvailableSemaphores.resize(g_maxFramesInFlight);
+        g_inFlightFences.resize(g_maxFramesInFlight);
+        for (size_t i = 0; i < g_maxFramesInFlight; i++) {
+            if (vkCreateSemaphore(g_device, &semaphoreInfo, nullptr, &g_imageAvailableSemaphores[i]) != VK_SUCCESS ||
+                vkCreateFence(g_device, &fenceInfo, nullptr, &g_inFlightFences[i]) != VK_SUCCESS) {
+                std::cerr << "[EDEN] Failed to create frame sync objects!" << std::endl;
+                return 0;
+            }
+        }
         
+        g_renderFinishedSemaphores.resize(g_swapchainImageCount);
+        g_imagesInFlight.assign(g_swapchainImageCount, VK_NULL_HANDLE);
         for (size_t i = 0; i < g_swapchainImageCount; i++) {
-            if (vkCreateSemaphore(g_device, &semaphoreInfo, nullptr, &g_imageAvailableSemaphores[i]) != VK_SUCCESS ||
-                vkCreateSemaphore(g_device, &semaphoreInfo, nullptr, &g_renderFinishedSemaphores[i]) != VK_SUCCESS) {
+            if (vkCreateSemaphore(g_device, &semaphoreInfo, nullptr, &g_renderFinishedSemaphores[i]) != VK_SUCCESS) {
                 std::cerr << "[EDEN] Failed to create semaphores!" << std::endl;
                 return 0;
             }
         }
-        
-        vkCreateFence(g_device, &fenceInfo, nullptr, &g_inFlightFence);
-        
-        // Create separate fence for image acquisition
-        fenceInfo.flags = 0;  // Not signaled initially
-        vkCreateFence(g_device, &fenceInfo, nullptr, &g_imageAvailableFence);
+        std::cout << "[EDEN] Frames in flight: " << g_maxFramesInFlight << " (swapchain images: " << g_swapchainImageCount << ")" << std::endl;
 
         // 18. Cube
         createCube();
@@ -1358,51 +2625,7 @@ extern "C" int heidic_init_renderer(GLFWwindow* window) {
         g_greyCubeVertexCount = static_cast<uint32_t>(greyVertices.size());
         VkDeviceSize greyBufferSize = sizeof(greyVertices[0]) * greyVertices.size();
         
-        VkBuffer greyStagingBuffer;
-        VkDeviceMemory greyStagingBufferMemory;
-        createBuffer(greyBufferSize, VK_BUFFER_USAGE_TRANSFER_SRC_BIT, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT, greyStagingBuffer, greyStagingBufferMemory);
-        
-        void* greyData;
-        vkMapMemory(g_device, greyStagingBufferMemory, 0, greyBufferSize, 0, &greyData);
-        memcpy(greyData, greyVertices.data(), (size_t)greyBufferSize);
-        vkUnmapMemory(g_device, greyStagingBufferMemory);
-        
-        createBuffer(greyBufferSize, VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_VERTEX_BUFFER_BIT, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, g_greyCubeVertexBuffer, g_greyCubeVertexMemory);
-        
-        VkCommandBufferAllocateInfo greyAllocInfo = {};
-        greyAllocInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
-        greyAllocInfo.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
-        greyAllocInfo.commandPool = g_commandPool;
-        greyAllocInfo.commandBufferCount = 1;
-        
-        VkCommandBuffer greyCommandBuffer;
-        vkAllocateCommandBuffers(g_device, &greyAllocInfo, &greyCommandBuffer);
-        
-        VkCommandBufferBeginInfo greyBeginInfo = {};
-        greyBeginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
-        greyBeginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
-        
-        vkBeginCommandBuffer(greyCommandBuffer, &greyBeginInfo);
-        
-        VkBufferCopy greyCopyRegion = {};
-        greyCopyRegion.srcOffset = 0;
-        greyCopyRegion.dstOffset = 0;
-        greyCopyRegion.size = greyBufferSize;
-        vkCmdCopyBuffer(greyCommandBuffer, greyStagingBuffer, g_greyCubeVertexBuffer, 1, &greyCopyRegion);
-        
-        vkEndCommandBuffer(greyCommandBuffer);
-        
-        VkSubmitInfo greySubmitInfo = {};
-        greySubmitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
-        greySubmitInfo.commandBufferCount = 1;
-        greySubmitInfo.pCommandBuffers = &greyCommandBuffer;
-        
-        vkQueueSubmit(g_graphicsQueue, 1, &greySubmitInfo, VK_NULL_HANDLE);
-        vkQueueWaitIdle(g_graphicsQueue);
-        
-        vkFreeCommandBuffers(g_device, g_commandPool, 1, &greyCommandBuffer);
-        vkDestroyBuffer(g_device, greyStagingBuffer, nullptr);
-        vkFreeMemory(g_device, greyStagingBufferMemory, nullptr);
+        createDeviceLocalBuffer(greyVertices.data(), greyBufferSize, VK_BUFFER_USAGE_VERTEX_BUFFER_BIT, g_greyCubeVertexBuffer, g_greyCubeVertexMemory, true);
         
         // 18c. Create blue cube for created cubes (with proper UVs for texture)
         float blueR = 0.2f, blueG = 0.4f, blueB = 1.0f; // Bright blue
@@ -1454,59 +2677,15 @@ extern "C" int heidic_init_renderer(GLFWwindow* window) {
         g_blueCubeVertexCount = static_cast<uint32_t>(blueVertices.size());
         VkDeviceSize blueBufferSize = sizeof(blueVertices[0]) * blueVertices.size();
         
-        VkBuffer blueStagingBuffer;
-        VkDeviceMemory blueStagingBufferMemory;
-        createBuffer(blueBufferSize, VK_BUFFER_USAGE_TRANSFER_SRC_BIT, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT, blueStagingBuffer, blueStagingBufferMemory);
-        
-        void* blueData;
-        vkMapMemory(g_device, blueStagingBufferMemory, 0, blueBufferSize, 0, &blueData);
-        memcpy(blueData, blueVertices.data(), (size_t)blueBufferSize);
-        vkUnmapMemory(g_device, blueStagingBufferMemory);
-        
-        createBuffer(blueBufferSize, VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_VERTEX_BUFFER_BIT, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, g_blueCubeVertexBuffer, g_blueCubeVertexMemory);
-        
-        VkCommandBufferAllocateInfo blueAllocInfo = {};
-        blueAllocInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
-        blueAllocInfo.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
-        blueAllocInfo.commandPool = g_commandPool;
-        blueAllocInfo.commandBufferCount = 1;
-        
-        VkCommandBuffer blueCommandBuffer;
-        vkAllocateCommandBuffers(g_device, &blueAllocInfo, &blueCommandBuffer);
-        
-        VkCommandBufferBeginInfo blueBeginInfo = {};
-        blueBeginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
-        blueBeginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
-        
-        vkBeginCommandBuffer(blueCommandBuffer, &blueBeginInfo);
-        
-        VkBufferCopy blueCopyRegion = {};
-        blueCopyRegion.srcOffset = 0;
-        blueCopyRegion.dstOffset = 0;
-        blueCopyRegion.size = blueBufferSize;
-        vkCmdCopyBuffer(blueCommandBuffer, blueStagingBuffer, g_blueCubeVertexBuffer, 1, &blueCopyRegion);
-        
-        vkEndCommandBuffer(blueCommandBuffer);
-        
-        VkSubmitInfo blueSubmitInfo = {};
-        blueSubmitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
-        blueSubmitInfo.commandBufferCount = 1;
-        blueSubmitInfo.pCommandBuffers = &blueCommandBuffer;
-        
-        vkQueueSubmit(g_graphicsQueue, 1, &blueSubmitInfo, VK_NULL_HANDLE);
-        vkQueueWaitIdle(g_graphicsQueue);
-        
-        vkFreeCommandBuffers(g_device, g_commandPool, 1, &blueCommandBuffer);
-        vkDestroyBuffer(g_device, blueStagingBuffer, nullptr);
-        vkFreeMemory(g_device, blueStagingBufferMemory, nullptr);
+        createDeviceLocalBuffer(blueVertices.data(), blueBufferSize, VK_BUFFER_USAGE_VERTEX_BUFFER_BIT, g_blueCubeVertexBuffer, g_blueCubeVertexMemory, true);
 
-        // 19. Line Buffer
-        createBuffer(g_lineBufferSize, VK_BUFFER_USAGE_VERTEX_BUFFER_BIT, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT, g_lineVertexBuffer, g_lineVertexMemory);
-        
-        // Create colored cube vertex buffer (similar to line buffer)
-        // Increased size to support multiple batches per frame (10MB per batch, up to 10 batches = 100MB)
-        VkDeviceSize coloredCubeBufferSize = 100 * 1024 * 1024; // 100MB for colored cubes (10 batches * 10MB each)
-        createBuffer(coloredCubeBufferSize, VK_BUFFER_USAGE_VERTEX_BUFFER_BIT, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT, g_coloredCubeVertexBuffer, g_coloredCubeVertexMemory);
+        // 19. Transient Vertex Rings (lines + colored cube batches, one per frame in flight)
+        g_transientRings.resize(g_maxFramesInFlight);
+        for (size_t i = 0; i < g_maxFramesInFlight; i++) {
+            if (!createTransientRingBuffer(g_transientRings[i], TRANSIENT_RING_INITIAL_SIZE)) {
+                return 0;
+            }
+        }
 
         // 20. ImGui Init
         VkDescriptorPoolSize imguiPoolSizes[] = {
@@ -1537,28 +2716,47 @@ extern "C" int heidic_init_renderer(GLFWwindow* window) {
         // Enable docking (requires ImGui 'docking' branch)
         io.ConfigFlags |= ImGuiConfigFlags_DockingEnable;
         
-        // Set up .ini file path for layout persistence
-        io.IniFilename = "imgui_layout.ini";
+        // Set up .ini file path for layout persistence (a headless run must not clobber the editor's layout)
+        io.IniFilename = g_headless ? nullptr : "imgui_layout.ini";
         
         ImGui::StyleColorsDark();
 
-        ImGui_ImplGlfw_InitForVulkan(window, true);
+        if (g_headless) {
+            // No platform backend: heidic_begin_frame() feeds display size and delta time itself
+            io.DisplaySize = ImVec2((float)g_swapchainExtent.width, (float)g_swapchainExtent.height);
+        } else {
+            ImGui_ImplGlfw_InitForVulkan(window, true);
+        }
         ImGui_ImplVulkan_InitInfo init_info = {};
         init_info.Instance = g_instance;
         init_info.PhysicalDevice = g_physicalDevice;
         init_info.Device = g_device;
         init_info.QueueFamily = g_graphicsQueueFamilyIndex;
         init_info.Queue = g_graphicsQueue;
-        init_info.PipelineCache = VK_NULL_HANDLE;
+        init_info.PipelineCache = g_pipelineCache;
         init_info.DescriptorPool = g_imguiDescriptorPool;
-        init_info.MinImageCount = g_swapchainImageCount;
-        init_info.ImageCount = g_swapchainImageCount;
+        init_info.MinImageCount = std::max(g_swapchainImageCount, 2u);  // The backend requires >= 2 (headless may run one)
+        init_info.ImageCount = std::max(g_swapchainImageCount, 2u);
         init_info.Allocator = nullptr;
         init_info.PipelineInfoMain.RenderPass = g_renderPass;
         init_info.PipelineInfoMain.Subpass = 0;
         init_info.PipelineInfoMain.MSAASamples = VK_SAMPLE_COUNT_1_BIT;
         
+        auto imguiStart = std::chrono::high_resolution_clock::now();
         ImGui_ImplVulkan_Init(&init_info);
+        double imguiMs = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - imguiStart).count();
+        
+        // Default texture and built-in cube buffers go to the GPU in a single submission
+        flushUploads();
+        
+        // Persist a freshly built cache right away; a warm one is refreshed at shutdown
+        if (!g_pipelineCacheWarm) {
+            savePipelineCache();
+        }
+        
+        g_rendererInitMs = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - initStart).count();
+        std::cout << "[EDEN] Renderer init " << g_rendererInitMs << " ms (" << (g_pipelineCacheWarm ? "warm" : "cold")
+                  << " pipeline cache: runtime pipelines " << pipelinesMs << " ms, ImGui " << imguiMs << " ms)" << std::endl;
         
         return 1;
     } catch (const std::exception& e) {
@@ -1567,12 +2765,113 @@ extern "C" int heidic_init_renderer(GLFWwindow* window) {
     }
 }
 
+extern "C" int heidic_init_renderer(GLFWwindow* window) {
+    if (window == nullptr) return 0;
+    return initRenderer(window);
+}
+
+// Offscreen rendering for benchmarks and build machines without a display: same frame API, frames
+// go to width x height images instead of a swapchain. Needs no GLFW window (or glfwInit) and no
+// surface/swapchain extensions, so a software ICD such as lavapipe works.
+extern "C" int heidic_init_renderer_headless(int width, int height) {
+    if (width <= 0 || height <= 0) return 0;
+    g_headless = true;
+    g_swapchainExtent = {static_cast<uint32_t>(width), static_cast<uint32_t>(height)};
+    return initRenderer(nullptr);
+}
+
+extern "C" int heidic_is_headless() {
+    return g_headless ? 1 : 0;
+}
+
+// CPU-only profiling: the whole heidic_* frame API runs its CPU side (cube transforms and instance
+// batching, culling, render queue sorting and state tracking, transient copies, ImGui draw lists)
+// but no Vulkan object is created and nothing is recorded or submitted. Render queue and cull
+// counters, heidic_get_frame_time_ms and heidic_get_end_frame_cpu_ms report as usual; totals are
+// printed by heidic_cleanup_renderer(). Texture and mesh loads register placeholders.
+extern "C" int heidic_init_renderer_null(int width, int height) {
+    if (width <= 0 || height <= 0 || g_device != VK_NULL_HANDLE) return 0;
+    auto initStart = std::chrono::high_resolution_clock::now();
+    g_nullRenderer = true;
+    g_swapchainExtent = {static_cast<uint32_t>(width), static_cast<uint32_t>(height)};
+    g_swapchainImageCount = g_maxFramesInFlight;
+    
+    // Same code paths as a device with instanced cubes and no bindless table
+    g_pipeline = nullRendererHandle<VkPipeline>();
+    g_linePipeline = nullRendererHandle<VkPipeline>();
+    g_cubeInstancedPipeline = nullRendererHandle<VkPipeline>();
+    g_pipelineLayout = nullRendererHandle<VkPipelineLayout>();
+    g_descriptorSets.clear();
+    for (uint32_t i = 0; i < g_maxFramesInFlight; i++) {
+        g_descriptorSets.push_back(nullRendererHandle<VkDescriptorSet>());
+    }
+    g_transientRings.resize(g_maxFramesInFlight);
+    for (TransientVertexRing& ring : g_transientRings) {
+        createTransientRingBuffer(ring, TRANSIENT_RING_INITIAL_SIZE);
+    }
+    createCube();
+    g_greyCubeVertexBuffer = nullRendererHandle<VkBuffer>();
+    g_greyCubeVertexCount = g_cubeVertexCount;
+    g_blueCubeVertexBuffer = nullRendererHandle<VkBuffer>();
+    g_blueCubeVertexCount = g_cubeVertexCount;
+    
+    IMGUI_CHECKVERSION();
+    ImGui::CreateContext();
+    ImGuiIO& io = ImGui::GetIO();
+    io.ConfigFlags |= ImGuiConfigFlags_DockingEnable;
+    io.IniFilename = nullptr;
+    io.BackendRendererName = "eden_null";
+    io.BackendFlags |= ImGuiBackendFlags_RendererHasTextures;  // Font textures are requested, never created
+    io.DisplaySize = ImVec2((float)width, (float)height);
+    ImGui::StyleColorsDark();
+    
+    g_rendererInitMs = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - initStart).count();
+    std::cout << "[EDEN] Null renderer " << width << "x" << height << " (no Vulkan device, nothing is recorded)" << std::endl;
+    return 1;
+}
+
+extern "C" int heidic_is_null_renderer() {
+    return g_nullRenderer ? 1 : 0;
+}
+
+// Texture streaming (defined next to heidic_load_texture_for_rendering)
+static void pumpTextureStreaming();
+static void shutdownTextureStreaming();
+// Texture residency (defined after the texture preview cache)
+static void evictTextures();
+// Texture palette thumbnails (defined with the texture preview cache)
+static bool thumbnailTextureRef(int64_t previewId, ImTextureRef& texture, ImVec2& uv0, ImVec2& uv1);
+static void saveThumbnailCache();
+
 extern "C" void heidic_cleanup_renderer() {
+    if (g_nullRenderer) {
+        ImGui::DestroyContext();
+        if (g_nullTotals.frames > 0) {
+            double frames = (double)g_nullTotals.frames;
+            std::cout << "[EDEN] Null renderer: " << g_nullTotals.frames << " frames, avg frame " << (g_nullTotals.frameMs / frames)
+                      << " ms, avg end_frame CPU " << (g_nullTotals.endFrameCpuMs / frames) << " ms, avg "
+                      << (g_nullTotals.packets / frames) << " packets / " << (g_nullTotals.drawCalls / frames) << " draws / "
+                      << (g_nullTotals.instances / frames) << " instances" << std::endl;
+        }
+        return;
+    }
     vkDeviceWaitIdle(g_device);
+    finishUploads();
+    shutdownTextureStreaming();
+    savePipelineCache();
+    saveThumbnailCache();
     ImGui_ImplVulkan_Shutdown();
-    ImGui_ImplGlfw_Shutdown();
+    if (!g_headless) ImGui_ImplGlfw_Shutdown();
     ImGui::DestroyContext();
     
+    // Offscreen targets are ours (swapchain images belong to the swapchain)
+    for (size_t i = 0; i < g_offscreenImageMemory.size(); i++) {
+        vkDestroyImageView(g_device, g_swapchainImageViews[i], nullptr);
+        destroyImage(g_swapchainImages[i], g_offscreenImageMemory[i]);
+    }
+    g_offscreenImageMemory.clear();
+    destroyProfilerQueries();
+    
     // Cleanup debug messenger
     if (g_enableValidationLayers && g_debugMessenger != VK_NULL_HANDLE) {
         DestroyDebugUtilsMessengerEXT(g_instance, g_debugMessenger, nullptr);
@@ -1598,214 +2897,1074 @@ extern "C" int heidic_is_mouse_button_pressed(GLFWwindow* window, int button) {
     return glfwGetMouseButton(window, button) == GLFW_PRESS;
 }
 
-// FRAME CONTROL
-static uint32_t g_frameCounter = 0;  // Track frame number for debugging
+// Descriptor set for the texture selected by heidic_load_texture_for_rendering()
+static VkDescriptorSet currentTextureDescriptorSet() {
+    if (g_currentTexture != nullptr) {
+        return getTextureDescriptorSet(*g_currentTexture);
+    }
+    return g_descriptorSets[g_currentFrame];
+}
 
-extern "C" void heidic_begin_frame() {
-    g_frameCounter++;
+// ============================================================================
+// FRUSTUM CULLING
+// ============================================================================
+// Planes are extracted from g_currentProj * g_currentView whenever the camera changes. Bounds are
+// gathered as SoA arrays (center + half extent per axis) and tested 8 boxes at a time with AVX2
+// when the CPU has it (picked at runtime), otherwise 4 at a time with SSE, with a scalar tail. A
+// box is visible unless it lies entirely behind one plane, so results are conservative.
+
+struct FrustumPlane {
+    float nx, ny, nz, d;
+};
+
+struct AabbSoA {
+    std::vector<float> cx, cy, cz;  // Centers
+    std::vector<float> ex, ey, ez;  // Half extents
     
-    // CRITICAL: Clear the begun windows set at the VERY START of each frame
-    // This MUST happen before any ImGui calls to prevent duplicate Begin() calls
-    g_begunWindowsThisFrame.clear();
-    g_windowsThatActuallyBegan.clear();
-    // Clear the open windows stack - any remaining windows from previous frame are invalid
-    while (!g_openWindowsStack.empty()) {
-        g_openWindowsStack.pop();
+    size_t size() const { return cx.size(); }
+    void clear() {
+        cx.clear(); cy.clear(); cz.clear();
+        ex.clear(); ey.clear(); ez.clear();
     }
-    
-    // Frame counter for debugging (commented out to reduce log spam)
-    // std::cout << "[DEBUG] heidic_begin_frame: Frame #" << g_frameCounter << " - Cleared window tracking sets" << std::endl;
-    
-    // Start ImGui Frame
-    ImGui_ImplVulkan_NewFrame();
-    ImGui_ImplGlfw_NewFrame();
-    ImGui::NewFrame();
-    
-    // Process pending combination editing start (deferred from previous frame to avoid same-frame conflicts)
-    if (g_pendingStartEditingId >= 0) {
-        g_editingCombinationId = g_pendingStartEditingId;
-        g_pendingStartEditingId = -1;
-        // Initialize buffer with current name
-        const char* current_name = heidic_format_combination_name(g_editingCombinationId);
-        strncpy(g_combinationNameBuffer, current_name, sizeof(g_combinationNameBuffer) - 1);
-        g_combinationNameBuffer[sizeof(g_combinationNameBuffer) - 1] = '\0';
+    void push(const glm::vec3& center, const glm::vec3& extent) {
+        cx.push_back(center.x); cy.push_back(center.y); cz.push_back(center.z);
+        ex.push_back(extent.x); ey.push_back(extent.y); ez.push_back(extent.z);
     }
+};
 
-    // Clear lines for this frame
-    g_lineVertices.clear();
-    g_coloredCubeVertices.clear();
-    
-    // NOTE: Window tracking sets are now cleared at the VERY START of heidic_begin_frame()
-    // (moved above to ensure they're cleared before any ImGui calls)
+struct CullStats {
+    uint32_t tested = 0;
+    uint32_t visible = 0;
+    uint32_t culled = 0;
+};
 
-    // CRITICAL: Wait for the in-flight fence to ensure the previous frame's command buffer is done
-    // This MUST happen before we reset the fence or command buffer
-    vkWaitForFences(g_device, 1, &g_inFlightFence, VK_TRUE, UINT64_MAX);
-    
-    // Now that GPU is done, safely destroy any pending textures
-    if (g_pendingTextureImageView != VK_NULL_HANDLE) {
-        vkDestroyImageView(g_device, g_pendingTextureImageView, nullptr);
-        g_pendingTextureImageView = VK_NULL_HANDLE;
+static FrustumPlane g_frustumPlanes[6];
+static bool g_frustumCullingEnabled = true;
+static CullStats g_cullStatsFrame;  // Accumulated while the current frame is recorded
+static CullStats g_cullStats;       // Last completed frame
+
+// Gribb/Hartmann plane extraction for a zero-to-one depth range projection
+static void updateFrustumPlanes(const glm::mat4& viewProj) {
+    auto row = [&](int r) { return glm::vec4(viewProj[0][r], viewProj[1][r], viewProj[2][r], viewProj[3][r]); };
+    glm::vec4 planes[6] = {
+        row(3) + row(0),  // Left
+        row(3) - row(0),  // Right
+        row(3) + row(1),  // Bottom
+        row(3) - row(1),  // Top
+        row(2),           // Near (z >= 0)
+        row(3) - row(2)   // Far
+    };
+    for (int i = 0; i < 6; i++) {
+        float length = glm::length(glm::vec3(planes[i]));
+        if (length > 0.0f) planes[i] /= length;
+        g_frustumPlanes[i] = {planes[i].x, planes[i].y, planes[i].z, planes[i].w};
     }
-    if (g_pendingTextureImage != VK_NULL_HANDLE) {
-        vkDestroyImage(g_device, g_pendingTextureImage, nullptr);
-        g_pendingTextureImage = VK_NULL_HANDLE;
+}
+
+static bool isAabbVisible(const glm::vec3& center, const glm::vec3& extent) {
+    if (!g_frustumCullingEnabled) return true;
+    for (const FrustumPlane& p : g_frustumPlanes) {
+        float distance = p.nx * center.x + p.ny * center.y + p.nz * center.z + p.d;
+        float radius = fabsf(p.nx) * extent.x + fabsf(p.ny) * extent.y + fabsf(p.nz) * extent.z;
+        if (distance + radius < 0.0f) return false;
     }
-    if (g_pendingTextureImageMemory != VK_NULL_HANDLE) {
-        vkFreeMemory(g_device, g_pendingTextureImageMemory, nullptr);
-        g_pendingTextureImageMemory = VK_NULL_HANDLE;
+    return true;
+}
+
+// World-space AABB of a box of the given local half extents under an affine model matrix
+static void transformAabb(const glm::mat4& model, const glm::vec3& localCenter, const glm::vec3& localExtent, glm::vec3& center, glm::vec3& extent) {
+    center = glm::vec3(model * glm::vec4(localCenter, 1.0f));
+    for (int i = 0; i < 3; i++) {
+        extent[i] = fabsf(model[0][i]) * localExtent.x + fabsf(model[1][i]) * localExtent.y + fabsf(model[2][i]) * localExtent.z;
+    }
+}
+
+#if defined(EDEN_SIMD_AVX2_DISPATCH)
+static bool cpuSupportsAvx2() {
+#if defined(_MSC_VER) && !defined(__clang__)
+    int info[4];
+    __cpuid(info, 0);
+    if (info[0] < 7) return false;
+    __cpuid(info, 1);
+    bool osxsave = (info[2] & (1 << 27)) != 0;
+    bool avx = (info[2] & (1 << 28)) != 0;
+    if (!osxsave || !avx || (_xgetbv(0) & 0x6) != 0x6) return false;  // OS must save the YMM state
+    __cpuidex(info, 7, 0);
+    return (info[1] & (1 << 5)) != 0;
+#else
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx2") != 0;
+#endif
+}
+
+// Boxes [0, count) in batches of 8; returns how many were tested
+EDEN_TARGET_AVX2 static size_t cullAabbsAvx2(const AabbSoA& boxes, uint8_t* visible) {
+    size_t count = boxes.size();
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        __m256 cx = _mm256_loadu_ps(&boxes.cx[i]);
+        __m256 cy = _mm256_loadu_ps(&boxes.cy[i]);
+        __m256 cz = _mm256_loadu_ps(&boxes.cz[i]);
+        __m256 ex = _mm256_loadu_ps(&boxes.ex[i]);
+        __m256 ey = _mm256_loadu_ps(&boxes.ey[i]);
+        __m256 ez = _mm256_loadu_ps(&boxes.ez[i]);
+        __m256 inside = _mm256_castsi256_ps(_mm256_set1_epi32(-1));
+        for (const FrustumPlane& p : g_frustumPlanes) {
+            __m256 distance = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(cx, _mm256_set1_ps(p.nx)), _mm256_mul_ps(cy, _mm256_set1_ps(p.ny))),
+                                            _mm256_add_ps(_mm256_mul_ps(cz, _mm256_set1_ps(p.nz)), _mm256_set1_ps(p.d)));
+            __m256 radius = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(ex, _mm256_set1_ps(fabsf(p.nx))), _mm256_mul_ps(ey, _mm256_set1_ps(fabsf(p.ny)))),
+                                          _mm256_mul_ps(ez, _mm256_set1_ps(fabsf(p.nz))));
+            inside = _mm256_and_ps(inside, _mm256_cmp_ps(_mm256_add_ps(distance, radius), _mm256_setzero_ps(), _CMP_GE_OQ));
+        }
+        int mask = _mm256_movemask_ps(inside);
+        for (int k = 0; k < 8; k++) visible[i + k] = (uint8_t)((mask >> k) & 1);
     }
-    
-    // Now it's safe to reset the fence since we've waited
-    vkResetFences(g_device, 1, &g_inFlightFence);
-    
-    uint32_t imageIndex;
-    // Acquire next image using the semaphore for the frame we'll use
-    // We'll use a single semaphore (index 0) for acquisition - it will be consumed in submit
-    VkResult result = vkAcquireNextImageKHR(g_device, g_swapchain, UINT64_MAX, 
-                                             g_imageAvailableSemaphores[0],  // Use semaphore for acquisition
-                                             VK_NULL_HANDLE,  // No fence
-                                             &imageIndex);
-    
-    if (result == VK_ERROR_OUT_OF_DATE_KHR || result == VK_SUBOPTIMAL_KHR) {
-        g_commandBufferStarted = false;  // Command buffer not started due to early return
-        return;
+    return i;
+}
+#endif
+
+#if defined(EDEN_SIMD_AVX) || defined(EDEN_SIMD_SSE)
+// Boxes [0, count) in batches of 4; returns how many were tested
+static size_t cullAabbsSse(const AabbSoA& boxes, uint8_t* visible) {
+    size_t count = boxes.size();
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        __m128 cx = _mm_loadu_ps(&boxes.cx[i]);
+        __m128 cy = _mm_loadu_ps(&boxes.cy[i]);
+        __m128 cz = _mm_loadu_ps(&boxes.cz[i]);
+        __m128 ex = _mm_loadu_ps(&boxes.ex[i]);
+        __m128 ey = _mm_loadu_ps(&boxes.ey[i]);
+        __m128 ez = _mm_loadu_ps(&boxes.ez[i]);
+        __m128 inside = _mm_castsi128_ps(_mm_set1_epi32(-1));
+        for (const FrustumPlane& p : g_frustumPlanes) {
+            __m128 distance = _mm_add_ps(_mm_add_ps(_mm_mul_ps(cx, _mm_set1_ps(p.nx)), _mm_mul_ps(cy, _mm_set1_ps(p.ny))),
+                                         _mm_add_ps(_mm_mul_ps(cz, _mm_set1_ps(p.nz)), _mm_set1_ps(p.d)));
+            __m128 radius = _mm_add_ps(_mm_add_ps(_mm_mul_ps(ex, _mm_set1_ps(fabsf(p.nx))), _mm_mul_ps(ey, _mm_set1_ps(fabsf(p.ny)))),
+                                       _mm_mul_ps(ez, _mm_set1_ps(fabsf(p.nz))));
+            inside = _mm_and_ps(inside, _mm_cmpge_ps(_mm_add_ps(distance, radius), _mm_setzero_ps()));
+        }
+        int mask = _mm_movemask_ps(inside);
+        for (int k = 0; k < 4; k++) visible[i + k] = (uint8_t)((mask >> k) & 1);
     }
-    
-    // Use the actual imageIndex we got from acquire
-    g_currentFrame = imageIndex;
-    
-    // Reset batch index for this frame
-    if (g_currentBatchIndex.size() > g_currentFrame) {
-        g_currentBatchIndex[g_currentFrame] = 0;
+    return i;
+}
+#endif
+
+// Widest batch kernel this build and CPU can run, picked on first use (nullptr = scalar only)
+typedef size_t (*CullAabbsKernel)(const AabbSoA& boxes, uint8_t* visible);
+static CullAabbsKernel g_cullAabbsKernel = nullptr;
+static bool g_cullAabbsKernelChosen = false;
+
+static CullAabbsKernel chooseCullAabbsKernel() {
+#if defined(EDEN_SIMD_AVX2_DISPATCH)
+    if (cpuSupportsAvx2()) return cullAabbsAvx2;
+#endif
+#if defined(EDEN_SIMD_AVX) || defined(EDEN_SIMD_SSE)
+    return cullAabbsSse;
+#else
+    return nullptr;
+#endif
+}
+
+// Test every box; visible[i] = 1 if box i may be on screen. Returns the visible count and
+// adds to this frame's statistics.
+static size_t cullAabbs(const AabbSoA& boxes, std::vector<uint8_t>& visible) {
+    size_t count = boxes.size();
+    visible.resize(count);
+    if (!g_frustumCullingEnabled) {
+        std::fill(visible.begin(), visible.end(), 1);
+        return count;
     }
     
-    // Now reset the command buffer for this frame (safe because we waited for the fence above)
-    vkResetCommandBuffer(g_commandBuffers[g_currentFrame], 0);
-    
-    VkCommandBuffer cb = g_commandBuffers[g_currentFrame];
-    VkCommandBufferBeginInfo beginInfo = {VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO};
-    VkResult beginResult = vkBeginCommandBuffer(cb, &beginInfo);
-    if (beginResult != VK_SUCCESS) {
-        g_commandBufferStarted = false;
-        return;  // Failed to start command buffer
+    if (!g_cullAabbsKernelChosen) {
+        g_cullAabbsKernel = chooseCullAabbsKernel();
+        g_cullAabbsKernelChosen = true;
+    }
+    size_t i = g_cullAabbsKernel ? g_cullAabbsKernel(boxes, visible.data()) : 0;
+    for (; i < count; i++) {
+        visible[i] = isAabbVisible(glm::vec3(boxes.cx[i], boxes.cy[i], boxes.cz[i]), glm::vec3(boxes.ex[i], boxes.ey[i], boxes.ez[i])) ? 1 : 0;
     }
-    g_commandBufferStarted = true;  // Mark that command buffer was successfully started
-    
-    VkRenderPassBeginInfo renderPassInfo = {};
-    renderPassInfo.sType = VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO;
-    renderPassInfo.renderPass = g_renderPass;
-    renderPassInfo.framebuffer = g_framebuffers[g_currentFrame];
-    renderPassInfo.renderArea.offset = {0, 0};
-    renderPassInfo.renderArea.extent = g_swapchainExtent;
-    
-    VkClearValue clearValues[2];
-    clearValues[0].color = {{0.0f, 0.0f, 0.0f, 1.0f}};
-    clearValues[1].depthStencil = {1.0f, 0};
-    renderPassInfo.clearValueCount = 2;
-    renderPassInfo.pClearValues = clearValues;
-    
-    vkCmdBeginRenderPass(cb, &renderPassInfo, VK_SUBPASS_CONTENTS_INLINE);
-    vkCmdBindPipeline(cb, VK_PIPELINE_BIND_POINT_GRAPHICS, g_pipeline);
     
-    // Bind global UBO
-    vkCmdBindDescriptorSets(cb, VK_PIPELINE_BIND_POINT_GRAPHICS, g_pipelineLayout, 0, 1, &g_descriptorSets[g_currentFrame], 0, nullptr);
-
-    // Bind Cube VB
-    VkBuffer vertexBuffers[] = {g_cubeVertexBuffer};
-    VkDeviceSize offsets[] = {0};
-    vkCmdBindVertexBuffers(cb, 0, 1, vertexBuffers, offsets);
+    size_t visibleCount = 0;
+    for (uint8_t v : visible) visibleCount += v;
+    g_cullStatsFrame.tested += static_cast<uint32_t>(count);
+    g_cullStatsFrame.visible += static_cast<uint32_t>(visibleCount);
+    g_cullStatsFrame.culled += static_cast<uint32_t>(count - visibleCount);
+    return visibleCount;
 }
 
-extern "C" void heidic_end_frame() {
-    // If command buffer wasn't started this frame, don't try to record commands
-    if (!g_commandBufferStarted) {
+extern "C" void heidic_set_frustum_culling(int enabled) { g_frustumCullingEnabled = (enabled != 0); }
+extern "C" int heidic_get_cull_visible_count() { return static_cast<int>(g_cullStats.visible); }
+extern "C" int heidic_get_cull_culled_count() { return static_cast<int>(g_cullStats.culled); }
+
+// ============================================================================
+// PROFILER
+// ============================================================================
+// CPU scope timers and GPU timestamp queries around the frame phases. Each frame's results go
+// into a ring of PROFILE_HISTORY entries: CPU times when the next frame begins, GPU times once the
+// frame's ring slot is reused (its fence has signalled, so the queries are available without
+// waiting). Percentiles are taken over the whole ring. GPU phases are those recorded into the
+// frame's command buffer; the rest report CPU time only.
+
+enum ProfilePhase {
+    PROFILE_BEGIN_FRAME = 0,  // heidic_begin_frame (fence wait, streaming, acquire, command buffer begin)
+    PROFILE_CUBE_BATCH,       // Colored cube flushes: cull + instance upload (drawn as part of the render queue)
+    PROFILE_RENDER_QUEUE,     // Cull, sort and record the queued packets (GPU: every draw before the lines)
+    PROFILE_LINES,            // Line vertex upload (GPU: the line draws)
+    PROFILE_IMGUI,            // ImGui::Render + draw data recording
+    PROFILE_SUBMIT,           // Upload flush + vkQueueSubmit
+    PROFILE_PRESENT,          // vkQueuePresentKHR
+    PROFILE_FRAME,            // Wall time begin-to-begin (GPU: the whole command buffer)
+    PROFILE_PHASE_COUNT
+};
+
+static const char* g_profilePhaseNames[PROFILE_PHASE_COUNT] = {
+    "Begin frame", "Cube batches", "Render queue", "Lines", "ImGui", "Submit", "Present", "Frame"
+};
+
+static const uint32_t PROFILE_HISTORY = 240;
+
+struct ProfileFrame {
+    uint64_t frame = 0;  // 0 = empty
+    float cpuMs[PROFILE_PHASE_COUNT] = {};
+    float gpuMs[PROFILE_PHASE_COUNT] = {};
+    uint32_t gpuMask = 0;  // Phases with a GPU result
+};
+
+static bool g_profilerEnabled = true;
+static bool g_profilerOverlay = false;
+static ProfileFrame g_profileHistory[PROFILE_HISTORY];
+static uint64_t g_profileFrame = 0;               // Frame being recorded (1-based)
+static float g_profileCpuMs[PROFILE_PHASE_COUNT];  // Accumulated for the frame being recorded
+static std::chrono::high_resolution_clock::time_point g_profileFrameStart;
+
+// Timestamp queries: two per phase per frame in flight
+static VkQueryPool g_profileQueryPool = VK_NULL_HANDLE;
+static float g_profileTimestampPeriod = 0.0f;  // Nanoseconds per tick
+static uint64_t g_profileTimestampMask = 0;    // timestampValidBits of the graphics queue
+static std::vector<uint64_t> g_profileSlotFrame;  // Frame recorded into each ring slot's queries
+static std::vector<uint32_t> g_profileSlotMask;   // Phases with both timestamps written
+static uint32_t g_profileGpuOpen = 0;              // Phases begun but not yet ended this frame
+
+struct ProfileScope {
+    ProfilePhase phase;
+    std::chrono::high_resolution_clock::time_point start;
+    explicit ProfileScope(ProfilePhase p) : phase(p), start(std::chrono::high_resolution_clock::now()) {}
+    ~ProfileScope() {
+        g_profileCpuMs[phase] += std::chrono::duration<float, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+    }
+};
+
+// Called during init: timestamps need a graphics queue with valid bits
+static void createProfilerQueries() {
+    VkPhysicalDeviceProperties properties;
+    vkGetPhysicalDeviceProperties(g_physicalDevice, &properties);
+    uint32_t familyCount = 0;
+    vkGetPhysicalDeviceQueueFamilyProperties(g_physicalDevice, &familyCount, nullptr);
+    std::vector<VkQueueFamilyProperties> families(familyCount);
+    vkGetPhysicalDeviceQueueFamilyProperties(g_physicalDevice, &familyCount, families.data());
+    uint32_t validBits = g_graphicsQueueFamilyIndex < familyCount ? families[g_graphicsQueueFamilyIndex].timestampValidBits : 0;
+    if (validBits == 0 || properties.limits.timestampPeriod <= 0.0f) {
+        std::cout << "[EDEN] Profiler: no timestamp support on the graphics queue, CPU timings only" << std::endl;
         return;
     }
     
-    VkCommandBuffer cb = g_commandBuffers[g_currentFrame];
-    
-    // Draw Colored Cubes (batched)
-    // This is called at the end of frame to draw any remaining batched cubes
-    // Can also be called mid-frame via heidic_flush_colored_cubes() to flush current batch
-    if (!g_coloredCubeVertices.empty()) {
-        size_t vertexCount = g_coloredCubeVertices.size();
-        size_t bufferSize = sizeof(Vertex) * vertexCount;
-        
-        // Ensure buffer is large enough
-        if (bufferSize > 10 * 1024 * 1024) {
-            // Buffer too large, skip drawing this frame
-            g_coloredCubeVertices.clear();
-        } else {
-            void* data;
-            vkMapMemory(g_device, g_coloredCubeVertexMemory, 0, bufferSize, 0, &data);
-            memcpy(data, g_coloredCubeVertices.data(), bufferSize);
-            vkUnmapMemory(g_device, g_coloredCubeVertexMemory);
-
-            // Bind pipeline and descriptor sets
-            vkCmdBindPipeline(cb, VK_PIPELINE_BIND_POINT_GRAPHICS, g_pipeline);
-            vkCmdBindDescriptorSets(cb, VK_PIPELINE_BIND_POINT_GRAPHICS, g_pipelineLayout, 0, 1, &g_descriptorSets[g_currentFrame], 0, nullptr);
-            
-            // Push Identity Model Matrix (vertices are already transformed)
-            PushConsts push;
-            push.model = glm::mat4(1.0f);
-            vkCmdPushConstants(cb, g_pipelineLayout, VK_SHADER_STAGE_VERTEX_BIT, 0, sizeof(PushConsts), &push);
-
-            VkBuffer vertexBuffers[] = {g_coloredCubeVertexBuffer};
-            VkDeviceSize offsets[] = {0};
-            vkCmdBindVertexBuffers(cb, 0, 1, vertexBuffers, offsets);
-            
-            // Draw all batched cubes (they all use the same texture that was loaded when batch started)
-            vkCmdDraw(cb, static_cast<uint32_t>(vertexCount), 1, 0, 0);
-        }
-        
-        g_coloredCubeVertices.clear();
+    VkQueryPoolCreateInfo poolInfo = {};
+    poolInfo.sType = VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO;
+    poolInfo.queryType = VK_QUERY_TYPE_TIMESTAMP;
+    poolInfo.queryCount = g_maxFramesInFlight * PROFILE_PHASE_COUNT * 2;
+    if (vkCreateQueryPool(g_device, &poolInfo, nullptr, &g_profileQueryPool) != VK_SUCCESS) {
+        g_profileQueryPool = VK_NULL_HANDLE;
+        return;
     }
-    
-    // Ensure default white texture is loaded after drawing textured cubes
-    // This prevents texture color from affecting non-textured geometry drawn after
-    // (like lines, wireframes, etc. that use UVs 0,0)
-    heidic_load_texture_for_rendering("default.bmp");
-    
-    // Draw Lines
-    if (!g_lineVertices.empty()) {
-        void* data;
-        vkMapMemory(g_device, g_lineVertexMemory, 0, sizeof(Vertex) * g_lineVertices.size(), 0, &data);
-        memcpy(data, g_lineVertices.data(), sizeof(Vertex) * g_lineVertices.size());
-        vkUnmapMemory(g_device, g_lineVertexMemory);
+    g_profileTimestampPeriod = properties.limits.timestampPeriod;
+    g_profileTimestampMask = validBits >= 64 ? ~0ull : ((1ull << validBits) - 1);
+    g_profileSlotFrame.assign(g_maxFramesInFlight, 0);
+    g_profileSlotMask.assign(g_maxFramesInFlight, 0);
+}
 
-        vkCmdBindPipeline(cb, VK_PIPELINE_BIND_POINT_GRAPHICS, g_linePipeline);
-        
-        // Bind descriptor set for view/projection matrices (lines need this too)
-        vkCmdBindDescriptorSets(cb, VK_PIPELINE_BIND_POINT_GRAPHICS, g_pipelineLayout, 0, 1, &g_descriptorSets[g_currentFrame], 0, nullptr);
-        
-        // Push Identity Model Matrix for lines
-        PushConsts push;
-        push.model = glm::mat4(1.0f);
-        vkCmdPushConstants(cb, g_pipelineLayout, VK_SHADER_STAGE_VERTEX_BIT, 0, sizeof(PushConsts), &push);
-
-        VkBuffer vertexBuffers[] = {g_lineVertexBuffer};
-        VkDeviceSize offsets[] = {0};
-        vkCmdBindVertexBuffers(cb, 0, 1, vertexBuffers, offsets);
-        
-        vkCmdDraw(cb, static_cast<uint32_t>(g_lineVertices.size()), 1, 0, 0);
+static void destroyProfilerQueries() {
+    if (g_profileQueryPool != VK_NULL_HANDLE) {
+        vkDestroyQueryPool(g_device, g_profileQueryPool, nullptr);
+        g_profileQueryPool = VK_NULL_HANDLE;
     }
+}
 
-    // CRITICAL: Ensure all windows are properly closed before rendering
-    // If there are any windows on the stack that weren't closed, close them now
-    // This prevents ImGui from being in an invalid state when Render() is called
-    while (!g_openWindowsStack.empty()) {
-        std::string windowName = g_openWindowsStack.top();
-        // Silently close windows without warning spam
-        g_openWindowsStack.pop();
-        ImGui::End();
+static uint32_t profileQuery(ProfilePhase phase, bool end) {
+    return (g_currentFrame * PROFILE_PHASE_COUNT + phase) * 2 + (end ? 1 : 0);
+}
+
+// Record a phase boundary into the frame's command buffer (no-op without timestamp support)
+static void profileGpuBegin(VkCommandBuffer cb, ProfilePhase phase) {
+    if (!g_profilerEnabled || g_profileQueryPool == VK_NULL_HANDLE || cb == VK_NULL_HANDLE) return;
+    vkCmdWriteTimestamp(cb, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, g_profileQueryPool, profileQuery(phase, false));
+    g_profileGpuOpen |= 1u << phase;
+}
+
+static void profileGpuEnd(VkCommandBuffer cb, ProfilePhase phase) {
+    if (!(g_profileGpuOpen & (1u << phase))) return;
+    vkCmdWriteTimestamp(cb, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, g_profileQueryPool, profileQuery(phase, true));
+    g_profileGpuOpen &= ~(1u << phase);
+    g_profileSlotMask[g_currentFrame] |= 1u << phase;
+}
+
+// After this slot's fence wait: read the GPU results of the frame recorded into it last time
+static void profileCollectGpu() {
+    if (g_profileQueryPool == VK_NULL_HANDLE || g_currentFrame >= g_profileSlotFrame.size()) return;
+    uint64_t frame = g_profileSlotFrame[g_currentFrame];
+    uint32_t mask = g_profileSlotMask[g_currentFrame];
+    ProfileFrame& entry = g_profileHistory[frame % PROFILE_HISTORY];
+    if (frame != 0 && entry.frame == frame) {
+        for (uint32_t phase = 0; phase < PROFILE_PHASE_COUNT; phase++) {
+            if (!(mask & (1u << phase))) continue;
+            uint64_t ticks[2] = {};
+            VkResult result = vkGetQueryPoolResults(g_device, g_profileQueryPool, profileQuery((ProfilePhase)phase, false), 2,
+                                                    sizeof(ticks), ticks, sizeof(uint64_t), VK_QUERY_RESULT_64_BIT);
+            if (result != VK_SUCCESS) continue;
+            uint64_t delta = ((ticks[1] & g_profileTimestampMask) - (ticks[0] & g_profileTimestampMask)) & g_profileTimestampMask;
+            entry.gpuMs[phase] = (float)((double)delta * g_profileTimestampPeriod / 1.0e6);
+            entry.gpuMask |= 1u << phase;
+        }
+    }
+    g_profileSlotFrame[g_currentFrame] = 0;
+    g_profileSlotMask[g_currentFrame] = 0;
+}
+
+// Start of heidic_begin_frame: store the previous frame's CPU times and start a new frame
+static void profileBeginFrame() {
+    auto now = std::chrono::high_resolution_clock::now();
+    if (g_profileFrame > 0 && g_profilerEnabled) {
+        g_profileCpuMs[PROFILE_FRAME] = std::chrono::duration<float, std::milli>(now - g_profileFrameStart).count();
+        ProfileFrame& entry = g_profileHistory[g_profileFrame % PROFILE_HISTORY];
+        entry = ProfileFrame();
+        entry.frame = g_profileFrame;
+        memcpy(entry.cpuMs, g_profileCpuMs, sizeof(g_profileCpuMs));
+    }
+    g_profileFrame++;
+    g_profileFrameStart = now;
+    memset(g_profileCpuMs, 0, sizeof(g_profileCpuMs));
+    g_profileGpuOpen = 0;
+}
+
+// Once the frame's command buffer has begun: reset this slot's queries and open the frame scope
+static void profileBeginCommandBuffer(VkCommandBuffer cb) {
+    if (!g_profilerEnabled || g_profileQueryPool == VK_NULL_HANDLE) return;
+    vkCmdResetQueryPool(cb, g_profileQueryPool, g_currentFrame * PROFILE_PHASE_COUNT * 2, PROFILE_PHASE_COUNT * 2);
+    g_profileSlotFrame[g_currentFrame] = g_profileFrame;
+    g_profileSlotMask[g_currentFrame] = 0;
+    profileGpuBegin(cb, PROFILE_FRAME);
+}
+
+static const ProfileFrame* profileLatest(bool gpu, ProfilePhase phase) {
+    for (uint32_t back = 1; back <= PROFILE_HISTORY && back < g_profileFrame; back++) {
+        const ProfileFrame& entry = g_profileHistory[(g_profileFrame - back) % PROFILE_HISTORY];
+        if (entry.frame != g_profileFrame - back) break;
+        if (!gpu || (entry.gpuMask & (1u << phase))) return &entry;
+    }
+    return nullptr;
+}
+
+// Percentile (0-100) over the history; -1 when there is no sample
+static float profilePercentile(bool gpu, ProfilePhase phase, float percentile) {
+    std::vector<float> samples;
+    samples.reserve(PROFILE_HISTORY);
+    for (const ProfileFrame& entry : g_profileHistory) {
+        if (entry.frame == 0) continue;
+        if (gpu && !(entry.gpuMask & (1u << phase))) continue;
+        samples.push_back(gpu ? entry.gpuMs[phase] : entry.cpuMs[phase]);
+    }
+    if (samples.empty()) return -1.0f;
+    float clamped = std::min(std::max(percentile, 0.0f), 100.0f);
+    size_t rank = (size_t)std::ceil(clamped / 100.0f * samples.size());
+    size_t index = rank > 0 ? rank - 1 : 0;
+    std::nth_element(samples.begin(), samples.begin() + index, samples.end());
+    return samples[index];
+}
+
+static void drawProfilerOverlay() {
+    ImGui::SetNextWindowPos(ImVec2(10.0f, 30.0f), ImGuiCond_FirstUseEver);
+    ImGui::SetNextWindowBgAlpha(0.8f);
+    if (!ImGui::Begin("Profiler", &g_profilerOverlay, ImGuiWindowFlags_AlwaysAutoResize | ImGuiWindowFlags_NoFocusOnAppearing)) {
+        ImGui::End();
+        return;
+    }
+    ImGui::Text("Last %u frames, ms%s", PROFILE_HISTORY, g_profileQueryPool == VK_NULL_HANDLE ? " (no GPU timestamps)" : "");
+    if (ImGui::BeginTable("profile", 9, ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg | ImGuiTableFlags_SizingFixedFit)) {
+        const char* headers[9] = {"Phase", "CPU", "p50", "p95", "p99", "GPU", "p50", "p95", "p99"};
+        for (const char* header : headers) ImGui::TableSetupColumn(header);
+        ImGui::TableHeadersRow();
+        for (uint32_t phase = 0; phase < PROFILE_PHASE_COUNT; phase++) {
+            ImGui::TableNextRow();
+            ImGui::TableNextColumn();
+            ImGui::TextUnformatted(g_profilePhaseNames[phase]);
+            for (int gpu = 0; gpu < 2; gpu++) {
+                const ProfileFrame* latest = profileLatest(gpu != 0, (ProfilePhase)phase);
+                ImGui::TableNextColumn();
+                if (latest) ImGui::Text("%.3f", gpu ? latest->gpuMs[phase] : latest->cpuMs[phase]);
+                else ImGui::TextDisabled("-");
+                const float percentiles[3] = {50.0f, 95.0f, 99.0f};
+                for (float percentile : percentiles) {
+                    float value = profilePercentile(gpu != 0, (ProfilePhase)phase, percentile);
+                    ImGui::TableNextColumn();
+                    if (value >= 0.0f) ImGui::Text("%.3f", value);
+                    else ImGui::TextDisabled("-");
+                }
+            }
+        }
+        ImGui::EndTable();
+    }
+    ImGui::End();
+}
+
+// Turn phase timing on/off (GPU timestamps are only recorded while enabled)
+extern "C" void heidic_set_profiler_enabled(int enabled) {
+    g_profilerEnabled = enabled != 0;
+}
+
+extern "C" void heidic_set_profiler_overlay(int visible) {
+    g_profilerOverlay = visible != 0;
+}
+
+extern "C" int heidic_get_profile_phase_count() {
+    return PROFILE_PHASE_COUNT;
+}
+
+extern "C" const char* heidic_get_profile_phase_name(int phase) {
+    if (phase < 0 || phase >= PROFILE_PHASE_COUNT) return "";
+    return g_profilePhaseNames[phase];
+}
+
+// Last completed frame (CPU) / last frame with a GPU result; -1 if there is none yet
+extern "C" float heidic_get_profile_cpu_ms(int phase) {
+    if (phase < 0 || phase >= PROFILE_PHASE_COUNT) return -1.0f;
+    const ProfileFrame* latest = profileLatest(false, (ProfilePhase)phase);
+    return latest ? latest->cpuMs[phase] : -1.0f;
+}
+
+extern "C" float heidic_get_profile_gpu_ms(int phase) {
+    if (phase < 0 || phase >= PROFILE_PHASE_COUNT) return -1.0f;
+    const ProfileFrame* latest = profileLatest(true, (ProfilePhase)phase);
+    return latest ? latest->gpuMs[phase] : -1.0f;
+}
+
+// Rolling percentile (e.g. 50, 95, 99) over the last PROFILE_HISTORY frames
+extern "C" float heidic_get_profile_cpu_percentile(int phase, float percentile) {
+    if (phase < 0 || phase >= PROFILE_PHASE_COUNT) return -1.0f;
+    return profilePercentile(false, (ProfilePhase)phase, percentile);
+}
+
+extern "C" float heidic_get_profile_gpu_percentile(int phase, float percentile) {
+    if (phase < 0 || phase >= PROFILE_PHASE_COUNT) return -1.0f;
+    return profilePercentile(true, (ProfilePhase)phase, percentile);
+}
+
+// ============================================================================
+// DEFERRED RENDER QUEUE
+// ============================================================================
+// heidic_draw_* calls record DrawPackets instead of touching the command buffer. heidic_end_frame()
+// sorts them by a 64-bit key and records them, skipping binds that match the current state.
+// Key layout (high to low): pipeline (8 bits) | texture (16) | mesh (16) | depth (24, front to back).
+// Pipeline/texture/mesh ids are interned per frame in first-use order; the line pipeline always
+// sorts last because it draws without depth testing.
+
+struct DrawPacket {
+    uint64_t sortKey;
+    VkPipeline pipeline;
+    VkPipelineLayout layout;
+    VkDescriptorSet sets[2];  // sets[1] is the bindless texture table (bindless pipelines only)
+    uint32_t setCount;
+    VkBuffer vertexBuffers[2];  // [1] = instance buffer for instanced pipelines
+    VkDeviceSize vertexOffsets[2];
+    uint32_t vertexBufferCount;
+    VkBuffer indexBuffer;  // VK_NULL_HANDLE = non-indexed draw of vertexCount vertices
+    uint32_t indexCount;
+    uint32_t vertexCount;
+    uint32_t instanceCount;
+    glm::mat4 model;
+    bool hasBounds;  // World AABB for frustum culling (false = always drawn)
+    glm::vec3 boundsCenter;
+    glm::vec3 boundsExtent;
+};
+
+struct RenderQueueStats {
+    uint32_t packets = 0;
+    uint32_t drawCalls = 0;
+    uint32_t pipelineBinds = 0;
+    uint32_t descriptorBinds = 0;
+    uint32_t vertexBufferBinds = 0;
+    uint32_t pushConstants = 0;
+    uint32_t instances = 0;
+};
+
+static std::vector<DrawPacket> g_renderQueue;
+static std::map<uint64_t, uint32_t> g_sortIdPipelines;  // Per-frame interning of handles to key fields
+static std::map<uint64_t, uint32_t> g_sortIdTextures;
+static std::map<uint64_t, uint32_t> g_sortIdMeshes;
+static RenderQueueStats g_renderStats;  // Stats of the last submitted frame
+static bool g_renderQueueSortEnabled = true;
+static float g_currentFarPlane = 5000.0f;  // For depth quantisation in sort keys
+
+static uint32_t internSortId(std::map<uint64_t, uint32_t>& ids, uint64_t handle, uint32_t maxId) {
+    auto it = ids.find(handle);
+    if (it != ids.end()) return it->second;
+    uint32_t id = std::min(static_cast<uint32_t>(ids.size()), maxId);
+    ids[handle] = id;
+    return id;
+}
+
+// Build the sort key and append the packet to this frame's queue
+static void queueDrawPacket(DrawPacket& packet, uint64_t meshHandle, bool hasDepth) {
+    uint32_t pipelineId = (packet.pipeline == g_linePipeline) ? 0xFFu : internSortId(g_sortIdPipelines, (uint64_t)packet.pipeline, 0xFEu);
+    VkDescriptorSet textureSet = packet.setCount > 1 ? packet.sets[1] : packet.sets[0];
+    uint32_t textureId = internSortId(g_sortIdTextures, (uint64_t)textureSet, 0xFFFFu);
+    uint32_t meshId = internSortId(g_sortIdMeshes, meshHandle, 0xFFFFu);
+    
+    uint32_t depthBits = 0;
+    if (hasDepth) {
+        glm::vec3 worldPos = glm::vec3(packet.model[3]);
+        float depth = glm::length(worldPos - g_currentCamPos) / g_currentFarPlane;
+        depth = std::min(std::max(depth, 0.0f), 1.0f);
+        depthBits = static_cast<uint32_t>(depth * 16777215.0f);  // 24 bits, near first (less overdraw)
+    }
+    
+    packet.sortKey = (static_cast<uint64_t>(pipelineId) << 56) |
+                     (static_cast<uint64_t>(textureId) << 40) |
+                     (static_cast<uint64_t>(meshId) << 24) |
+                     static_cast<uint64_t>(depthBits);
+    g_renderQueue.push_back(packet);
+}
+
+// Queue a single non-instanced draw with g_pipeline / g_pipelineLayout. localCenter/localExtent
+// bound the geometry in model space (culled at submission).
+static void queueMeshDraw(VkBuffer vertexBuffer, uint32_t vertexCount, VkDescriptorSet set, const glm::mat4& model,
+                          const glm::vec3& localCenter, const glm::vec3& localExtent) {
+    DrawPacket packet = {};
+    packet.pipeline = g_pipeline;
+    packet.layout = g_pipelineLayout;
+    packet.sets[0] = set;
+    packet.setCount = 1;
+    packet.vertexBuffers[0] = vertexBuffer;
+    packet.vertexBufferCount = 1;
+    packet.vertexCount = vertexCount;
+    packet.instanceCount = 1;
+    packet.model = model;
+    packet.hasBounds = true;
+    transformAabb(model, localCenter, localExtent, packet.boundsCenter, packet.boundsExtent);
+    queueDrawPacket(packet, (uint64_t)vertexBuffer, true);
+}
+
+// Queue a single indexed draw (32-bit indices) with a g_pipelineLayout pipeline
+static void queueIndexedMeshDraw(VkPipeline pipeline, VkBuffer vertexBuffer, VkBuffer indexBuffer, uint32_t indexCount, VkDescriptorSet set, const glm::mat4& model,
+                                 const glm::vec3& worldCenter, const glm::vec3& worldExtent) {
+    DrawPacket packet = {};
+    packet.pipeline = pipeline;
+    packet.layout = g_pipelineLayout;
+    packet.sets[0] = set;
+    packet.setCount = 1;
+    packet.vertexBuffers[0] = vertexBuffer;
+    packet.vertexBufferCount = 1;
+    packet.indexBuffer = indexBuffer;
+    packet.indexCount = indexCount;
+    packet.instanceCount = 1;
+    packet.model = model;
+    packet.hasBounds = true;
+    packet.boundsCenter = worldCenter;
+    packet.boundsExtent = worldExtent;
+    queueDrawPacket(packet, (uint64_t)vertexBuffer, true);
+}
+
+static AabbSoA g_cullBoxes;  // Scratch for culling queued packets / instances
+static std::vector<uint8_t> g_cullVisible;
+static std::vector<size_t> g_cullIndices;
+
+// Drop queued packets whose bounds are outside the frustum
+static void cullRenderQueue() {
+    g_cullBoxes.clear();
+    g_cullIndices.clear();
+    for (size_t i = 0; i < g_renderQueue.size(); i++) {
+        if (!g_renderQueue[i].hasBounds) continue;
+        g_cullBoxes.push(g_renderQueue[i].boundsCenter, g_renderQueue[i].boundsExtent);
+        g_cullIndices.push_back(i);
+    }
+    if (g_cullBoxes.size() == 0) return;
+    if (cullAabbs(g_cullBoxes, g_cullVisible) == g_cullBoxes.size()) return;
+    
+    for (size_t k = 0; k < g_cullIndices.size(); k++) {
+        if (!g_cullVisible[k]) g_renderQueue[g_cullIndices[k]].instanceCount = 0;  // Mark culled
+    }
+    g_renderQueue.erase(std::remove_if(g_renderQueue.begin(), g_renderQueue.end(),
+                                       [](const DrawPacket& packet) { return packet.instanceCount == 0; }),
+                        g_renderQueue.end());
+}
+
+// Sort (unless disabled) and record the frame's packets, eliminating redundant state changes.
+// cb == VK_NULL_HANDLE (null backend): the same state tracking and statistics, nothing is recorded
+static void submitRenderQueue(VkCommandBuffer cb) {
+    ProfileScope profile(PROFILE_RENDER_QUEUE);
+    bool record = cb != VK_NULL_HANDLE;
+    RenderQueueStats stats;
+    stats.packets = static_cast<uint32_t>(g_renderQueue.size());
+    cullRenderQueue();
+    
+    if (g_renderQueueSortEnabled) {
+        std::stable_sort(g_renderQueue.begin(), g_renderQueue.end(),
+                         [](const DrawPacket& a, const DrawPacket& b) { return a.sortKey < b.sortKey; });
+    }
+    
+    VkPipeline boundPipeline = VK_NULL_HANDLE;
+    VkPipelineLayout boundSetLayout = VK_NULL_HANDLE;
+    VkDescriptorSet boundSets[2] = {VK_NULL_HANDLE, VK_NULL_HANDLE};
+    VkBuffer boundBuffers[2] = {VK_NULL_HANDLE, VK_NULL_HANDLE};
+    VkDeviceSize boundOffsets[2] = {0, 0};
+    VkBuffer boundIndexBuffer = VK_NULL_HANDLE;
+    bool havePush = false;
+    glm::mat4 boundModel(1.0f);
+    
+    // GPU time is split where the line packets (sorted last) start
+    profileGpuBegin(cb, PROFILE_RENDER_QUEUE);
+    for (const DrawPacket& packet : g_renderQueue) {
+        if (packet.pipeline == g_linePipeline && packet.pipeline != boundPipeline) {
+            profileGpuEnd(cb, PROFILE_RENDER_QUEUE);
+            profileGpuBegin(cb, PROFILE_LINES);
+        }
+        if (packet.pipeline != boundPipeline) {
+            if (record) vkCmdBindPipeline(cb, VK_PIPELINE_BIND_POINT_GRAPHICS, packet.pipeline);
+            boundPipeline = packet.pipeline;
+            stats.pipelineBinds++;
+        }
+        // Both pipeline layouts share the push constant range, so push constants stay valid across
+        // layout switches. Descriptor sets are rebound whenever the layout changes, since set 1
+        // only exists in the bindless layout.
+        bool setsDirty = packet.layout != boundSetLayout;
+        for (uint32_t i = 0; i < packet.setCount; i++) {
+            if (packet.sets[i] != boundSets[i]) setsDirty = true;
+        }
+        if (setsDirty) {
+            if (record) vkCmdBindDescriptorSets(cb, VK_PIPELINE_BIND_POINT_GRAPHICS, packet.layout, 0, packet.setCount, packet.sets, 0, nullptr);
+            for (uint32_t i = 0; i < 2; i++) boundSets[i] = (i < packet.setCount) ? packet.sets[i] : VK_NULL_HANDLE;
+            boundSetLayout = packet.layout;
+            stats.descriptorBinds++;
+        }
+        if (!havePush || memcmp(&boundModel, &packet.model, sizeof(glm::mat4)) != 0) {
+            PushConsts push = {packet.model};
+            if (record) vkCmdPushConstants(cb, packet.layout, VK_SHADER_STAGE_VERTEX_BIT, 0, sizeof(PushConsts), &push);
+            boundModel = packet.model;
+            havePush = true;
+            stats.pushConstants++;
+        }
+        bool buffersDirty = false;
+        for (uint32_t i = 0; i < packet.vertexBufferCount; i++) {
+            if (packet.vertexBuffers[i] != boundBuffers[i] || packet.vertexOffsets[i] != boundOffsets[i]) buffersDirty = true;
+        }
+        if (buffersDirty) {
+            if (record) vkCmdBindVertexBuffers(cb, 0, packet.vertexBufferCount, packet.vertexBuffers, packet.vertexOffsets);
+            for (uint32_t i = 0; i < packet.vertexBufferCount; i++) {
+                boundBuffers[i] = packet.vertexBuffers[i];
+                boundOffsets[i] = packet.vertexOffsets[i];
+            }
+            stats.vertexBufferBinds++;
+        }
+        if (packet.indexBuffer != VK_NULL_HANDLE) {
+            if (packet.indexBuffer != boundIndexBuffer) {
+                if (record) vkCmdBindIndexBuffer(cb, packet.indexBuffer, 0, VK_INDEX_TYPE_UINT32);
+                boundIndexBuffer = packet.indexBuffer;
+            }
+            if (record) vkCmdDrawIndexed(cb, packet.indexCount, packet.instanceCount, 0, 0, 0);
+        } else if (record) {
+            vkCmdDraw(cb, packet.vertexCount, packet.instanceCount, 0, 0);
+        }
+        stats.drawCalls++;
+        stats.instances += packet.instanceCount;
+    }
+    profileGpuEnd(cb, PROFILE_RENDER_QUEUE);
+    profileGpuEnd(cb, PROFILE_LINES);
+    
+    g_renderStats = stats;
+    g_renderQueue.clear();
+    g_sortIdPipelines.clear();
+    g_sortIdTextures.clear();
+    g_sortIdMeshes.clear();
+}
+
+extern "C" int heidic_get_render_packet_count() { return static_cast<int>(g_renderStats.packets); }
+extern "C" int heidic_get_render_draw_calls() { return static_cast<int>(g_renderStats.drawCalls); }
+extern "C" int heidic_get_render_pipeline_binds() { return static_cast<int>(g_renderStats.pipelineBinds); }
+extern "C" int heidic_get_render_descriptor_binds() { return static_cast<int>(g_renderStats.descriptorBinds); }
+extern "C" int heidic_get_render_vertex_buffer_binds() { return static_cast<int>(g_renderStats.vertexBufferBinds); }
+extern "C" int heidic_get_render_instance_count() { return static_cast<int>(g_renderStats.instances); }
+extern "C" void heidic_set_render_queue_sorting(int enabled) { g_renderQueueSortEnabled = (enabled != 0); }
+
+// Queue the pending colored cube batch with the given descriptor set and clear it.
+// Instances go through the instanced pipeline (unit cube at binding 0, instances at binding 1);
+// CPU-transformed vertices are only produced when that pipeline is unavailable.
+static void queueColoredCubeBatch(VkDescriptorSet set) {
+    ProfileScope profile(PROFILE_CUBE_BATCH);
+    bool bindless = g_cubeBindlessPipeline != VK_NULL_HANDLE;
+    VkPipeline instancePipeline = bindless ? g_cubeBindlessPipeline : g_cubeInstancedPipeline;
+    
+    // Cull instances before they are uploaded. Bounds are the cube's bounding sphere, which
+    // covers any rotation without building the rotation matrix.
+    if (!g_coloredCubeInstances.empty()) {
+        g_cullBoxes.clear();
+        for (const CubeInstance& inst : g_coloredCubeInstances) {
+            float radius = 0.5f * glm::length(glm::vec3(inst.scale[0], inst.scale[1], inst.scale[2]));
+            g_cullBoxes.push(glm::vec3(inst.pos[0], inst.pos[1], inst.pos[2]), glm::vec3(radius));
+        }
+        if (cullAabbs(g_cullBoxes, g_cullVisible) != g_coloredCubeInstances.size()) {
+            size_t kept = 0;
+            for (size_t i = 0; i < g_coloredCubeInstances.size(); i++) {
+                if (g_cullVisible[i]) g_coloredCubeInstances[kept++] = g_coloredCubeInstances[i];
+            }
+            g_coloredCubeInstances.resize(kept);
+        }
+    }
+    
+    if (!g_coloredCubeInstances.empty() && instancePipeline != VK_NULL_HANDLE) {
+        VkBuffer instanceBuffer = VK_NULL_HANDLE;
+        VkDeviceSize instanceOffset = 0;
+        if (uploadTransientData(g_coloredCubeInstances.data(), sizeof(CubeInstance) * g_coloredCubeInstances.size(), instanceBuffer, instanceOffset)) {
+            DrawPacket packet = {};
+            packet.pipeline = instancePipeline;
+            if (bindless) {
+                // Set 0 = per-frame UBO, set 1 = texture table (instances index it by slot)
+                packet.layout = g_bindlessPipelineLayout;
+                packet.sets[0] = g_descriptorSets[g_currentFrame];
+                packet.sets[1] = g_bindlessDescriptorSet;
+                packet.setCount = 2;
+            } else {
+                packet.layout = g_pipelineLayout;
+                packet.sets[0] = set;
+                packet.setCount = 1;
+            }
+            packet.vertexBuffers[0] = g_cubeVertexBuffer;
+            packet.vertexBuffers[1] = instanceBuffer;
+            packet.vertexOffsets[1] = instanceOffset;
+            packet.vertexBufferCount = 2;
+            packet.vertexCount = g_cubeVertexCount;
+            packet.instanceCount = static_cast<uint32_t>(g_coloredCubeInstances.size());
+            packet.model = glm::mat4(1.0f);  // Identity - instances carry their own transform
+            queueDrawPacket(packet, (uint64_t)g_cubeVertexBuffer, false);
+        }
+    }
+    
+    VkBuffer ringBuffer = VK_NULL_HANDLE;
+    VkDeviceSize ringOffset = 0;
+    if (!g_coloredCubeVertices.empty() &&
+        uploadTransientVertices(g_coloredCubeVertices.data(), g_coloredCubeVertices.size(), ringBuffer, ringOffset)) {
+        DrawPacket packet = {};
+        packet.pipeline = g_pipeline;
+        packet.layout = g_pipelineLayout;
+        packet.sets[0] = set;
+        packet.setCount = 1;
+        packet.vertexBuffers[0] = ringBuffer;
+        packet.vertexOffsets[0] = ringOffset;
+        packet.vertexBufferCount = 1;
+        packet.vertexCount = static_cast<uint32_t>(g_coloredCubeVertices.size());
+        packet.instanceCount = 1;
+        packet.model = glm::mat4(1.0f);  // Identity - vertices are already in world space
+        queueDrawPacket(packet, (uint64_t)ringBuffer, false);
+    }
+    
+    g_coloredCubeInstances.clear();
+    g_coloredCubeVertices.clear();
+}
+
+// FRAME CONTROL
+static uint32_t g_frameCounter = 0;  // Track frame number for debugging
+
+// Submit Serials
+// g_frameCounter also counts frames that returned early (swapchain out of date) without submitting,
+// so GPU lifetimes are tracked by submission instead. Every frame submit gets the next serial and
+// its ring slot remembers it; once heidic_begin_frame has waited on a slot's fence, that serial and
+// every earlier one are complete (a fence covers all prior submissions to the queue).
+static uint64_t g_submitSerial = 0;     // Serial of the last frame submit
+static uint64_t g_completedSerial = 0;  // Every submit up to this one has finished on the GPU
+static std::vector<uint64_t> g_slotSubmitSerial;  // Per ring slot: serial its fence signals
+
+// Serial of the next frame submit - the earliest one that can no longer see anything released now
+static uint64_t nextSubmitSerial() {
+    return g_submitSerial + 1;
+}
+
+static void noteFrameSubmitted() {
+    if (g_slotSubmitSerial.size() < g_maxFramesInFlight) g_slotSubmitSerial.resize(g_maxFramesInFlight, 0);
+    g_slotSubmitSerial[g_currentFrame] = ++g_submitSerial;
+}
+
+// Called once the current slot's fence has been waited on
+static void noteFrameFenceWaited() {
+    if (g_currentFrame < g_slotSubmitSerial.size()) {
+        g_completedSerial = std::max(g_completedSerial, g_slotSubmitSerial[g_currentFrame]);
+    }
+}
+
+// Deferred Buffer Destruction
+// Long-lived buffers that get replaced (e.g. rebuilt static geometry) may still be referenced by
+// frames in flight or by packets queued this frame. They are parked here with the serial of the
+// next frame submit and destroyed once that submit is known to have completed.
+struct RetiredBuffer {
+    VkBuffer buffer;
+    GpuAllocation memory;
+    uint64_t lastSerial;
+};
+static std::vector<RetiredBuffer> g_retiredBuffers;
+
+static void retireBuffer(VkBuffer buffer, GpuAllocation memory) {
+    if (buffer == VK_NULL_HANDLE && memory.block < 0) return;
+    g_retiredBuffers.push_back({buffer, memory, nextSubmitSerial()});
+}
+
+// Called after the current slot's fence wait
+static void collectRetiredBuffers() {
+    size_t kept = 0;
+    for (size_t i = 0; i < g_retiredBuffers.size(); i++) {
+        RetiredBuffer& retired = g_retiredBuffers[i];
+        if (retired.lastSerial <= g_completedSerial) {
+            if (retired.buffer != VK_NULL_HANDLE && !g_nullRenderer) vkDestroyBuffer(g_device, retired.buffer, nullptr);
+            freeGpuMemory(retired.memory);
+        } else {
+            g_retiredBuffers[kept++] = retired;
+        }
+    }
+    g_retiredBuffers.resize(kept);
+}
+
+extern "C" void heidic_begin_frame() {
+    g_frameCounter++;
+    profileBeginFrame();
+    ProfileScope profile(PROFILE_BEGIN_FRAME);
+    
+    auto frameBegin = std::chrono::high_resolution_clock::now();
+    double deltaMs = g_frameCounter > 1 ? std::chrono::duration<double, std::milli>(frameBegin - g_lastFrameBegin).count() : 0.0;
+    g_frameTimeMs = deltaMs;
+    g_lastFrameBegin = frameBegin;
+    
+    // CRITICAL: Clear the begun windows set at the VERY START of each frame
+    // This MUST happen before any ImGui calls to prevent duplicate Begin() calls
+    g_begunWindowsThisFrame.clear();
+    g_windowsThatActuallyBegan.clear();
+    // Clear the open windows stack - any remaining windows from previous frame are invalid
+    while (!g_openWindowsStack.empty()) {
+        g_openWindowsStack.pop();
+    }
+    
+    // Frame counter for debugging (commented out to reduce log spam)
+    // std::cout << "[DEBUG] heidic_begin_frame: Frame #" << g_frameCounter << " - Cleared window tracking sets" << std::endl;
+    
+    // Start ImGui Frame
+    if (!g_nullRenderer) ImGui_ImplVulkan_NewFrame();
+    if (g_headless || g_nullRenderer) {
+        ImGuiIO& io = ImGui::GetIO();
+        io.DisplaySize = ImVec2((float)g_swapchainExtent.width, (float)g_swapchainExtent.height);
+        io.DeltaTime = deltaMs > 0.0 ? (float)(deltaMs / 1000.0) : 1.0f / 60.0f;
+    } else {
+        ImGui_ImplGlfw_NewFrame();
+    }
+    ImGui::NewFrame();
+    
+    // Process pending combination editing start (deferred from previous frame to avoid same-frame conflicts)
+    if (g_pendingStartEditingId >= 0) {
+        g_editingCombinationId = g_pendingStartEditingId;
+        g_pendingStartEditingId = -1;
+        // Initialize buffer with current name
+        const char* current_name = heidic_format_combination_name(g_editingCombinationId);
+        strncpy(g_combinationNameBuffer, current_name, sizeof(g_combinationNameBuffer) - 1);
+        g_combinationNameBuffer[sizeof(g_combinationNameBuffer) - 1] = '\0';
+    }
+
+    // Clear lines for this frame
+    g_lineVertices.clear();
+    g_coloredCubeVertices.clear();
+    g_coloredCubeInstances.clear();
+    
+    // NOTE: Window tracking sets are now cleared at the VERY START of heidic_begin_frame()
+    // (moved above to ensure they're cleared before any ImGui calls)
+    
+    if (g_nullRenderer) {
+        // No device: nothing to wait for, acquire or record into
+        if (g_currentFrame < g_transientRings.size()) {
+            resetTransientRing(g_transientRings[g_currentFrame]);
+        }
+        g_completedSerial = g_submitSerial;
+        collectRetiredBuffers();
+        g_currentImageIndex = g_currentFrame;
+        g_commandBufferStarted = true;
+        g_renderQueue.clear();
+        return;
+    }
+
+    // CRITICAL: Wait for this ring slot's fence so the command buffer, UBO and transient buffers
+    // it owns are no longer in use. Only the frame submitted g_maxFramesInFlight frames ago is
+    // waited on, so the CPU can record this frame while the GPU is still drawing the previous one.
+    VkFence frameFence = g_inFlightFences[g_currentFrame];
+    vkWaitForFences(g_device, 1, &frameFence, VK_TRUE, UINT64_MAX);
+    noteFrameFenceWaited();
+    profileCollectGpu();
+    
+    // The GPU is done with this slot's transient vertices - rewind its ring
+    if (g_currentFrame < g_transientRings.size()) {
+        resetTransientRing(g_transientRings[g_currentFrame]);
+    }
+    collectRetiredBuffers();
+    collectUploads();
+    pumpTextureStreaming();
+    evictTextures();
+    
+    uint32_t imageIndex;
+    if (g_headless) {
+        // One offscreen image per ring slot - the fence waited on above already covers its reuse
+        imageIndex = g_currentFrame;
+    } else {
+        // Acquire next image with this frame's semaphore - it is consumed by this frame's submit
+        VkResult result = vkAcquireNextImageKHR(g_device, g_swapchain, UINT64_MAX, 
+                                                 g_imageAvailableSemaphores[g_currentFrame],
+                                                 VK_NULL_HANDLE,  // No fence
+                                                 &imageIndex);
+        
+        if (result == VK_ERROR_OUT_OF_DATE_KHR || result == VK_SUBOPTIMAL_KHR) {
+            g_commandBufferStarted = false;  // Command buffer not started due to early return
+            return;
+        }
+    }
+    
+    // The swapchain may hand back an image that an older ring slot is still rendering to
+    // (image count and frames in flight differ), so wait for that slot too
+    if (g_imagesInFlight[imageIndex] != VK_NULL_HANDLE && g_imagesInFlight[imageIndex] != frameFence) {
+        vkWaitForFences(g_device, 1, &g_imagesInFlight[imageIndex], VK_TRUE, UINT64_MAX);
+    }
+    g_imagesInFlight[imageIndex] = frameFence;
+    g_currentImageIndex = imageIndex;
+    
+    // Only reset the fence once we know this frame will be submitted
+    vkResetFences(g_device, 1, &frameFence);
+    
+    // Upload the latest camera matrices into this frame's UBO (the camera may have been
+    // updated before heidic_begin_frame, while this slot's buffer was still in use)
+    UniformBufferObject ubo = {};
+    ubo.view = g_currentView;
+    ubo.proj = g_currentProj;
+    memcpy(g_uniformBuffersMemory[g_currentFrame].mapped, &ubo, sizeof(UniformBufferObject));
+    
+    // Now reset the command buffer for this frame (safe because we waited for the fence above)
+    vkResetCommandBuffer(g_commandBuffers[g_currentFrame], 0);
+    
+    VkCommandBuffer cb = g_commandBuffers[g_currentFrame];
+    VkCommandBufferBeginInfo beginInfo = {VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO};
+    VkResult beginResult = vkBeginCommandBuffer(cb, &beginInfo);
+    if (beginResult != VK_SUCCESS) {
+        g_commandBufferStarted = false;
+        return;  // Failed to start command buffer
+    }
+    g_commandBufferStarted = true;  // Mark that command buffer was successfully started
+    profileBeginCommandBuffer(cb);
+    
+    VkRenderPassBeginInfo renderPassInfo = {};
+    renderPassInfo.sType = VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO;
+    renderPassInfo.renderPass = g_renderPass;
+    renderPassInfo.framebuffer = g_framebuffers[g_currentImageIndex];
+    renderPassInfo.renderArea.offset = {0, 0};
+    renderPassInfo.renderArea.extent = g_swapchainExtent;
+    
+    VkClearValue clearValues[2];
+    clearValues[0].color = {{0.0f, 0.0f, 0.0f, 1.0f}};
+    clearValues[1].depthStencil = {1.0f, 0};
+    renderPassInfo.clearValueCount = 2;
+    renderPassInfo.pClearValues = clearValues;
+    
+    vkCmdBeginRenderPass(cb, &renderPassInfo, VK_SUBPASS_CONTENTS_INLINE);
+    
+    // Pipeline/descriptor/vertex buffer binds are recorded by submitRenderQueue() in heidic_end_frame()
+    g_renderQueue.clear();
+}
+
+extern "C" void heidic_end_frame() {
+    // If command buffer wasn't started this frame, don't try to record commands
+    if (!g_commandBufferStarted) {
+        return;
+    }
+    
+    auto endFrameStart = std::chrono::high_resolution_clock::now();
+    VkCommandBuffer cb = g_nullRenderer ? VK_NULL_HANDLE : g_commandBuffers[g_currentFrame];
+    
+    // Queue Colored Cubes (batched)
+    // This is called at the end of frame to queue any remaining batched cubes
+    // Can also be called mid-frame via heidic_flush_colored_cubes() to flush current batch
+    if (!g_coloredCubeVertices.empty() || !g_coloredCubeInstances.empty()) {
+        queueColoredCubeBatch(currentTextureDescriptorSet());
+    }
+    
+    // Ensure default white texture is loaded after drawing textured cubes
+    // This prevents texture color from affecting non-textured geometry drawn after
+    // (like lines, wireframes, etc. that use UVs 0,0)
+    heidic_load_texture_for_rendering("default.bmp");
+    
+    // Draw Lines
+    {
+        ProfileScope profile(PROFILE_LINES);
+        VkBuffer lineBuffer = VK_NULL_HANDLE;
+        VkDeviceSize lineOffset = 0;
+        if (!g_lineVertices.empty() && uploadTransientVertices(g_lineVertices.data(), g_lineVertices.size(), lineBuffer, lineOffset)) {
+            DrawPacket packet = {};
+            packet.pipeline = g_linePipeline;
+            packet.layout = g_pipelineLayout;
+            packet.sets[0] = g_descriptorSets[g_currentFrame];  // View/projection (lines use vertex colors)
+            packet.setCount = 1;
+            packet.vertexBuffers[0] = lineBuffer;
+            packet.vertexOffsets[0] = lineOffset;
+            packet.vertexBufferCount = 1;
+            packet.vertexCount = static_cast<uint32_t>(g_lineVertices.size());
+            packet.instanceCount = 1;
+            packet.model = glm::mat4(1.0f);
+            queueDrawPacket(packet, (uint64_t)lineBuffer, false);
+        }
+    }
+    
+    // Cull, sort and record everything queued this frame
+    submitRenderQueue(cb);
+    g_cullStats = g_cullStatsFrame;
+    g_cullStatsFrame = CullStats();
+
+    // CRITICAL: Ensure all windows are properly closed before rendering
+    // If there are any windows on the stack that weren't closed, close them now
+    // This prevents ImGui from being in an invalid state when Render() is called
+    while (!g_openWindowsStack.empty()) {
+        std::string windowName = g_openWindowsStack.top();
+        // Silently close windows without warning spam
+        g_openWindowsStack.pop();
+        ImGui::End();
+    }
+    
+    if (g_profilerOverlay) {
+        drawProfilerOverlay();
     }
     
     // Render ImGui
-    ImGui::Render();
-    ImGui_ImplVulkan_RenderDrawData(ImGui::GetDrawData(), cb);
+    {
+        ProfileScope profile(PROFILE_IMGUI);
+        ImGui::Render();
+        if (!g_nullRenderer) {
+            profileGpuBegin(cb, PROFILE_IMGUI);
+            ImGui_ImplVulkan_RenderDrawData(ImGui::GetDrawData(), cb);
+            profileGpuEnd(cb, PROFILE_IMGUI);
+        }
+    }
+    if (g_nullRenderer) {
+        // Draw lists are built, there is nothing to record them into
+        g_commandBufferStarted = false;
+        g_endFrameCpuMs = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - endFrameStart).count();
+        g_nullTotals.frames++;
+        g_nullTotals.frameMs += g_frameTimeMs;
+        g_nullTotals.endFrameCpuMs += g_endFrameCpuMs;
+        g_nullTotals.packets += g_renderStats.packets;
+        g_nullTotals.drawCalls += g_renderStats.drawCalls;
+        g_nullTotals.instances += g_renderStats.instances;
+        noteFrameSubmitted();
+        g_currentFrame = (g_currentFrame + 1) % g_maxFramesInFlight;
+        return;
+    }
     
     vkCmdEndRenderPass(cb);
+    profileGpuEnd(cb, PROFILE_FRAME);
     VkResult endResult = vkEndCommandBuffer(cb);
     if (endResult != VK_SUCCESS) {
         g_commandBufferStarted = false;
@@ -1815,22 +3974,37 @@ extern "C" void heidic_end_frame() {
     
     VkSubmitInfo submitInfo = {};
     submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
-    // Wait for image acquisition semaphore (we used semaphore[0] for acquire)
+    // Wait for this frame's image acquisition semaphore
     // This ensures the image is ready before we start rendering
-    VkSemaphore waitSemaphores[] = {g_imageAvailableSemaphores[0]};
+    VkSemaphore waitSemaphores[] = {g_imageAvailableSemaphores[g_currentFrame]};
     VkPipelineStageFlags waitStages[] = {VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT};
-    submitInfo.waitSemaphoreCount = 1;
+    submitInfo.waitSemaphoreCount = g_headless ? 0 : 1;  // Nothing is acquired when headless
     submitInfo.pWaitSemaphores = waitSemaphores;
     submitInfo.pWaitDstStageMask = waitStages;
     submitInfo.commandBufferCount = 1;
     submitInfo.pCommandBuffers = &cb;
-    // Signal the render-finished semaphore for the current frame
-    VkSemaphore signalSemaphores[] = {g_renderFinishedSemaphores[g_currentFrame]};
-    submitInfo.signalSemaphoreCount = 1;
+    // Signal the render-finished semaphore for the acquired image (nothing presents when headless)
+    VkSemaphore signalSemaphores[] = {g_renderFinishedSemaphores[g_currentImageIndex]};
+    submitInfo.signalSemaphoreCount = g_headless ? 0 : 1;
     submitInfo.pSignalSemaphores = signalSemaphores;
     
-    // Submit with fence - this fence will be signaled when the command buffer completes
-    vkQueueSubmit(g_graphicsQueue, 1, &submitInfo, g_inFlightFence);
+    g_endFrameCpuMs = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - endFrameStart).count();
+    
+    {
+        ProfileScope profile(PROFILE_SUBMIT);
+        // Uploads recorded this frame must be submitted first - the frame samples/reads what they write
+        flushUploads();
+        
+        // Submit with fence - this fence will be signaled when the command buffer completes
+        vkQueueSubmit(g_graphicsQueue, 1, &submitInfo, g_inFlightFences[g_currentFrame]);
+        noteFrameSubmitted();
+    }
+    g_lastSubmittedImage = static_cast<int32_t>(g_currentImageIndex);
+    
+    if (g_headless) {
+        g_currentFrame = (g_currentFrame + 1) % g_maxFramesInFlight;
+        return;
+    }
     
     VkPresentInfoKHR presentInfo = {};
     presentInfo.sType = VK_STRUCTURE_TYPE_PRESENT_INFO_KHR;
@@ -1839,9 +4013,144 @@ extern "C" void heidic_end_frame() {
     VkSwapchainKHR swapchains[] = {g_swapchain};
     presentInfo.swapchainCount = 1;
     presentInfo.pSwapchains = swapchains;
-    presentInfo.pImageIndices = &g_currentFrame;
+    presentInfo.pImageIndices = &g_currentImageIndex;
+    
+    {
+        ProfileScope profile(PROFILE_PRESENT);
+        vkQueuePresentKHR(g_graphicsQueue, &presentInfo);
+    }
+    
+    // Advance the ring - the next frame records into the next slot's resources
+    g_currentFrame = (g_currentFrame + 1) % g_maxFramesInFlight;
+}
+
+extern "C" void heidic_set_frames_in_flight(int count) {
+    // Only takes effect before heidic_init_renderer() (per-frame resources are sized at init)
+    if (g_device != VK_NULL_HANDLE || g_nullRenderer) {
+        std::cerr << "[EDEN] heidic_set_frames_in_flight must be called before heidic_init_renderer" << std::endl;
+        return;
+    }
+    if (count < 1) count = 1;
+    g_maxFramesInFlight = static_cast<uint32_t>(count);
+}
+
+extern "C" int heidic_get_frames_in_flight() {
+    return static_cast<int>(g_maxFramesInFlight);
+}
+
+// Wall time between the last two heidic_begin_frame() calls (frame pacing included when windowed)
+extern "C" double heidic_get_frame_time_ms() {
+    return g_frameTimeMs;
+}
+
+// CPU time of the last heidic_end_frame() up to (not including) queue submission and present
+extern "C" double heidic_get_end_frame_cpu_ms() {
+    return g_endFrameCpuMs;
+}
+
+// Monotonic milliseconds since an arbitrary start, for timing sections of a script
+extern "C" double heidic_get_time_ms() {
+    static const auto start = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+// ============================================================================
+// HEADLESS READBACK
+// ============================================================================
+// heidic_save_frame() copies the offscreen image of the last submitted frame into a host-visible
+// buffer through the upload context, waits for it and writes a 24-bit BMP. It stalls the queue, so
+// call it outside timed loops (e.g. once at the end of a benchmark run).
+
+// Bottom-up BGR rows padded to 4 bytes; bgra is tightly packed top-down B8G8R8A8
+static bool writeBmpBgra(const char* path, uint32_t width, uint32_t height, const unsigned char* bgra) {
+    uint32_t rowSize = (width * 3 + 3) & ~3u;
+    uint32_t imageSize = rowSize * height;
+    unsigned char header[54] = {'B', 'M'};
+    auto put32 = [&](size_t offset, uint32_t value) {
+        for (int i = 0; i < 4; i++) header[offset + i] = (unsigned char)(value >> (8 * i));
+    };
+    put32(2, 54 + imageSize);  // File size
+    put32(10, 54);             // Pixel data offset
+    put32(14, 40);             // BITMAPINFOHEADER
+    put32(18, width);
+    put32(22, height);
+    header[26] = 1;            // Planes
+    header[28] = 24;           // Bits per pixel
+    put32(34, imageSize);
+    
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    if (!file) return false;
+    file.write(reinterpret_cast<const char*>(header), sizeof(header));
+    std::vector<unsigned char> row(rowSize, 0);
+    for (uint32_t y = 0; y < height; y++) {
+        const unsigned char* src = bgra + (size_t)(height - 1 - y) * width * 4;
+        for (uint32_t x = 0; x < width; x++) {
+            row[x * 3 + 0] = src[x * 4 + 0];
+            row[x * 3 + 1] = src[x * 4 + 1];
+            row[x * 3 + 2] = src[x * 4 + 2];
+        }
+        file.write(reinterpret_cast<const char*>(row.data()), rowSize);
+    }
+    return file.good();
+}
+
+// Write the last frame finished with heidic_end_frame() to a .bmp file (headless mode only)
+extern "C" int heidic_save_frame(const char* path) {
+    if (!g_headless) {
+        std::cerr << "[EDEN] heidic_save_frame is only available after heidic_init_renderer_headless" << std::endl;
+        return 0;
+    }
+    if (path == nullptr || g_lastSubmittedImage < 0) return 0;
+    
+    uint32_t width = g_swapchainExtent.width;
+    uint32_t height = g_swapchainExtent.height;
+    VkDeviceSize size = (VkDeviceSize)width * height * 4;
+    VkBuffer readback = VK_NULL_HANDLE;
+    GpuAllocation readbackMemory;
+    createBuffer(size, VK_BUFFER_USAGE_TRANSFER_DST_BIT, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
+                 readback, readbackMemory);
+    if (readback == VK_NULL_HANDLE) return 0;
+    
+    // The render pass left the image in TRANSFER_SRC; only the attachment writes need to be made visible.
+    // Its final-layout transition is ordered by the implicit external dependency, which ends at
+    // BOTTOM_OF_PIPE, so the source stage is ALL_COMMANDS to chain with it rather than COLOR_ATTACHMENT_OUTPUT.
+    VkCommandBuffer cmd = uploadCommandBuffer();
+    VkImage image = g_swapchainImages[g_lastSubmittedImage];
+    VkImageMemoryBarrier imageBarrier = {};
+    imageBarrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+    imageBarrier.srcAccessMask = VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT;
+    imageBarrier.dstAccessMask = VK_ACCESS_TRANSFER_READ_BIT;
+    imageBarrier.oldLayout = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL;
+    imageBarrier.newLayout = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL;
+    imageBarrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    imageBarrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    imageBarrier.image = image;
+    imageBarrier.subresourceRange = {VK_IMAGE_ASPECT_COLOR_BIT, 0, 1, 0, 1};
+    vkCmdPipelineBarrier(cmd, VK_PIPELINE_STAGE_ALL_COMMANDS_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT,
+                         0, 0, nullptr, 0, nullptr, 1, &imageBarrier);
     
-    vkQueuePresentKHR(g_graphicsQueue, &presentInfo);
+    VkBufferImageCopy region = {};
+    region.imageSubresource = {VK_IMAGE_ASPECT_COLOR_BIT, 0, 0, 1};
+    region.imageExtent = {width, height, 1};
+    vkCmdCopyImageToBuffer(cmd, image, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, readback, 1, &region);
+    
+    VkMemoryBarrier hostBarrier = {};
+    hostBarrier.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+    hostBarrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+    hostBarrier.dstAccessMask = VK_ACCESS_HOST_READ_BIT;
+    vkCmdPipelineBarrier(cmd, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_HOST_BIT, 0, 1, &hostBarrier, 0, nullptr, 0, nullptr);
+    g_uploadCopyCount++;
+    finishUploads();
+    
+    bool ok = readbackMemory.mapped != nullptr &&
+              writeBmpBgra(path, width, height, static_cast<const unsigned char*>(readbackMemory.mapped));
+    destroyBuffer(readback, readbackMemory);
+    if (!ok) {
+        std::cerr << "[EDEN] Failed to write frame to " << path << std::endl;
+        return 0;
+    }
+    std::cout << "[EDEN] Saved frame " << width << "x" << height << " to " << path << std::endl;
+    return 1;
 }
 
 // DRAW CUBE
@@ -1857,19 +4166,11 @@ extern "C" void heidic_draw_cube(float x, float y, float z, float rx, float ry,
     
     model = glm::scale(model, glm::vec3(sx, sy, sz));
     
-    PushConsts push = {model};
-    vkCmdPushConstants(g_commandBuffers[g_currentFrame], g_pipelineLayout, VK_SHADER_STAGE_VERTEX_BIT, 0, sizeof(PushConsts), &push);
-    
-    vkCmdDraw(g_commandBuffers[g_currentFrame], g_cubeVertexCount, 1, 0, 0);
+    queueMeshDraw(g_cubeVertexBuffer, g_cubeVertexCount, currentTextureDescriptorSet(), model, glm::vec3(0.0f), glm::vec3(0.5f));
 }
 
 // DRAW CUBE WITH GREY COLOR (uses pre-created grey cube buffer)
 extern "C" void heidic_draw_cube_grey(float x, float y, float z, float rx, float ry, float rz, float sx, float sy, float sz) {
-    // Ensure white default texture is loaded for non-textured geometry
-    // This prevents texture color from tinting non-textured geometry
-    // Always load default texture before drawing non-textured geometry to prevent tinting
-    heidic_load_texture_for_rendering("default.bmp");
-    
     // Construct Model Matrix
     glm::mat4 model = glm::mat4(1.0f);
     model = glm::translate(model, glm::vec3(x, y, z));
@@ -1878,15 +4179,9 @@ extern "C" void heidic_draw_cube_grey(float x, float y, float z, float rx, float
     model = glm::rotate(model, glm::radians(rz), glm::vec3(0.0f, 0.0f, 1.0f));
     model = glm::scale(model, glm::vec3(sx, sy, sz));
     
-    PushConsts push = {model};
-    VkCommandBuffer cb = g_commandBuffers[g_currentFrame];
-    vkCmdPushConstants(cb, g_pipelineLayout, VK_SHADER_STAGE_VERTEX_BIT, 0, sizeof(PushConsts), &push);
-    
-    VkBuffer vertexBuffers[] = {g_greyCubeVertexBuffer};
-    VkDeviceSize offsets[] = {0};
-    vkCmdBindVertexBuffers(cb, 0, 1, vertexBuffers, offsets);
-    
-    vkCmdDraw(cb, g_greyCubeVertexCount, 1, 0, 0);
+    // Always use the default (white) texture set so the current texture doesn't tint
+    // non-textured geometry - no need to switch the current texture for that
+    queueMeshDraw(g_greyCubeVertexBuffer, g_greyCubeVertexCount, g_descriptorSets[g_currentFrame], model, glm::vec3(0.0f), glm::vec3(0.5f));
 }
 
 // DRAW CUBE WITH BLUE COLOR (uses pre-created blue cube buffer)
@@ -1899,65 +4194,70 @@ extern "C" void heidic_draw_cube_blue(float x, float y, float z, float rx, float
     model = glm::rotate(model, glm::radians(rz), glm::vec3(0.0f, 0.0f, 1.0f));
     model = glm::scale(model, glm::vec3(sx, sy, sz));
     
-    PushConsts push = {model};
-    VkCommandBuffer cb = g_commandBuffers[g_currentFrame];
-    vkCmdPushConstants(cb, g_pipelineLayout, VK_SHADER_STAGE_VERTEX_BIT, 0, sizeof(PushConsts), &push);
-    
-    VkBuffer vertexBuffers[] = {g_blueCubeVertexBuffer};
-    VkDeviceSize offsets[] = {0};
-    vkCmdBindVertexBuffers(cb, 0, 1, vertexBuffers, offsets);
-    
-    vkCmdDraw(cb, g_blueCubeVertexCount, 1, 0, 0);
-}
+    queueMeshDraw(g_blueCubeVertexBuffer, g_blueCubeVertexCount, currentTextureDescriptorSet(), model, glm::vec3(0.0f), glm::vec3(0.5f));
+}
+
+// Unit cube at the origin with proper UVs (0,0 to 1,1) and white vertex color; shared by the
+// CPU-transformed colored cube path and the static level cache, which tint it per cube
+static const Vertex g_coloredCubeUnitVertices[36] = {
+    // Front face - proper UVs (0,0 to 1,1), color as tint
+    {{-0.5f, -0.5f,  0.5f}, {0.0f, 0.0f}, {1.0f, 1.0f, 1.0f}},
+    {{ 0.5f, -0.5f,  0.5f}, {1.0f, 0.0f}, {1.0f, 1.0f, 1.0f}},
+    {{ 0.5f,  0.5f,  0.5f}, {1.0f, 1.0f}, {1.0f, 1.0f, 1.0f}},
+    {{ 0.5f,  0.5f,  0.5f}, {1.0f, 1.0f}, {1.0f, 1.0f, 1.0f}},
+    {{-0.5f,  0.5f,  0.5f}, {0.0f, 1.0f}, {1.0f, 1.0f, 1.0f}},
+    {{-0.5f, -0.5f,  0.5f}, {0.0f, 0.0f}, {1.0f, 1.0f, 1.0f}},
+    // Back face
+    {{-0.5f, -0.5f, -0.5f}, {1.0f, 0.0f}, {1.0f, 1.0f, 1.0f}},
+    {{-0.5f,  0.5f, -0.5f}, {1.0f, 1.0f}, {1.0f, 1.0f, 1.0f}},
+    {{ 0.5f,  0.5f, -0.5f}, {0.0f, 1.0f}, {1.0f, 1.0f, 1.0f}},
+    {{ 0.5f,  0.5f, -0.5f}, {0.0f, 1.0f}, {1.0f, 1.0f, 1.0f}},
+    {{ 0.5f, -0.5f, -0.5f}, {0.0f, 0.0f}, {1.0f, 1.0f, 1.0f}},
+    {{-0.5f, -0.5f, -0.5f}, {1.0f, 0.0f}, {1.0f, 1.0f, 1.0f}},
+    // Top face
+    {{-0.5f,  0.5f, -0.5f}, {0.0f, 1.0f}, {1.0f, 1.0f, 1.0f}},
+    {{-0.5f,  0.5f,  0.5f}, {0.0f, 0.0f}, {1.0f, 1.0f, 1.0f}},
+    {{ 0.5f,  0.5f,  0.5f}, {1.0f, 0.0f}, {1.0f, 1.0f, 1.0f}},
+    {{ 0.5f,  0.5f,  0.5f}, {1.0f, 0.0f}, {1.0f, 1.0f, 1.0f}},
+    {{ 0.5f,  0.5f, -0.5f}, {1.0f, 1.0f}, {1.0f, 1.0f, 1.0f}},
+    {{-0.5f,  0.5f, -0.5f}, {0.0f, 1.0f}, {1.0f, 1.0f, 1.0f}},
+    // Bottom face
+    {{-0.5f, -0.5f, -0.5f}, {0.0f, 0.0f}, {1.0f, 1.0f, 1.0f}},
+    {{ 0.5f, -0.5f, -0.5f}, {1.0f, 0.0f}, {1.0f, 1.0f, 1.0f}},
+    {{ 0.5f, -0.5f,  0.5f}, {1.0f, 1.0f}, {1.0f, 1.0f, 1.0f}},
+    {{ 0.5f, -0.5f,  0.5f}, {1.0f, 1.0f}, {1.0f, 1.0f, 1.0f}},
+    {{-0.5f, -0.5f,  0.5f}, {0.0f, 1.0f}, {1.0f, 1.0f, 1.0f}},
+    {{-0.5f, -0.5f, -0.5f}, {0.0f, 0.0f}, {1.0f, 1.0f, 1.0f}},
+    // Right face
+    {{ 0.5f, -0.5f, -0.5f}, {0.0f, 0.0f}, {1.0f, 1.0f, 1.0f}},
+    {{ 0.5f,  0.5f, -0.5f}, {0.0f, 1.0f}, {1.0f, 1.0f, 1.0f}},
+    {{ 0.5f,  0.5f,  0.5f}, {1.0f, 1.0f}, {1.0f, 1.0f, 1.0f}},
+    {{ 0.5f,  0.5f,  0.5f}, {1.0f, 1.0f}, {1.0f, 1.0f, 1.0f}},
+    {{ 0.5f, -0.5f,  0.5f}, {1.0f, 0.0f}, {1.0f, 1.0f, 1.0f}},
+    {{ 0.5f, -0.5f, -0.5f}, {0.0f, 0.0f}, {1.0f, 1.0f, 1.0f}},
+    // Left face
+    {{-0.5f, -0.5f, -0.5f}, {1.0f, 0.0f}, {1.0f, 1.0f, 1.0f}},
+    {{-0.5f, -0.5f,  0.5f}, {0.0f, 0.0f}, {1.0f, 1.0f, 1.0f}},
+    {{-0.5f,  0.5f,  0.5f}, {0.0f, 1.0f}, {1.0f, 1.0f, 1.0f}},
+    {{-0.5f,  0.5f,  0.5f}, {0.0f, 1.0f}, {1.0f, 1.0f, 1.0f}},
+    {{-0.5f,  0.5f, -0.5f}, {1.0f, 1.0f}, {1.0f, 1.0f, 1.0f}},
+    {{-0.5f, -0.5f, -0.5f}, {1.0f, 0.0f}, {1.0f, 1.0f, 1.0f}}
+};
 
 // DRAW CUBE WITH CUSTOM RGB COLOR (batched system, similar to lines)
 // Note: Uses proper UVs for texture, vertex color acts as tint
 extern "C" void heidic_draw_cube_colored(float x, float y, float z, float rx, float ry, float rz, float sx, float sy, float sz, float r, float g, float b) {
-    // Create cube vertices with proper UVs and color tint (unit cube at origin)
-    std::vector<Vertex> cubeVertices = {
-        // Front face - proper UVs (0,0 to 1,1), color as tint
-        {{-0.5f, -0.5f,  0.5f}, {0.0f, 0.0f}, {r, g, b}},
-        {{ 0.5f, -0.5f,  0.5f}, {1.0f, 0.0f}, {r, g, b}},
-        {{ 0.5f,  0.5f,  0.5f}, {1.0f, 1.0f}, {r, g, b}},
-        {{ 0.5f,  0.5f,  0.5f}, {1.0f, 1.0f}, {r, g, b}},
-        {{-0.5f,  0.5f,  0.5f}, {0.0f, 1.0f}, {r, g, b}},
-        {{-0.5f, -0.5f,  0.5f}, {0.0f, 0.0f}, {r, g, b}},
-        // Back face
-        {{-0.5f, -0.5f, -0.5f}, {1.0f, 0.0f}, {r, g, b}},
-        {{-0.5f,  0.5f, -0.5f}, {1.0f, 1.0f}, {r, g, b}},
-        {{ 0.5f,  0.5f, -0.5f}, {0.0f, 1.0f}, {r, g, b}},
-        {{ 0.5f,  0.5f, -0.5f}, {0.0f, 1.0f}, {r, g, b}},
-        {{ 0.5f, -0.5f, -0.5f}, {0.0f, 0.0f}, {r, g, b}},
-        {{-0.5f, -0.5f, -0.5f}, {1.0f, 0.0f}, {r, g, b}},
-        // Top face
-        {{-0.5f,  0.5f, -0.5f}, {0.0f, 1.0f}, {r, g, b}},
-        {{-0.5f,  0.5f,  0.5f}, {0.0f, 0.0f}, {r, g, b}},
-        {{ 0.5f,  0.5f,  0.5f}, {1.0f, 0.0f}, {r, g, b}},
-        {{ 0.5f,  0.5f,  0.5f}, {1.0f, 0.0f}, {r, g, b}},
-        {{ 0.5f,  0.5f, -0.5f}, {1.0f, 1.0f}, {r, g, b}},
-        {{-0.5f,  0.5f, -0.5f}, {0.0f, 1.0f}, {r, g, b}},
-        // Bottom face
-        {{-0.5f, -0.5f, -0.5f}, {0.0f, 0.0f}, {r, g, b}},
-        {{ 0.5f, -0.5f, -0.5f}, {1.0f, 0.0f}, {r, g, b}},
-        {{ 0.5f, -0.5f,  0.5f}, {1.0f, 1.0f}, {r, g, b}},
-        {{ 0.5f, -0.5f,  0.5f}, {1.0f, 1.0f}, {r, g, b}},
-        {{-0.5f, -0.5f,  0.5f}, {0.0f, 1.0f}, {r, g, b}},
-        {{-0.5f, -0.5f, -0.5f}, {0.0f, 0.0f}, {r, g, b}},
-        // Right face
-        {{ 0.5f, -0.5f, -0.5f}, {0.0f, 0.0f}, {r, g, b}},
-        {{ 0.5f,  0.5f, -0.5f}, {0.0f, 1.0f}, {r, g, b}},
-        {{ 0.5f,  0.5f,  0.5f}, {1.0f, 1.0f}, {r, g, b}},
-        {{ 0.5f,  0.5f,  0.5f}, {1.0f, 1.0f}, {r, g, b}},
-        {{ 0.5f, -0.5f,  0.5f}, {1.0f, 0.0f}, {r, g, b}},
-        {{ 0.5f, -0.5f, -0.5f}, {0.0f, 0.0f}, {r, g, b}},
-        // Left face
-        {{-0.5f, -0.5f, -0.5f}, {1.0f, 0.0f}, {r, g, b}},
-        {{-0.5f, -0.5f,  0.5f}, {0.0f, 0.0f}, {r, g, b}},
-        {{-0.5f,  0.5f,  0.5f}, {0.0f, 1.0f}, {r, g, b}},
-        {{-0.5f,  0.5f,  0.5f}, {0.0f, 1.0f}, {r, g, b}},
-        {{-0.5f,  0.5f, -0.5f}, {1.0f, 1.0f}, {r, g, b}},
-        {{-0.5f, -0.5f, -0.5f}, {1.0f, 0.0f}, {r, g, b}}
-    };
+    // Instanced path: record one compact instance, the vertex shader expands the unit cube
+    if (g_cubeInstancedPipeline != VK_NULL_HANDLE) {
+        CubeInstance inst;
+        inst.pos[0] = x; inst.pos[1] = y; inst.pos[2] = z;
+        inst.rot[0] = rx; inst.rot[1] = ry; inst.rot[2] = rz;
+        inst.scale[0] = sx; inst.scale[1] = sy; inst.scale[2] = sz;
+        inst.color[0] = r; inst.color[1] = g; inst.color[2] = b;
+        inst.textureSlot = g_currentTextureSlot;
+        g_coloredCubeInstances.push_back(inst);
+        return;
+    }
     
     // Construct Model Matrix and transform vertices
     glm::mat4 model = glm::mat4(1.0f);
@@ -1967,8 +4267,19 @@ extern "C" void heidic_draw_cube_colored(float x, float y, float z, float rx, fl
     model = glm::rotate(model, glm::radians(rz), glm::vec3(0.0f, 0.0f, 1.0f));
     model = glm::scale(model, glm::vec3(sx, sy, sz));
     
+    // Skip the transform entirely for cubes outside the frustum
+    glm::vec3 boundsCenter, boundsExtent;
+    transformAabb(model, glm::vec3(0.0f), glm::vec3(0.5f), boundsCenter, boundsExtent);
+    bool visible = isAabbVisible(boundsCenter, boundsExtent);
+    g_cullStatsFrame.tested++;
+    if (!visible) {
+        g_cullStatsFrame.culled++;
+        return;
+    }
+    g_cullStatsFrame.visible++;
+    
     // Transform vertices to world space and add to batch
-    for (const auto& v : cubeVertices) {
+    for (const Vertex& v : g_coloredCubeUnitVertices) {
         glm::vec4 worldPos = model * glm::vec4(v.pos[0], v.pos[1], v.pos[2], 1.0f);
         Vertex transformed;
         transformed.pos[0] = worldPos.x;
@@ -1976,129 +4287,32 @@ extern "C" void heidic_draw_cube_colored(float x, float y, float z, float rx, fl
         transformed.pos[2] = worldPos.z;
         transformed.uv[0] = v.uv[0];
         transformed.uv[1] = v.uv[1];
-        transformed.color[0] = v.color[0];
-        transformed.color[1] = v.color[1];
-        transformed.color[2] = v.color[2];
+        transformed.color[0] = v.color[0] * r;
+        transformed.color[1] = v.color[1] * g;
+        transformed.color[2] = v.color[2] * b;
         g_coloredCubeVertices.push_back(transformed);
     }
 }
 
-// Flush current batch of colored cubes (draw them immediately and clear the batch)
+// Flush current batch of colored cubes (queue them with the current texture and clear the batch)
 // This allows batching cubes by texture - flush when texture changes
 extern "C" void heidic_flush_colored_cubes() {
     if (!g_commandBufferStarted) {
         return;  // Can't draw if command buffer isn't started
     }
     
-    if (g_coloredCubeVertices.empty()) {
+    // Bindless: every instance carries its own texture slot, so texture changes never split the
+    // batch - everything queued this frame is drawn with one call from heidic_end_frame()
+    if (g_cubeBindlessPipeline != VK_NULL_HANDLE && g_coloredCubeVertices.empty()) {
+        return;
+    }
+    
+    if (g_coloredCubeVertices.empty() && g_coloredCubeInstances.empty()) {
         return;  // Nothing to draw
     }
     
-    VkCommandBuffer cb = g_commandBuffers[g_currentFrame];
-    size_t vertexCount = g_coloredCubeVertices.size();
-    size_t bufferSize = sizeof(Vertex) * vertexCount;
-    
-    // Ensure buffer is large enough
-    if (bufferSize > 10 * 1024 * 1024) {
-        // Buffer too large, skip drawing
-        g_coloredCubeVertices.clear();
-        return;
-    }
-    
-    // Get batch index FIRST (before calculating offset)
-    VkDescriptorSet currentSet = VK_NULL_HANDLE;
-    int batchIndex = -1;
-    
-    if (g_currentFrame < g_batchDescriptorSets.size() && 
-        g_currentBatchIndex[g_currentFrame] < MAX_TEXTURE_SWITCHES_PER_FRAME) {
-        
-        batchIndex = g_currentBatchIndex[g_currentFrame];
-        currentSet = g_batchDescriptorSets[g_currentFrame][batchIndex];
-    } else {
-        // Fallback - use default descriptor set
-        if (g_currentFrame < g_descriptorSets.size()) {
-            currentSet = g_descriptorSets[g_currentFrame];
-        }
-        batchIndex = 0; // Use offset 0 for fallback
-    }
-    
-    // Calculate offset for this batch (each batch writes to a different part of the buffer)
-    // Each batch gets 10MB of space to avoid overwriting
-    VkDeviceSize batchOffset = batchIndex * (10 * 1024 * 1024); // 10MB per batch
-    VkDeviceSize maxOffset = batchOffset + bufferSize;
-    VkDeviceSize totalBufferSize = 100 * 1024 * 1024; // Total buffer size (100MB = 10 batches max)
-    
-    // Ensure we don't exceed buffer bounds
-    if (maxOffset > totalBufferSize || batchIndex >= 10) {
-        std::cerr << "[EDEN] Warning: Batch offset would exceed buffer, using offset 0 (may cause overwrite)" << std::endl;
-        batchOffset = 0;
-    }
-    
-    void* data;
-    vkMapMemory(g_device, g_coloredCubeVertexMemory, batchOffset, bufferSize, 0, &data);
-    memcpy(data, g_coloredCubeVertices.data(), bufferSize);
-    vkUnmapMemory(g_device, g_coloredCubeVertexMemory);
-    
-    // CRITICAL: Update descriptor set BEFORE binding it
-    // We can safely update it during command buffer recording as long as we update BEFORE binding
-    if (g_textureImageView != VK_NULL_HANDLE) {
-        VkDescriptorImageInfo imageInfo = {};
-        imageInfo.imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
-        imageInfo.imageView = g_textureImageView;
-        imageInfo.sampler = g_textureSampler;
-        
-        VkWriteDescriptorSet write = {};
-        write.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
-        write.dstSet = currentSet;
-        write.dstBinding = 1;
-        write.descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
-        write.descriptorCount = 1;
-        write.pImageInfo = &imageInfo;
-        
-        // Update the descriptor set (this is safe because we haven't bound it yet)
-        vkUpdateDescriptorSets(g_device, 1, &write, 0, nullptr);
-        
-        // Get texture name from cache
-        std::string texName = "unknown";
-        for (const auto& pair : g_textureCache) {
-            if (pair.second.view == g_textureImageView) {
-                texName = pair.first;
-                break;
-            }
-        }
-        std::cout << "[DEBUG FLUSH] Batch #" << batchIndex 
-                  << ", Texture: '" << texName 
-                  << "', Vertices: " << vertexCount 
-                  << ", DescriptorSet: " << (void*)currentSet << std::endl;
-    }
-    
-    // Increment batch index AFTER we've set up this batch's descriptor set
-    g_currentBatchIndex[g_currentFrame]++;
-
-    // Bind pipeline and descriptor sets
-    vkCmdBindPipeline(cb, VK_PIPELINE_BIND_POINT_GRAPHICS, g_pipeline);
-    if (currentSet != VK_NULL_HANDLE) {
-        vkCmdBindDescriptorSets(cb, VK_PIPELINE_BIND_POINT_GRAPHICS, g_pipelineLayout, 0, 1, &currentSet, 0, nullptr);
-    }
-    
-    // Push Identity Model Matrix (vertices are already transformed)
-    PushConsts push;
-    push.model = glm::mat4(1.0f);
-    vkCmdPushConstants(cb, g_pipelineLayout, VK_SHADER_STAGE_VERTEX_BIT, 0, sizeof(PushConsts), &push);
-
-    // Use the same batch offset we calculated above
-    VkBuffer vertexBuffers[] = {g_coloredCubeVertexBuffer};
-    VkDeviceSize offsets[] = {batchOffset};
-    vkCmdBindVertexBuffers(cb, 0, 1, vertexBuffers, offsets);
-    
-    // Draw current batch
-    std::cout << "[DEBUG FLUSH] Drawing " << vertexCount << " vertices at offset " << batchOffset 
-              << " (batch #" << batchIndex << ") with descriptor set " << (void*)currentSet << std::endl;
-    vkCmdDraw(cb, static_cast<uint32_t>(vertexCount), 1, 0, 0);
-    
-    // Clear the batch for next texture group
-    std::cout << "[DEBUG FLUSH] Clearing vertex batch (had " << g_coloredCubeVertices.size() << " vertices)" << std::endl;
-    g_coloredCubeVertices.clear();
+    // Queue with the current texture's own descriptor set (written once when it was created)
+    queueColoredCubeBatch(currentTextureDescriptorSet());
     
     // Note: We don't reset to default texture here because the next cube will load its own texture
     // The caller is responsible for loading the appropriate texture before the next batch
@@ -2158,16 +4372,20 @@ extern "C" void heidic_update_camera_with_far(float px, float py, float pz, floa
     g_currentView = view;
     g_currentProj = proj;
     g_currentCamPos = glm::vec3(px, py, pz);
+    g_currentFarPlane = far_plane;
+    updateFrustumPlanes(proj * view);
     
     // Update UBO
     UniformBufferObject ubo = {};
     ubo.view = view;
     ubo.proj = proj;
     
-    void* data;
-    vkMapMemory(g_device, g_uniformBuffersMemory[g_currentFrame], 0, sizeof(UniformBufferObject), 0, &data);
-    memcpy(data, &ubo, sizeof(UniformBufferObject));
-    vkUnmapMemory(g_device, g_uniformBuffersMemory[g_currentFrame]);
+    // Only write the UBO while this frame is being recorded - outside of that window the slot
+    // may still be read by the GPU. heidic_begin_frame() uploads the stored matrices anyway.
+    if (!g_commandBufferStarted || g_currentFrame >= g_uniformBuffersMemory.size()) {
+        return;
+    }
+    memcpy(g_uniformBuffersMemory[g_currentFrame].mapped, &ubo, sizeof(UniformBufferObject));
 }
 
 extern "C" Camera heidic_create_camera(Vec3 pos, Vec3 rot, float clip_near, float clip_far) {
@@ -2472,8 +4690,10 @@ extern "C" int heidic_imgui_selectable_colored(const char* label, float r, float
 extern "C" int32_t heidic_imgui_image_button(const char* str_id, int64_t texture_id, float size_x, float size_y, float tint_r, float tint_g, float tint_b, float tint_a) {
     if (texture_id == 0) return 0;  // Check before casting
     ImTextureRef tex_ref = (ImTextureRef)(uintptr_t)texture_id;
+    ImVec2 uv0(0, 0), uv1(1, 1);
+    if (texture_id < 0 && !thumbnailTextureRef(texture_id, tex_ref, uv0, uv1)) return 0;  // Palette thumbnail (atlas cell)
     ImVec4 tint_col(tint_r, tint_g, tint_b, tint_a);
-    return ImGui::ImageButton(str_id, tex_ref, ImVec2(size_x, size_y), ImVec2(0, 0), ImVec2(1, 1), ImVec4(0, 0, 0, 0), tint_col) ? 1 : 0;
+    return ImGui::ImageButton(str_id, tex_ref, ImVec2(size_x, size_y), uv0, uv1, ImVec4(0, 0, 0, 0), tint_col) ? 1 : 0;
 }
 
 // C++ overload for std::string (this will be called when HEIDIC passes std::string)
@@ -2569,16 +4789,369 @@ extern "C" float heidic_asin(float value) {
 }
 
 // Mesh storage
+// Mesh vertex formats (heidic_set_mesh_vertex_format)
+static const int MESH_VERTEX_FORMAT_FULL = 0;    // Vertex, 32 bytes
+static const int MESH_VERTEX_FORMAT_PACKED = 1;  // PackedVertex, 16 bytes
+static int g_meshVertexFormat = MESH_VERTEX_FORMAT_FULL;  // Applied to subsequently loaded meshes
+
 struct Mesh {
-    std::vector<Vertex> vertices;
+    int vertexFormat = MESH_VERTEX_FORMAT_FULL;
+    std::vector<Vertex> vertices;              // Full format only
+    std::vector<PackedVertex> packedVertices;  // Packed format only
+    glm::mat4 dequantize = glm::mat4(1.0f);    // Maps snorm16 positions back to mesh space (identity for full)
+    glm::vec3 boundsCenter = glm::vec3(0.0f);  // Mesh-space AABB for frustum culling
+    glm::vec3 boundsExtent = glm::vec3(0.0f);
+    std::vector<uint32_t> indices;
     VkBuffer vertexBuffer = VK_NULL_HANDLE;
-    VkDeviceMemory vertexMemory = VK_NULL_HANDLE;
-    uint32_t vertexCount = 0;
+    GpuAllocation vertexMemory;
+    VkBuffer indexBuffer = VK_NULL_HANDLE;
+    GpuAllocation indexMemory;
+    uint32_t vertexCount = 0;  // Unique vertices after welding
+    uint32_t indexCount = 0;
 };
 
 static std::vector<Mesh> g_meshes;
 static int g_nextMeshId = 0;
 
+// ============================================================================
+// MESH OPTIMIZATION
+// ============================================================================
+// Imported models arrive as independent triangles. Before upload they are welded into an indexed
+// mesh, the triangle order is optimised for the post-transform vertex cache (Forsyth's linear-speed
+// algorithm), clusters of that order are sorted outside-in to reduce overdraw (after Sander et al.,
+// "Fast Triangle Reordering for Vertex Locality and Reduced Overdraw"), and finally vertices are
+// renumbered in first-use order so vertex fetch walks memory linearly.
+
+static const int MESH_OPT_CACHE_SIZE = 32;     // Modelled cache size for scoring
+static const int MESH_OPT_FIFO_SIZE = 16;      // FIFO size used for ACMR reports and cluster splits
+static const size_t MESH_OPT_MIN_CLUSTER = 32; // Triangles per overdraw cluster (at least)
+
+struct VertexKeyHash {
+    size_t operator()(const Vertex& v) const {
+        const uint32_t* words = reinterpret_cast<const uint32_t*>(&v);
+        size_t h = 2166136261u;
+        for (size_t i = 0; i < sizeof(Vertex) / sizeof(uint32_t); i++) {
+            h = (h ^ words[i]) * 16777619u;
+        }
+        return h;
+    }
+};
+
+struct VertexKeyEqual {
+    bool operator()(const Vertex& a, const Vertex& b) const {
+        return memcmp(&a, &b, sizeof(Vertex)) == 0;
+    }
+};
+
+// Collapse bit-identical vertices (position, UV and color) into an index buffer
+static void weldVertices(const std::vector<Vertex>& soup, std::vector<Vertex>& vertices, std::vector<uint32_t>& indices) {
+    std::unordered_map<Vertex, uint32_t, VertexKeyHash, VertexKeyEqual> lookup;
+    lookup.reserve(soup.size());
+    vertices.clear();
+    indices.clear();
+    indices.reserve(soup.size());
+    for (const Vertex& v : soup) {
+        auto it = lookup.find(v);
+        if (it == lookup.end()) {
+            uint32_t index = static_cast<uint32_t>(vertices.size());
+            lookup.emplace(v, index);
+            vertices.push_back(v);
+            indices.push_back(index);
+        } else {
+            indices.push_back(it->second);
+        }
+    }
+}
+
+// Average cache miss ratio (transformed vertices per triangle) for a FIFO cache
+static float computeACMR(const std::vector<uint32_t>& indices, size_t vertexCount) {
+    if (indices.empty()) return 0.0f;
+    std::vector<uint32_t> timestamps(vertexCount, 0);
+    uint32_t time = MESH_OPT_FIFO_SIZE + 1;
+    uint32_t misses = 0;
+    for (uint32_t index : indices) {
+        if (time - timestamps[index] > (uint32_t)MESH_OPT_FIFO_SIZE) {
+            timestamps[index] = time++;
+            misses++;
+        }
+    }
+    return (float)misses / (float)(indices.size() / 3);
+}
+
+static float forsythVertexScore(int cachePosition, uint32_t liveTriangles) {
+    if (liveTriangles == 0) return -1.0f;  // Nothing left to draw with this vertex
+    float score = 0.0f;
+    if (cachePosition >= 0) {
+        if (cachePosition < 3) {
+            score = 0.75f;  // Used by the last triangle - fixed score so it isn't favoured too much
+        } else {
+            float scaler = 1.0f / (MESH_OPT_CACHE_SIZE - 3);
+            score = powf(1.0f - (cachePosition - 3) * scaler, 1.5f);
+        }
+    }
+    // Boost vertices with few triangles left so lone triangles don't get stranded
+    score += 2.0f * powf((float)liveTriangles, -0.5f);
+    return score;
+}
+
+// Reorder triangles for the post-transform vertex cache
+static void optimizeVertexCache(std::vector<uint32_t>& indices, size_t vertexCount) {
+    size_t triangleCount = indices.size() / 3;
+    if (triangleCount == 0) return;
+    
+    // Vertex -> triangle adjacency; the first liveTriangles[v] entries of each range are not yet emitted
+    std::vector<uint32_t> liveTriangles(vertexCount, 0);
+    for (uint32_t index : indices) liveTriangles[index]++;
+    std::vector<uint32_t> adjacencyOffset(vertexCount + 1, 0);
+    for (size_t v = 0; v < vertexCount; v++) adjacencyOffset[v + 1] = adjacencyOffset[v] + liveTriangles[v];
+    std::vector<uint32_t> adjacency(indices.size());
+    std::vector<uint32_t> fill(adjacencyOffset.begin(), adjacencyOffset.end() - 1);
+    for (size_t t = 0; t < triangleCount; t++) {
+        for (int k = 0; k < 3; k++) adjacency[fill[indices[t * 3 + k]]++] = static_cast<uint32_t>(t);
+    }
+    
+    std::vector<int> cachePosition(vertexCount, -1);
+    std::vector<float> vertexScore(vertexCount);
+    for (size_t v = 0; v < vertexCount; v++) vertexScore[v] = forsythVertexScore(-1, liveTriangles[v]);
+    std::vector<bool> emitted(triangleCount, false);
+    
+    int bestTriangle = -1;
+    float bestScore = -1.0f;
+    for (size_t t = 0; t < triangleCount; t++) {
+        float score = vertexScore[indices[t * 3]] + vertexScore[indices[t * 3 + 1]] + vertexScore[indices[t * 3 + 2]];
+        if (score > bestScore) {
+            bestScore = score;
+            bestTriangle = static_cast<int>(t);
+        }
+    }
+    
+    std::vector<uint32_t> output;
+    output.reserve(indices.size());
+    std::vector<uint32_t> cache;
+    std::vector<uint32_t> newCache;
+    cache.reserve(MESH_OPT_CACHE_SIZE + 3);
+    newCache.reserve(MESH_OPT_CACHE_SIZE + 3);
+    size_t fallbackCursor = 0;
+    
+    while (output.size() < indices.size()) {
+        if (bestTriangle < 0) {
+            // No candidate adjacent to the cache - continue with the next triangle in input order
+            while (fallbackCursor < triangleCount && emitted[fallbackCursor]) fallbackCursor++;
+            if (fallbackCursor >= triangleCount) break;
+            bestTriangle = static_cast<int>(fallbackCursor);
+        }
+        
+        const uint32_t* tri = &indices[bestTriangle * 3];
+        emitted[bestTriangle] = true;
+        newCache.clear();
+        for (int k = 0; k < 3; k++) {
+            uint32_t v = tri[k];
+            output.push_back(v);
+            newCache.push_back(v);
+            // Remove the triangle from the vertex's live adjacency
+            uint32_t begin = adjacencyOffset[v];
+            uint32_t end = begin + liveTriangles[v];
+            for (uint32_t a = begin; a < end; a++) {
+                if (adjacency[a] == (uint32_t)bestTriangle) {
+                    std::swap(adjacency[a], adjacency[end - 1]);
+                    break;
+                }
+            }
+            liveTriangles[v]--;
+        }
+        for (uint32_t v : cache) {
+            if (v != tri[0] && v != tri[1] && v != tri[2]) newCache.push_back(v);
+        }
+        
+        // Rescore vertices whose cache position changed (including those just evicted)
+        for (size_t i = 0; i < newCache.size(); i++) {
+            uint32_t v = newCache[i];
+            cachePosition[v] = (i < (size_t)MESH_OPT_CACHE_SIZE) ? static_cast<int>(i) : -1;
+            vertexScore[v] = forsythVertexScore(cachePosition[v], liveTriangles[v]);
+        }
+        
+        // The next triangle is the best-scoring live triangle touching the cache
+        bestTriangle = -1;
+        bestScore = -1.0f;
+        for (uint32_t v : newCache) {
+            uint32_t begin = adjacencyOffset[v];
+            for (uint32_t a = begin; a < begin + liveTriangles[v]; a++) {
+                uint32_t t = adjacency[a];
+                float score = vertexScore[indices[t * 3]] + vertexScore[indices[t * 3 + 1]] + vertexScore[indices[t * 3 + 2]];
+                if (score > bestScore) {
+                    bestScore = score;
+                    bestTriangle = static_cast<int>(t);
+                }
+            }
+        }
+        
+        if (newCache.size() > (size_t)MESH_OPT_CACHE_SIZE) newCache.resize(MESH_OPT_CACHE_SIZE);
+        cache.swap(newCache);
+    }
+    
+    indices.swap(output);
+}
+
+// Split the cache-optimised order into clusters at cache flushes and draw outward-facing clusters
+// first: they are the most likely to occlude the rest of the mesh
+static void optimizeOverdraw(std::vector<uint32_t>& indices, const std::vector<Vertex>& vertices) {
+    size_t triangleCount = indices.size() / 3;
+    if (triangleCount <= MESH_OPT_MIN_CLUSTER) return;
+    
+    // Cluster boundaries: a triangle that misses the FIFO on all three vertices starts a new
+    // cluster, so reordering clusters costs almost nothing in cache efficiency
+    std::vector<size_t> clusterStart;
+    std::vector<uint32_t> timestamps(vertices.size(), 0);
+    uint32_t time = MESH_OPT_FIFO_SIZE + 1;
+    size_t currentStart = 0;
+    clusterStart.push_back(0);
+    for (size_t t = 0; t < triangleCount; t++) {
+        int misses = 0;
+        for (int k = 0; k < 3; k++) {
+            uint32_t v = indices[t * 3 + k];
+            if (time - timestamps[v] > (uint32_t)MESH_OPT_FIFO_SIZE) {
+                timestamps[v] = time++;
+                misses++;
+            }
+        }
+        if (misses == 3 && t - currentStart >= MESH_OPT_MIN_CLUSTER) {
+            clusterStart.push_back(t);
+            currentStart = t;
+        }
+    }
+    if (clusterStart.size() < 2) return;
+    clusterStart.push_back(triangleCount);
+    
+    glm::vec3 meshCentroid(0.0f);
+    for (const Vertex& v : vertices) meshCentroid += glm::vec3(v.pos[0], v.pos[1], v.pos[2]);
+    meshCentroid /= (float)vertices.size();
+    
+    struct Cluster {
+        size_t first;
+        size_t count;
+        float sortKey;
+    };
+    std::vector<Cluster> clusters;
+    for (size_t c = 0; c + 1 < clusterStart.size(); c++) {
+        glm::vec3 centroid(0.0f);
+        glm::vec3 normal(0.0f);  // Area-weighted
+        float area = 0.0f;
+        for (size_t t = clusterStart[c]; t < clusterStart[c + 1]; t++) {
+            const Vertex& a = vertices[indices[t * 3]];
+            const Vertex& b = vertices[indices[t * 3 + 1]];
+            const Vertex& d = vertices[indices[t * 3 + 2]];
+            glm::vec3 pa(a.pos[0], a.pos[1], a.pos[2]);
+            glm::vec3 pb(b.pos[0], b.pos[1], b.pos[2]);
+            glm::vec3 pd(d.pos[0], d.pos[1], d.pos[2]);
+            glm::vec3 n = glm::cross(pb - pa, pd - pa);
+            float triangleArea = glm::length(n);
+            normal += n;
+            centroid += (pa + pb + pd) * (triangleArea / 3.0f);
+            area += triangleArea;
+        }
+        float sortKey = 0.0f;
+        if (area > 0.0f && glm::length(normal) > 0.0f) {
+            centroid /= area;
+            sortKey = glm::dot(centroid - meshCentroid, glm::normalize(normal));
+        }
+        clusters.push_back({clusterStart[c], clusterStart[c + 1] - clusterStart[c], sortKey});
+    }
+    
+    std::stable_sort(clusters.begin(), clusters.end(), [](const Cluster& a, const Cluster& b) { return a.sortKey > b.sortKey; });
+    
+    std::vector<uint32_t> output;
+    output.reserve(indices.size());
+    for (const Cluster& cluster : clusters) {
+        output.insert(output.end(), indices.begin() + cluster.first * 3, indices.begin() + (cluster.first + cluster.count) * 3);
+    }
+    indices.swap(output);
+}
+
+// Renumber vertices in the order the index buffer first references them
+static void optimizeVertexFetch(std::vector<Vertex>& vertices, std::vector<uint32_t>& indices) {
+    std::vector<uint32_t> remap(vertices.size(), UINT32_MAX);
+    std::vector<Vertex> ordered;
+    ordered.reserve(vertices.size());
+    for (uint32_t& index : indices) {
+        if (remap[index] == UINT32_MAX) {
+            remap[index] = static_cast<uint32_t>(ordered.size());
+            ordered.push_back(vertices[index]);
+        }
+        index = remap[index];
+    }
+    vertices.swap(ordered);  // Unreferenced vertices are dropped
+}
+
+// Packed vertex conversion
+static uint16_t floatToHalf(float value) {
+    uint32_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+    uint32_t sign = (bits >> 16) & 0x8000u;
+    uint32_t rawExponent = (bits >> 23) & 0xFFu;
+    uint32_t mantissa = bits & 0x7FFFFFu;
+    if (rawExponent == 0xFFu) return (uint16_t)(sign | 0x7C00u | (mantissa ? 0x200u : 0u));  // Inf / NaN
+    int32_t exponent = (int32_t)rawExponent - 127 + 15;
+    if (exponent >= 31) return (uint16_t)(sign | 0x7C00u);  // Overflow -> Inf
+    if (exponent <= 0) {
+        if (exponent < -10) return (uint16_t)sign;  // Underflow -> signed zero
+        mantissa |= 0x800000u;  // Denormal: make the implicit bit explicit and shift into place
+        uint32_t shift = (uint32_t)(14 - exponent);
+        uint32_t half = mantissa >> shift;
+        uint32_t remainder = mantissa & ((1u << shift) - 1u);
+        uint32_t halfway = 1u << (shift - 1u);
+        if (remainder > halfway || (remainder == halfway && (half & 1u))) half++;
+        return (uint16_t)(sign | half);
+    }
+    uint32_t half = sign | ((uint32_t)exponent << 10) | (mantissa >> 13);
+    uint32_t remainder = mantissa & 0x1FFFu;
+    if (remainder > 0x1000u || (remainder == 0x1000u && (half & 1u))) half++;  // Round to nearest even (carry into exponent is correct)
+    return (uint16_t)half;
+}
+
+static int16_t floatToSnorm16(float value) {
+    value = std::min(std::max(value, -1.0f), 1.0f);
+    return static_cast<int16_t>(std::lround(value * 32767.0f));
+}
+
+static uint8_t floatToUnorm8(float value) {
+    value = std::min(std::max(value, 0.0f), 1.0f);
+    return static_cast<uint8_t>(std::lround(value * 255.0f));
+}
+
+// Quantise positions against the mesh bounds and return the matrix that undoes it
+static glm::mat4 packVertices(const std::vector<Vertex>& vertices, std::vector<PackedVertex>& packed) {
+    glm::vec3 minPos(FLT_MAX), maxPos(-FLT_MAX);
+    for (const Vertex& v : vertices) {
+        glm::vec3 p(v.pos[0], v.pos[1], v.pos[2]);
+        minPos = glm::min(minPos, p);
+        maxPos = glm::max(maxPos, p);
+    }
+    glm::vec3 center = (minPos + maxPos) * 0.5f;
+    glm::vec3 extent = glm::max((maxPos - minPos) * 0.5f, glm::vec3(1e-6f));  // Avoid dividing by zero on flat meshes
+    
+    packed.resize(vertices.size());
+    for (size_t i = 0; i < vertices.size(); i++) {
+        const Vertex& v = vertices[i];
+        PackedVertex& out = packed[i];
+        for (int k = 0; k < 3; k++) {
+            out.pos[k] = floatToSnorm16((v.pos[k] - center[k]) / extent[k]);
+        }
+        out.pos[3] = 0;
+        out.uv[0] = floatToHalf(v.uv[0]);
+        out.uv[1] = floatToHalf(v.uv[1]);
+        for (int k = 0; k < 3; k++) {
+            out.color[k] = floatToUnorm8(v.color[k]);
+        }
+        out.color[3] = 255;
+    }
+    return glm::scale(glm::translate(glm::mat4(1.0f), center), extent);
+}
+
+// Select the vertex format for meshes loaded afterwards (0 = full 32-byte Vertex, 1 = packed 16-byte)
+extern "C" void heidic_set_mesh_vertex_format(int format) {
+    g_meshVertexFormat = (format == MESH_VERTEX_FORMAT_PACKED) ? MESH_VERTEX_FORMAT_PACKED : MESH_VERTEX_FORMAT_FULL;
+}
+
 // ASCII Model Loader
 extern "C" int heidic_load_ascii_model(const char* filename) {
     std::ifstream file(filename);
@@ -2712,6 +5285,8 @@ extern "C" int heidic_load_ascii_model(const char* filename) {
     // Note: Imported model units are assumed to be meters; EDEN uses centimeters (1 unit = 1 cm)
     // So we scale positions by 100.0 to bring them into world scale.
     const float POSITION_SCALE = 100.0f;
+    std::vector<Vertex> triangleSoup;  // Three vertices per triangle, welded below
+    triangleSoup.reserve(triangles.size() * 3);
     for (size_t i = 0; i < triangles.size(); i++) {
         const auto& tri = triangles[i];
         const auto& uvTri = (i < uvTriangles.size()) ? uvTriangles[i] : std::vector<int>{0, 0, 0};
@@ -2742,68 +5317,61 @@ extern "C" int heidic_load_ascii_model(const char* filename) {
             v.color[1] = 1.0f;
             v.color[2] = 1.0f;
             
-            mesh.vertices.push_back(v);
+            triangleSoup.push_back(v);
         }
     }
     
-    mesh.vertexCount = static_cast<uint32_t>(mesh.vertices.size());
-    
-    if (mesh.vertexCount == 0) {
+    if (triangleSoup.empty()) {
         std::cerr << "No vertices loaded from model: " << filename << std::endl;
         return -1;
     }
     
-    // Create vertex buffer
-    VkDeviceSize bufferSize = sizeof(Vertex) * mesh.vertices.size();
-    
-    VkBuffer stagingBuffer;
-    VkDeviceMemory stagingBufferMemory;
-    createBuffer(bufferSize, VK_BUFFER_USAGE_TRANSFER_SRC_BIT, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT, stagingBuffer, stagingBufferMemory);
-    
-    void* data;
-    vkMapMemory(g_device, stagingBufferMemory, 0, bufferSize, 0, &data);
-    memcpy(data, mesh.vertices.data(), (size_t)bufferSize);
-    vkUnmapMemory(g_device, stagingBufferMemory);
+    // Weld, then reorder for the vertex cache, overdraw and vertex fetch
+    weldVertices(triangleSoup, mesh.vertices, mesh.indices);
+    float acmrBefore = computeACMR(mesh.indices, mesh.vertices.size());
+    optimizeVertexCache(mesh.indices, mesh.vertices.size());
+    optimizeOverdraw(mesh.indices, mesh.vertices);
+    optimizeVertexFetch(mesh.vertices, mesh.indices);
+    float acmrAfter = computeACMR(mesh.indices, mesh.vertices.size());
     
-    createBuffer(bufferSize, VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_VERTEX_BUFFER_BIT, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, mesh.vertexBuffer, mesh.vertexMemory);
-    
-    VkCommandBufferAllocateInfo allocInfo = {};
-    allocInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
-    allocInfo.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
-    allocInfo.commandPool = g_commandPool;
-    allocInfo.commandBufferCount = 1;
-    
-    VkCommandBuffer commandBuffer;
-    vkAllocateCommandBuffers(g_device, &allocInfo, &commandBuffer);
-    
-    VkCommandBufferBeginInfo beginInfo = {};
-    beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
-    beginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
-    
-    vkBeginCommandBuffer(commandBuffer, &beginInfo);
-    
-    VkBufferCopy copyRegion = {};
-    copyRegion.size = bufferSize;
-    vkCmdCopyBuffer(commandBuffer, stagingBuffer, mesh.vertexBuffer, 1, &copyRegion);
-    
-    vkEndCommandBuffer(commandBuffer);
-    
-    VkSubmitInfo submitInfo = {};
-    submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
-    submitInfo.commandBufferCount = 1;
-    submitInfo.pCommandBuffers = &commandBuffer;
-    
-    vkQueueSubmit(g_graphicsQueue, 1, &submitInfo, VK_NULL_HANDLE);
-    vkQueueWaitIdle(g_graphicsQueue);
-    
-    vkFreeCommandBuffers(g_device, g_commandPool, 1, &commandBuffer);
-    vkDestroyBuffer(g_device, stagingBuffer, nullptr);
-    vkFreeMemory(g_device, stagingBufferMemory, nullptr);
+    mesh.vertexCount = static_cast<uint32_t>(mesh.vertices.size());
+    mesh.indexCount = static_cast<uint32_t>(mesh.indices.size());
+    
+    glm::vec3 boundsMin(FLT_MAX), boundsMax(-FLT_MAX);
+    for (const Vertex& v : mesh.vertices) {
+        boundsMin = glm::min(boundsMin, glm::vec3(v.pos[0], v.pos[1], v.pos[2]));
+        boundsMax = glm::max(boundsMax, glm::vec3(v.pos[0], v.pos[1], v.pos[2]));
+    }
+    mesh.boundsCenter = (boundsMin + boundsMax) * 0.5f;
+    mesh.boundsExtent = (boundsMax - boundsMin) * 0.5f;
+    
+    // Create vertex and index buffers
+    const void* vertexData = mesh.vertices.data();
+    VkDeviceSize vertexBytes = sizeof(Vertex) * mesh.vertices.size();
+    if (g_meshVertexFormat == MESH_VERTEX_FORMAT_PACKED && g_packedMeshPipeline != VK_NULL_HANDLE) {
+        mesh.vertexFormat = MESH_VERTEX_FORMAT_PACKED;
+        mesh.dequantize = packVertices(mesh.vertices, mesh.packedVertices);
+        mesh.vertices.clear();
+        mesh.vertices.shrink_to_fit();
+        vertexData = mesh.packedVertices.data();
+        vertexBytes = sizeof(PackedVertex) * mesh.packedVertices.size();
+    }
+    if (!createDeviceLocalBuffer(vertexData, vertexBytes, VK_BUFFER_USAGE_VERTEX_BUFFER_BIT, mesh.vertexBuffer, mesh.vertexMemory) ||
+        !createDeviceLocalBuffer(mesh.indices.data(), sizeof(uint32_t) * mesh.indices.size(), VK_BUFFER_USAGE_INDEX_BUFFER_BIT, mesh.indexBuffer, mesh.indexMemory)) {
+        std::cerr << "Failed to upload model: " << filename << std::endl;
+        // A recorded upload may still reference either buffer, so retire rather than destroy
+        retireBuffer(mesh.vertexBuffer, mesh.vertexMemory);
+        retireBuffer(mesh.indexBuffer, mesh.indexMemory);
+        return -1;
+    }
     
     int meshId = g_nextMeshId++;
     g_meshes.push_back(mesh);
     
-    std::cout << "Loaded mesh " << meshId << " with " << mesh.vertexCount << " vertices from " << filename << std::endl;
+    std::cout << "Loaded mesh " << meshId << " from " << filename << ": " << triangleSoup.size() << " vertices -> "
+              << mesh.vertexCount << " unique (" << mesh.indexCount << " indices), ACMR "
+              << acmrBefore << " -> " << acmrAfter << ", " << (mesh.vertexFormat == MESH_VERTEX_FORMAT_PACKED ? "packed" : "full")
+              << " vertices " << vertexBytes << " bytes" << std::endl;
     return meshId;
 }
 
@@ -2813,7 +5381,7 @@ extern "C" void heidic_draw_mesh(int mesh_id, float x, float y, float z, float r
     }
     
     Mesh& mesh = g_meshes[mesh_id];
-    if (mesh.vertexCount == 0) return;
+    if (mesh.indexCount == 0) return;
     
     // Construct Model Matrix
     glm::mat4 model = glm::mat4(1.0f);
@@ -2822,17 +5390,12 @@ extern "C" void heidic_draw_mesh(int mesh_id, float x, float y, float z, float r
     model = glm::rotate(model, glm::radians(ry), glm::vec3(0.0f, 1.0f, 0.0f));
     model = glm::rotate(model, glm::radians(rz), glm::vec3(0.0f, 0.0f, 1.0f));
     
-    PushConsts push = {model};
-    VkCommandBuffer cb = g_commandBuffers[g_currentFrame];
-    vkCmdPushConstants(cb, g_pipelineLayout, VK_SHADER_STAGE_VERTEX_BIT, 0, sizeof(PushConsts), &push);
+    glm::vec3 boundsCenter, boundsExtent;
+    transformAabb(model, mesh.boundsCenter, mesh.boundsExtent, boundsCenter, boundsExtent);
     
-    vkCmdBindPipeline(cb, VK_PIPELINE_BIND_POINT_GRAPHICS, g_pipeline);
-    
-    VkBuffer vertexBuffers[] = {mesh.vertexBuffer};
-    VkDeviceSize offsets[] = {0};
-    vkCmdBindVertexBuffers(cb, 0, 1, vertexBuffers, offsets);
-    
-    vkCmdDraw(cb, mesh.vertexCount, 1, 0, 0);
+    VkPipeline pipeline = (mesh.vertexFormat == MESH_VERTEX_FORMAT_PACKED) ? g_packedMeshPipeline : g_pipeline;
+    queueIndexedMeshDraw(pipeline, mesh.vertexBuffer, mesh.indexBuffer, mesh.indexCount, currentTextureDescriptorSet(), model * mesh.dequantize,
+                         boundsCenter, boundsExtent);
 }
 
 extern "C" void heidic_sleep_ms(int ms) {
@@ -3485,33 +6048,155 @@ extern "C" int heidic_gizmo_is_interacting() {
 // DYNAMIC CUBE STORAGE SYSTEM
 // ============================================================================
 
-struct CreatedCube {
-    float x, y, z;
-    float sx, sy, sz;  // size
-    float r, g, b;     // color
-    int active;  // 1 = exists, 0 = deleted
-    int combination_id;  // -1 = no combination, >= 0 = combination ID
-    std::string texture_name;  // Texture filename (empty = use default)
+// Cubes are kept as parallel columns indexed by storage index (slot), so scans (drawing, picking,
+// combining, saving) only pull the fields they read. Texture names are interned: textureId indexes
+// g_cubeTextureNames, 0 = no texture (drawn with default.bmp).
+//
+// Slots work as a slot map: deleting a cube puts its slot on a free list for the next create and
+// bumps the slot's generation, and `live` holds the slots of all active cubes densely, so
+// iteration and counting cost O(live) however much create/delete churn a session has seen.
+// Handles (slot + generation) detect references to a cube that was deleted and replaced.
+struct CubeStore {
+    std::vector<float> x, y, z;
+    std::vector<float> sx, sy, sz;  // size
+    std::vector<float> r, g, b;     // color
+    std::vector<uint8_t> active;    // 1 = exists, 0 = deleted
+    std::vector<int32_t> combinationId;  // -1 = no combination, >= 0 = combination ID
+    std::vector<uint32_t> textureId;
+    
+    std::vector<uint32_t> generation;  // Per slot; kept (and bumped) across clear() so old handles stay stale
+    std::vector<uint32_t> live;        // Slots of active cubes (unordered)
+    std::vector<uint32_t> livePos;     // Per slot: position in live while active
+    std::vector<uint32_t> freeSlots;   // Deleted slots, reused last-in first-out
+    
+    size_t size() const { return x.size(); }
+    
+    void clear() {
+        x.clear(); y.clear(); z.clear();
+        sx.clear(); sy.clear(); sz.clear();
+        r.clear(); g.clear(); b.clear();
+        active.clear(); combinationId.clear(); textureId.clear();
+        live.clear(); livePos.clear(); freeSlots.clear();
+        for (uint32_t& gen : generation) gen++;
+    }
+    
+    // New slots are deleted 200-unit white cubes (what level loading pads gaps with). Call
+    // rebuildIndex() once the active flags are final.
+    void resize(size_t count) {
+        x.resize(count, 0.0f); y.resize(count, 0.0f); z.resize(count, 0.0f);
+        sx.resize(count, 200.0f); sy.resize(count, 200.0f); sz.resize(count, 200.0f);
+        r.resize(count, 1.0f); g.resize(count, 1.0f); b.resize(count, 1.0f);
+        active.resize(count, 0); combinationId.resize(count, -1); textureId.resize(count, 0);
+        livePos.resize(count, 0);
+        if (generation.size() < count) generation.resize(count, 0);
+    }
+    
+    // Recompute the live array and free list from the active flags (after bulk edits like loading)
+    void rebuildIndex() {
+        live.clear();
+        freeSlots.clear();
+        for (size_t i = size(); i-- > 0;) {
+            if (active[i] != 1) freeSlots.push_back((uint32_t)i);  // Lowest slot is reused first
+        }
+        for (size_t i = 0; i < size(); i++) {
+            if (active[i] == 1) {
+                livePos[i] = (uint32_t)live.size();
+                live.push_back((uint32_t)i);
+            }
+        }
+    }
+    
+    int push(float px, float py, float pz, float psx, float psy, float psz, float pr, float pg, float pb, uint32_t texture) {
+        uint32_t slot;
+        if (!freeSlots.empty()) {
+            slot = freeSlots.back();
+            freeSlots.pop_back();
+        } else {
+            slot = (uint32_t)size();
+            resize(slot + 1);
+        }
+        x[slot] = px; y[slot] = py; z[slot] = pz;
+        sx[slot] = psx; sy[slot] = psy; sz[slot] = psz;
+        r[slot] = pr; g[slot] = pg; b[slot] = pb;
+        active[slot] = 1;
+        combinationId[slot] = -1;  // No combination initially
+        textureId[slot] = texture;
+        livePos[slot] = (uint32_t)live.size();
+        live.push_back(slot);
+        return (int)slot;
+    }
+    
+    // Deactivate a cube; its column data stays readable until the slot is reused
+    void remove(uint32_t slot) {
+        if (slot >= size() || active[slot] != 1) return;
+        active[slot] = 0;
+        generation[slot]++;
+        uint32_t pos = livePos[slot];
+        live[pos] = live.back();
+        livePos[live[pos]] = pos;
+        live.pop_back();
+        freeSlots.push_back(slot);
+    }
+};
+
+// Cube handles for scripts: low 20 bits slot, next 11 bits generation (stays a positive i32)
+static const uint32_t CUBE_HANDLE_SLOT_BITS = 20;
+static const uint32_t CUBE_HANDLE_SLOT_MASK = (1u << CUBE_HANDLE_SLOT_BITS) - 1;
+static const uint32_t CUBE_HANDLE_GENERATION_MASK = (1u << 11) - 1;
+
+static CubeStore g_createdCubes;
+static std::set<int> g_selectedCubeIndices;  // Multi-selection: set of selected cube storage indices
+
+static void sceneBvhCubeChanged(uint32_t slot);  // Defined with the scene BVH
+static void sceneBvhInvalidate();
+
+// Interned cube texture names. A deque so heidic_get_cube_texture_name() pointers stay valid as
+// names are added; names are never removed.
+static std::deque<std::string> g_cubeTextureNames = {""};
+static std::unordered_map<std::string, uint32_t> g_cubeTextureIds = {{"", 0}};
+
+static uint32_t internCubeTexture(const char* name) {
+    if (!name || name[0] == '\0') return 0;
+    auto it = g_cubeTextureIds.find(name);
+    if (it != g_cubeTextureIds.end()) return it->second;
+    uint32_t id = (uint32_t)g_cubeTextureNames.size();
+    g_cubeTextureNames.push_back(name);
+    g_cubeTextureIds.emplace(g_cubeTextureNames.back(), id);
+    return id;
+}
+
+// Static level geometry cache (see STATIC LEVEL GEOMETRY CACHE below)
+// One device-local vertex buffer of baked world-space cubes per texture. Edits only mark the
+// bucket of the touched cube dirty.
+struct StaticCubeBucket {
+    VkBuffer buffer = VK_NULL_HANDLE;
+    GpuAllocation memory;
+    uint32_t vertexCount = 0;
+    TextureResource* texture = nullptr;  // Resolved on rebuild (nullptr = init default texture)
+    glm::vec3 boundsCenter = glm::vec3(0.0f);  // World AABB of all cubes in the bucket
+    glm::vec3 boundsExtent = glm::vec3(0.0f);
+    bool dirty = true;
 };
+static std::map<std::string, StaticCubeBucket> g_staticCubeBuckets;  // Keyed by texture name
+static bool g_staticCubesDirty = false;  // Any bucket needs a rebuild
 
-static std::vector<CreatedCube> g_createdCubes;
+// Cubes without a texture are drawn with default.bmp, same as the editor's per-cube loop did
+static const std::string& staticCubeBucketKey(uint32_t textureId) {
+    static const std::string defaultKey = "default.bmp";
+    return textureId == 0 ? defaultKey : g_cubeTextureNames[textureId];
+}
+
+static void markStaticCubeDirty(int index) {
+    g_staticCubeBuckets[staticCubeBucketKey(g_createdCubes.textureId[index])].dirty = true;
+    g_staticCubesDirty = true;
+}
 
 extern "C" int heidic_create_cube(float x, float y, float z, float sx, float sy, float sz) {
-    CreatedCube cube;
-    cube.x = x;
-    cube.y = y;
-    cube.z = z;
-    cube.sx = sx;
-    cube.sy = sy;
-    cube.sz = sz;
-    cube.r = 1.0f;  // Default red
-    cube.g = 0.0f;
-    cube.b = 0.0f;
-    cube.active = 1;
-    cube.combination_id = -1;  // No combination initially
-    cube.texture_name = "";  // No texture initially
-    g_createdCubes.push_back(cube);
-    return (int)(g_createdCubes.size() - 1);  // Return index
+    // Default red, no texture
+    int index = g_createdCubes.push(x, y, z, sx, sy, sz, 1.0f, 0.0f, 0.0f, 0);
+    markStaticCubeDirty(index);
+    sceneBvhCubeChanged(index);
+    return index;
 }
 
 // Forward declarations
@@ -3522,52 +6207,22 @@ extern "C" int heidic_create_cube_with_color(float x, float y, float z, float sx
     // Use selected texture if available, otherwise empty string (default texture)
     // We'll get the selected texture via the getter function to avoid scope issues
     const char* selected_texture = heidic_get_selected_texture();
-    std::string texture_name = (selected_texture && strlen(selected_texture) > 0) ? std::string(selected_texture) : "";
-    
-    // Debug: Print what texture we're using
-    std::cout << "[DEBUG] Creating cube with texture: '" << texture_name << "' at (" << x << ", " << y << ", " << z << ")" << std::endl;
-    std::cout.flush();
-    
-    return heidic_create_cube_with_texture(x, y, z, sx, sy, sz, r, g, b, texture_name.c_str());
+    return heidic_create_cube_with_texture(x, y, z, sx, sy, sz, r, g, b, selected_texture);
 }
 
 extern "C" int heidic_create_cube_with_texture(float x, float y, float z, float sx, float sy, float sz, float r, float g, float b, const char* texture_name) {
-    CreatedCube cube;
-    cube.x = x;
-    cube.y = y;
-    cube.z = z;
-    cube.sx = sx;
-    cube.sy = sy;
-    cube.sz = sz;
-    cube.r = r;
-    cube.g = g;
-    cube.b = b;
-    cube.active = 1;
-    cube.combination_id = -1;  // No combination initially
-    cube.texture_name = texture_name ? std::string(texture_name) : "";  // Store texture name
-    
-    // Debug: Print cube creation details
-    std::cout << "[DEBUG] Pushing cube to vector. Current size: " << g_createdCubes.size() 
-              << ", texture: '" << cube.texture_name << "', pos: (" << x << ", " << y << ", " << z << ")" << std::endl;
-    std::cout.flush();
-    
-    g_createdCubes.push_back(cube);
-    int new_index = (int)(g_createdCubes.size() - 1);
-    
-    // Debug: Verify the cube was stored correctly
-    std::cout << "[DEBUG] Cube stored at index " << new_index 
-              << ", stored texture: '" << g_createdCubes[new_index].texture_name << "'" << std::endl;
-    std::cout.flush();
-    
-    return new_index;  // Return index
+    int index = g_createdCubes.push(x, y, z, sx, sy, sz, r, g, b, internCubeTexture(texture_name));  // Empty/null = default texture
+    markStaticCubeDirty(index);
+    sceneBvhCubeChanged(index);
+    return index;
+}
+
+static int countActiveCubes() {
+    return (int)g_createdCubes.live.size();
 }
 
 extern "C" int heidic_get_cube_count() {
-    int count = 0;
-    for (const auto& cube : g_createdCubes) {
-        if (cube.active == 1) count++;
-    }
-    return count;
+    return countActiveCubes();
 }
 
 extern "C" int heidic_get_cube_total_count() {
@@ -3576,66 +6231,758 @@ extern "C" int heidic_get_cube_total_count() {
 
 extern "C" float heidic_get_cube_x(int index) {
     if (index < 0 || index >= (int)g_createdCubes.size()) return 0.0f;
-    return g_createdCubes[index].x;
+    return g_createdCubes.x[index];
 }
 
 extern "C" float heidic_get_cube_y(int index) {
     if (index < 0 || index >= (int)g_createdCubes.size()) return 0.0f;
-    return g_createdCubes[index].y;
+    return g_createdCubes.y[index];
 }
 
 extern "C" float heidic_get_cube_z(int index) {
     if (index < 0 || index >= (int)g_createdCubes.size()) return 0.0f;
-    return g_createdCubes[index].z;
+    return g_createdCubes.z[index];
 }
 
 extern "C" float heidic_get_cube_sx(int index) {
     if (index < 0 || index >= (int)g_createdCubes.size()) return 200.0f;
-    return g_createdCubes[index].sx;
+    return g_createdCubes.sx[index];
 }
 
 extern "C" float heidic_get_cube_sy(int index) {
     if (index < 0 || index >= (int)g_createdCubes.size()) return 200.0f;
-    return g_createdCubes[index].sy;
+    return g_createdCubes.sy[index];
 }
 
 extern "C" float heidic_get_cube_sz(int index) {
     if (index < 0 || index >= (int)g_createdCubes.size()) return 200.0f;
-    return g_createdCubes[index].sz;
+    return g_createdCubes.sz[index];
 }
 
 extern "C" int heidic_get_cube_active(int index) {
     if (index < 0 || index >= (int)g_createdCubes.size()) return 0;
-    return g_createdCubes[index].active;
+    return g_createdCubes.active[index];
 }
 
 extern "C" float heidic_get_cube_r(int index) {
     if (index < 0 || index >= (int)g_createdCubes.size()) return 1.0f;
-    return g_createdCubes[index].r;
+    return g_createdCubes.r[index];
 }
 
 extern "C" float heidic_get_cube_g(int index) {
     if (index < 0 || index >= (int)g_createdCubes.size()) return 0.0f;
-    return g_createdCubes[index].g;
+    return g_createdCubes.g[index];
 }
 
 extern "C" float heidic_get_cube_b(int index) {
     if (index < 0 || index >= (int)g_createdCubes.size()) return 0.0f;
-    return g_createdCubes[index].b;
+    return g_createdCubes.b[index];
 }
 
 // Get cube texture name
 extern "C" const char* heidic_get_cube_texture_name(int index) {
     if (index < 0 || index >= (int)g_createdCubes.size()) return "";
-    return g_createdCubes[index].texture_name.c_str();
+    return g_cubeTextureNames[g_createdCubes.textureId[index]].c_str();
 }
 
 // Static variables for texture loading (declared here so they're accessible to texture functions)
 static std::string g_texturesBaseDir = "";  // Base directory for textures
 static std::string g_currentRenderingTextureName = "";  // Currently loaded texture name (for caching)
 
+// ============================================================================
+// COOKED TEXTURES
+// ============================================================================
+// heidic_cook_textures() converts source images offline into <textures>/cooked/<name>.etex: a header,
+// an RGBA8 mip chain, and optionally a BC1 (opaque) or BC3 (alpha) chain of the same levels. The
+// loader memory-maps the file, picks the compressed payload when the device samples it, otherwise
+// the RGBA8 one, and copies the levels straight into upload staging - no decode, no mip generation.
+// A cooked file older than its source is ignored, so stale cooks fall back to stbi_load.
+
+static const uint32_t COOKED_TEXTURE_MAGIC = 0x58455445;  // "ETEX"
+static const uint32_t COOKED_TEXTURE_VERSION = 1;
+static const uint32_t COOKED_TEXTURE_MAX_LEVELS = 16;  // Up to 32768x32768
+static const uint32_t COOKED_TEXTURE_MAX_PAYLOADS = 2;
+
+enum CookedTextureFormat : uint32_t {
+    COOKED_FORMAT_RGBA8 = 0,
+    COOKED_FORMAT_BC1 = 1,  // 8 bytes per 4x4 block, 1-bit alpha
+    COOKED_FORMAT_BC3 = 2,  // 16 bytes per 4x4 block, interpolated alpha
+    COOKED_FORMAT_BC7 = 3   // 16 bytes per 4x4 block (loaded if present; not produced by the cooker)
+};
+
+struct CookedTextureLevel {
+    uint64_t offset;  // From the start of the file
+    uint64_t size;
+};
+
+struct CookedTexturePayload {
+    uint32_t format;  // CookedTextureFormat
+    uint32_t reserved;
+    CookedTextureLevel levels[COOKED_TEXTURE_MAX_LEVELS];
+};
+
+struct CookedTextureHeader {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t width;
+    uint32_t height;
+    uint32_t mipCount;
+    uint32_t payloadCount;  // Preferred payload first
+    uint32_t reserved[2];
+    CookedTexturePayload payloads[COOKED_TEXTURE_MAX_PAYLOADS];
+};
+
+// Read-only file mapping
+struct MappedFile {
+    const unsigned char* data = nullptr;
+    size_t size = 0;
+#ifdef _WIN32
+    HANDLE file = INVALID_HANDLE_VALUE;
+    HANDLE mapping = nullptr;
+#else
+    int fd = -1;
+#endif
+};
+
+static bool mapFile(const std::string& path, MappedFile& out) {
+#ifdef _WIN32
+    out.file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (out.file == INVALID_HANDLE_VALUE) return false;
+    LARGE_INTEGER fileSize;
+    if (!GetFileSizeEx(out.file, &fileSize) || fileSize.QuadPart == 0) {
+        CloseHandle(out.file);
+        out.file = INVALID_HANDLE_VALUE;
+        return false;
+    }
+    out.mapping = CreateFileMappingA(out.file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (out.mapping) {
+        out.data = (const unsigned char*)MapViewOfFile(out.mapping, FILE_MAP_READ, 0, 0, 0);
+    }
+    if (!out.data) {
+        if (out.mapping) CloseHandle(out.mapping);
+        CloseHandle(out.file);
+        out = MappedFile();
+        return false;
+    }
+    out.size = (size_t)fileSize.QuadPart;
+    return true;
+#else
+    out.fd = open(path.c_str(), O_RDONLY);
+    if (out.fd < 0) return false;
+    struct stat st;
+    if (fstat(out.fd, &st) != 0 || st.st_size == 0) {
+        close(out.fd);
+        out.fd = -1;
+        return false;
+    }
+    void* data = mmap(nullptr, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, out.fd, 0);
+    if (data == MAP_FAILED) {
+        close(out.fd);
+        out.fd = -1;
+        return false;
+    }
+    out.data = (const unsigned char*)data;
+    out.size = (size_t)st.st_size;
+    return true;
+#endif
+}
+
+static void unmapFile(MappedFile& file) {
+#ifdef _WIN32
+    if (file.data) UnmapViewOfFile(file.data);
+    if (file.mapping) CloseHandle(file.mapping);
+    if (file.file != INVALID_HANDLE_VALUE) CloseHandle(file.file);
+#else
+    if (file.data) munmap((void*)file.data, file.size);
+    if (file.fd >= 0) close(file.fd);
+#endif
+    file = MappedFile();
+}
+
+static VkFormat cookedTextureVkFormat(uint32_t format) {
+    switch (format) {
+        case COOKED_FORMAT_RGBA8: return VK_FORMAT_R8G8B8A8_UNORM;
+        case COOKED_FORMAT_BC1: return VK_FORMAT_BC1_RGBA_UNORM_BLOCK;
+        case COOKED_FORMAT_BC3: return VK_FORMAT_BC3_UNORM_BLOCK;
+        case COOKED_FORMAT_BC7: return VK_FORMAT_BC7_UNORM_BLOCK;
+        default: return VK_FORMAT_UNDEFINED;
+    }
+}
+
+// Bytes of one level: RGBA8 texels or 4x4 blocks (partial blocks at the edges are padded)
+static uint64_t cookedTextureLevelSize(uint32_t format, uint32_t width, uint32_t height) {
+    if (format == COOKED_FORMAT_RGBA8) return (uint64_t)width * height * 4;
+    uint64_t blocks = (uint64_t)((width + 3) / 4) * ((height + 3) / 4);
+    return blocks * (format == COOKED_FORMAT_BC1 ? 8 : 16);
+}
+
+static bool canSampleCookedFormat(uint32_t format) {
+    VkFormat vkFormat = cookedTextureVkFormat(format);
+    if (vkFormat == VK_FORMAT_UNDEFINED) return false;
+    if (format == COOKED_FORMAT_RGBA8) return true;
+    if (!g_textureCompressionBC) return false;
+    VkFormatProperties props;
+    vkGetPhysicalDeviceFormatProperties(g_physicalDevice, vkFormat, &props);
+    const VkFormatFeatureFlags needed = VK_FORMAT_FEATURE_SAMPLED_IMAGE_BIT | VK_FORMAT_FEATURE_SAMPLED_IMAGE_FILTER_LINEAR_BIT;
+    return (props.optimalTilingFeatures & needed) == needed;
+}
+
+// Cooked file for a source texture path
+static std::string cookedTexturePath(const std::string& sourcePath) {
+    std::filesystem::path source(sourcePath);
+    return (source.parent_path() / "cooked" / (source.filename().string() + ".etex")).string();
+}
+
+// Map the up-to-date cooked file for sourcePath and validate its layout (safe on worker threads)
+static bool openCookedTexture(const std::string& sourcePath, MappedFile& out) {
+    std::string path = cookedTexturePath(sourcePath);
+    std::error_code ec;
+    if (!std::filesystem::exists(path, ec)) return false;
+    if (std::filesystem::exists(sourcePath, ec) &&
+        std::filesystem::last_write_time(path, ec) < std::filesystem::last_write_time(sourcePath, ec)) {
+        return false;  // Source edited since it was cooked
+    }
+    if (!mapFile(path, out)) return false;
+    
+    bool valid = out.size >= sizeof(CookedTextureHeader);
+    const CookedTextureHeader* header = (const CookedTextureHeader*)out.data;
+    if (valid) {
+        valid = header->magic == COOKED_TEXTURE_MAGIC && header->version == COOKED_TEXTURE_VERSION &&
+                header->width > 0 && header->height > 0 &&
+                header->mipCount > 0 && header->mipCount <= COOKED_TEXTURE_MAX_LEVELS &&
+                header->payloadCount > 0 && header->payloadCount <= COOKED_TEXTURE_MAX_PAYLOADS;
+    }
+    for (uint32_t p = 0; valid && p < header->payloadCount; p++) {
+        const CookedTexturePayload& payload = header->payloads[p];
+        for (uint32_t level = 0; valid && level < header->mipCount; level++) {
+            const CookedTextureLevel& l = payload.levels[level];
+            uint32_t w = std::max(header->width >> level, 1u);
+            uint32_t h = std::max(header->height >> level, 1u);
+            valid = l.size == cookedTextureLevelSize(payload.format, w, h) && l.offset <= out.size && l.size <= out.size - l.offset;
+        }
+    }
+    if (!valid) {
+        std::cerr << "[EDEN] Ignoring invalid cooked texture: " << path << std::endl;
+        unmapFile(out);
+        return false;
+    }
+    return true;
+}
+
+// Create the image for a mapped cooked texture and record the copies of its levels into the upload
+// context. Uses the first payload the device can sample; the mapping can be released afterwards.
+static bool createCookedTexture(const MappedFile& file, VkImage& image, GpuAllocation& memory, VkFormat& format) {
+    const CookedTextureHeader* header = (const CookedTextureHeader*)file.data;
+    const CookedTexturePayload* payload = nullptr;
+    for (uint32_t p = 0; p < header->payloadCount && !payload; p++) {
+        if (canSampleCookedFormat(header->payloads[p].format)) payload = &header->payloads[p];
+    }
+    if (!payload) return false;
+    
+    uint32_t mipLevels = g_textureMipmapsEnabled ? header->mipCount : 1;
+    format = cookedTextureVkFormat(payload->format);
+    if (!createTextureImage(header->width, header->height, image, memory, format, mipLevels)) return false;
+    
+    transitionImageLayout(image, VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 0, mipLevels);
+    bool ok = true;
+    for (uint32_t level = 0; level < mipLevels && ok; level++) {
+        const CookedTextureLevel& l = payload->levels[level];
+        ok = copyToImageLevel(image, level, std::max(header->width >> level, 1u), std::max(header->height >> level, 1u),
+                              file.data + l.offset, l.size);
+    }
+    transitionImageLayout(image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, 0, mipLevels);
+    if (!ok) {
+        destroyImage(image, memory);  // Nothing was submitted yet, so it can go right away
+        return false;
+    }
+    return true;
+}
+
+// --- Cooker ---
+
+struct BlockColor {
+    float r, g, b;
+};
+
+static uint16_t packRgb565(float r, float g, float b) {
+    int r5 = std::min(std::max((int)(r * 31.0f / 255.0f + 0.5f), 0), 31);
+    int g6 = std::min(std::max((int)(g * 63.0f / 255.0f + 0.5f), 0), 63);
+    int b5 = std::min(std::max((int)(b * 31.0f / 255.0f + 0.5f), 0), 31);
+    return (uint16_t)((r5 << 11) | (g6 << 5) | b5);
+}
+
+static BlockColor unpackRgb565(uint16_t c) {
+    int r5 = (c >> 11) & 31, g6 = (c >> 5) & 63, b5 = c & 31;
+    return {(float)((r5 << 3) | (r5 >> 2)), (float)((g6 << 2) | (g6 >> 4)), (float)((b5 << 3) | (b5 >> 2))};
+}
+
+// Encode the colors of a 4x4 RGBA block as a 4-color BC1 block: endpoints at the extremes of the
+// principal axis (slightly inset), each texel takes the nearest of the four palette entries
+static void encodeBc1Colors(const unsigned char block[64], unsigned char out[8]) {
+    float mean[3] = {0, 0, 0};
+    for (int i = 0; i < 16; i++) {
+        for (int c = 0; c < 3; c++) mean[c] += block[i * 4 + c];
+    }
+    for (int c = 0; c < 3; c++) mean[c] /= 16.0f;
+    
+    float cov[6] = {0, 0, 0, 0, 0, 0};  // rr rg rb gg gb bb
+    for (int i = 0; i < 16; i++) {
+        float r = block[i * 4] - mean[0], g = block[i * 4 + 1] - mean[1], b = block[i * 4 + 2] - mean[2];
+        cov[0] += r * r; cov[1] += r * g; cov[2] += r * b;
+        cov[3] += g * g; cov[4] += g * b; cov[5] += b * b;
+    }
+    float axis[3] = {1.0f, 1.0f, 1.0f};
+    for (int iter = 0; iter < 8; iter++) {  // Power iteration
+        float x = cov[0] * axis[0] + cov[1] * axis[1] + cov[2] * axis[2];
+        float y = cov[1] * axis[0] + cov[3] * axis[1] + cov[4] * axis[2];
+        float z = cov[2] * axis[0] + cov[4] * axis[1] + cov[5] * axis[2];
+        float len = std::max(std::max(std::fabs(x), std::fabs(y)), std::fabs(z));
+        if (len < 1e-6f) break;  // Flat block
+        axis[0] = x / len; axis[1] = y / len; axis[2] = z / len;
+    }
+    
+    float minProj = FLT_MAX, maxProj = -FLT_MAX;
+    for (int i = 0; i < 16; i++) {
+        float proj = (block[i * 4] - mean[0]) * axis[0] + (block[i * 4 + 1] - mean[1]) * axis[1] + (block[i * 4 + 2] - mean[2]) * axis[2];
+        minProj = std::min(minProj, proj);
+        maxProj = std::max(maxProj, proj);
+    }
+    float axisLenSq = axis[0] * axis[0] + axis[1] * axis[1] + axis[2] * axis[2];
+    float inset = (maxProj - minProj) / 16.0f;
+    float hi = (maxProj - inset) / axisLenSq, lo = (minProj + inset) / axisLenSq;
+    uint16_t c0 = packRgb565(mean[0] + axis[0] * hi, mean[1] + axis[1] * hi, mean[2] + axis[2] * hi);
+    uint16_t c1 = packRgb565(mean[0] + axis[0] * lo, mean[1] + axis[1] * lo, mean[2] + axis[2] * lo);
+    if (c0 < c1) std::swap(c0, c1);  // c0 > c1 selects 4-color mode
+    
+    uint32_t indices = 0;
+    if (c0 != c1) {
+        BlockColor e0 = unpackRgb565(c0), e1 = unpackRgb565(c1);
+        BlockColor palette[4] = {
+            e0, e1,
+            {(2 * e0.r + e1.r) / 3, (2 * e0.g + e1.g) / 3, (2 * e0.b + e1.b) / 3},
+            {(e0.r + 2 * e1.r) / 3, (e0.g + 2 * e1.g) / 3, (e0.b + 2 * e1.b) / 3}
+        };
+        for (int i = 0; i < 16; i++) {
+            uint32_t best = 0;
+            float bestDist = FLT_MAX;
+            for (uint32_t p = 0; p < 4; p++) {
+                float dr = block[i * 4] - palette[p].r, dg = block[i * 4 + 1] - palette[p].g, db = block[i * 4 + 2] - palette[p].b;
+                float dist = dr * dr + dg * dg + db * db;
+                if (dist < bestDist) {
+                    bestDist = dist;
+                    best = p;
+                }
+            }
+            indices |= best << (i * 2);
+        }
+    }
+    out[0] = (unsigned char)(c0 & 0xFF); out[1] = (unsigned char)(c0 >> 8);
+    out[2] = (unsigned char)(c1 & 0xFF); out[3] = (unsigned char)(c1 >> 8);
+    for (int i = 0; i < 4; i++) out[4 + i] = (unsigned char)(indices >> (i * 8));
+}
+
+// Encode the alpha of a 4x4 RGBA block as a BC3 alpha block (8-level mode between min and max)
+static void encodeBc3Alpha(const unsigned char block[64], unsigned char out[8]) {
+    int a0 = 0, a1 = 255;
+    for (int i = 0; i < 16; i++) {
+        a0 = std::max(a0, (int)block[i * 4 + 3]);
+        a1 = std::min(a1, (int)block[i * 4 + 3]);
+    }
+    uint64_t indices = 0;
+    if (a0 != a1) {
+        static const uint64_t paletteIndex[8] = {0, 2, 3, 4, 5, 6, 7, 1};  // Steps from a0 to a1 -> BC3 index
+        for (int i = 0; i < 16; i++) {
+            int step = (int)(((float)(a0 - block[i * 4 + 3]) * 7.0f) / (float)(a0 - a1) + 0.5f);
+            indices |= paletteIndex[step] << (i * 3);
+        }
+    }
+    out[0] = (unsigned char)a0;
+    out[1] = (unsigned char)a1;
+    for (int i = 0; i < 6; i++) out[2 + i] = (unsigned char)(indices >> (i * 8));
+}
+
+// Block-compress one RGBA8 level (edge blocks repeat the last row/column)
+static void compressLevel(const unsigned char* pixels, uint32_t width, uint32_t height, uint32_t format, std::vector<unsigned char>& out) {
+    uint32_t blocksX = (width + 3) / 4, blocksY = (height + 3) / 4;
+    size_t blockBytes = format == COOKED_FORMAT_BC1 ? 8 : 16;
+    out.resize(blocksX * blocksY * blockBytes);
+    unsigned char block[64];
+    for (uint32_t by = 0; by < blocksY; by++) {
+        for (uint32_t bx = 0; bx < blocksX; bx++) {
+            for (uint32_t y = 0; y < 4; y++) {
+                for (uint32_t x = 0; x < 4; x++) {
+                    uint32_t px = std::min(bx * 4 + x, width - 1), py = std::min(by * 4 + y, height - 1);
+                    memcpy(block + (y * 4 + x) * 4, pixels + ((size_t)py * width + px) * 4, 4);
+                }
+            }
+            unsigned char* dst = out.data() + ((size_t)by * blocksX + bx) * blockBytes;
+            if (format == COOKED_FORMAT_BC3) {
+                encodeBc3Alpha(block, dst);
+                dst += 8;
+            }
+            encodeBc1Colors(block, dst);
+        }
+    }
+}
+
+// Cook one image into a .etex file. compress = 1 adds a BC1 (opaque) or BC3 (alpha) payload ahead of
+// the RGBA8 one. Returns 1 on success.
+extern "C" int heidic_cook_texture(const char* source_path, const char* cooked_path, int compress) {
+    if (!source_path || !cooked_path) return 0;
+    int width, height, channels;
+    stbi_uc* pixels = stbi_load(source_path, &width, &height, &channels, STBI_rgb_alpha);
+    if (!pixels) {
+        std::cerr << "[EDEN] Cook: failed to load " << source_path << std::endl;
+        return 0;
+    }
+    
+    // RGBA8 chain (2x2 box filter, same as the runtime CPU fallback)
+    std::vector<std::vector<unsigned char>> levels;
+    levels.emplace_back(pixels, pixels + (size_t)width * height * 4);
+    stbi_image_free(pixels);
+    uint32_t mipCount = 1;
+    for (uint32_t w = (uint32_t)width, h = (uint32_t)height; (w > 1 || h > 1) && mipCount < COOKED_TEXTURE_MAX_LEVELS; mipCount++) {
+        uint32_t nw = std::max(w / 2, 1u), nh = std::max(h / 2, 1u);
+        std::vector<unsigned char> next((size_t)nw * nh * 4);
+        downsampleRgba8(levels.back().data(), w, h, next.data(), nw, nh);
+        levels.push_back(std::move(next));
+        w = nw;
+        h = nh;
+    }
+    
+    std::vector<uint32_t> formats;
+    if (compress) {
+        bool hasAlpha = false;
+        for (size_t i = 3; i < levels[0].size() && !hasAlpha; i += 4) hasAlpha = levels[0][i] != 255;
+        formats.push_back(hasAlpha ? COOKED_FORMAT_BC3 : COOKED_FORMAT_BC1);
+    }
+    formats.push_back(COOKED_FORMAT_RGBA8);  // Fallback for devices without BC sampling
+    
+    CookedTextureHeader header = {};
+    header.magic = COOKED_TEXTURE_MAGIC;
+    header.version = COOKED_TEXTURE_VERSION;
+    header.width = (uint32_t)width;
+    header.height = (uint32_t)height;
+    header.mipCount = mipCount;
+    header.payloadCount = (uint32_t)formats.size();
+    
+    std::vector<unsigned char> data;  // Level data after the header, 16-byte aligned
+    std::vector<unsigned char> compressed;
+    for (size_t p = 0; p < formats.size(); p++) {
+        header.payloads[p].format = formats[p];
+        for (uint32_t level = 0; level < mipCount; level++) {
+            uint32_t w = std::max((uint32_t)width >> level, 1u), h = std::max((uint32_t)height >> level, 1u);
+            const std::vector<unsigned char>* bytes = &levels[level];
+            if (formats[p] != COOKED_FORMAT_RGBA8) {
+                compressLevel(levels[level].data(), w, h, formats[p], compressed);
+                bytes = &compressed;
+            }
+            data.resize((data.size() + 15) & ~(size_t)15);
+            header.payloads[p].levels[level].offset = sizeof(CookedTextureHeader) + data.size();
+            header.payloads[p].levels[level].size = bytes->size();
+            data.insert(data.end(), bytes->begin(), bytes->end());
+        }
+    }
+    
+    std::error_code ec;
+    std::filesystem::create_directories(std::filesystem::path(cooked_path).parent_path(), ec);
+    std::ofstream file(cooked_path, std::ios::binary | std::ios::trunc);
+    if (!file) {
+        std::cerr << "[EDEN] Cook: cannot write " << cooked_path << std::endl;
+        return 0;
+    }
+    file.write((const char*)&header, sizeof(header));
+    file.write((const char*)data.data(), (std::streamsize)data.size());
+    return file.good() ? 1 : 0;
+}
+
+// Cook every .bmp in a textures directory (empty = the directory heidic_load_texture_list() found)
+// into its cooked/ subdirectory, skipping textures whose cook is up to date. Returns the number cooked.
+extern "C" int heidic_cook_textures(const char* textures_dir, int compress) {
+    std::string dir = textures_dir ? textures_dir : "";
+    if (dir.empty()) {
+        if (g_texturesBaseDir.empty()) heidic_load_texture_list();
+        dir = g_texturesBaseDir;
+    }
+    if (dir.empty()) return 0;
+    
+    int cooked = 0;
+    std::error_code ec;
+    for (const auto& entry : std::filesystem::directory_iterator(dir, ec)) {
+        if (!entry.is_regular_file()) continue;
+        std::string source = entry.path().string();
+        std::string lower = entry.path().extension().string();
+        std::transform(lower.begin(), lower.end(), lower.begin(), ::tolower);
+        if (lower != ".bmp") continue;
+        
+        std::string target = cookedTexturePath(source);
+        if (std::filesystem::exists(target, ec) &&
+            std::filesystem::last_write_time(target, ec) >= std::filesystem::last_write_time(source, ec)) {
+            continue;
+        }
+        if (heidic_cook_texture(source.c_str(), target.c_str(), compress)) {
+            cooked++;
+        }
+    }
+    std::cout << "[EDEN] Cooked " << cooked << " textures in " << dir << std::endl;
+    return cooked;
+}
+
+// ============================================================================
+// TEXTURE RESIDENCY
+// ============================================================================
+// Cached textures are kept under a memory budget (palette thumbnails live in small atlas pages
+// and are not counted against it beyond their pages). Each use stamps the frame
+// number; once sampled texture memory exceeds the budget, evictTextures() (from heidic_begin_frame())
+// releases least-recently-used entries whose last frame and upload have completed on the GPU.
+// Evicted cache entries stay in g_textureCache (static buckets and the current texture point at
+// them) and are reloaded transparently by their next heidic_load_texture_for_rendering().
+
+static const uint32_t TEXTURE_BUDGET_DEFAULT_MB = 256;
+
+static VkDeviceSize g_textureBudgetBytes = (VkDeviceSize)TEXTURE_BUDGET_DEFAULT_MB * 1024 * 1024;  // 0 = unlimited
+static uint32_t g_textureCacheHits = 0;       // Lookups served by a resident (or streaming) texture
+static uint32_t g_textureCacheMisses = 0;     // Lookups that had to load (first use or after eviction)
+static uint32_t g_textureCacheEvictions = 0;  // Textures released by the budget
+
+// ============================================================================
+// TEXTURE STREAMING
+// ============================================================================
+// The first heidic_load_texture_for_rendering() of a texture no longer stalls the frame: worker
+// threads decode the file, heidic_begin_frame() records a budgeted batch of decoded textures into the
+// upload context, and the default texture is bound until that upload's serial has completed.
+
+static const int TEXTURE_STREAM_WORKERS = 2;
+static const int TEXTURE_STREAM_UPLOADS_PER_FRAME = 8;                       // Max textures per batch
+static const VkDeviceSize TEXTURE_STREAM_BYTES_PER_FRAME = 16 * 1024 * 1024;  // Staging budget per batch
+
+struct TextureDecodeJob {
+    std::string name;
+    std::string path;
+};
+
+struct TextureDecodeResult {
+    std::string name;
+    std::string path;
+    MappedFile cooked;          // Up-to-date cooked texture (mapped, nothing decoded)
+    stbi_uc* pixels = nullptr;  // Decoded source otherwise (nullptr and no cooked file = failed)
+    int width = 0;
+    int height = 0;
+};
+
+// Every texture in a batch becomes resident once its upload serial completes
+struct TextureUploadBatch {
+    uint64_t uploadSerial = 0;
+    std::vector<std::string> names;
+};
+
+static bool g_textureStreamingEnabled = true;
+static std::vector<std::thread> g_textureStreamWorkers;
+static std::mutex g_textureStreamMutex;  // Guards the two queues and the shutdown flag
+static std::condition_variable g_textureStreamWake;
+static std::deque<TextureDecodeJob> g_textureDecodeJobs;
+static std::deque<TextureDecodeResult> g_textureDecodeResults;
+static bool g_textureStreamShutdown = false;
+static std::vector<TextureUploadBatch> g_textureUploadBatches;
+static uint32_t g_texturesStreaming = 0;  // Requested and not yet resident (or failed)
+
+static void textureStreamWorker() {
+    for (;;) {
+        TextureDecodeJob job;
+        {
+            std::unique_lock<std::mutex> lock(g_textureStreamMutex);
+            g_textureStreamWake.wait(lock, [] { return g_textureStreamShutdown || !g_textureDecodeJobs.empty(); });
+            if (g_textureStreamShutdown) return;
+            job = std::move(g_textureDecodeJobs.front());
+            g_textureDecodeJobs.pop_front();
+        }
+        
+        TextureDecodeResult result;
+        result.name = job.name;
+        result.path = job.path;
+        if (!openCookedTexture(job.path, result.cooked)) {
+            int channels = 0;
+            result.pixels = stbi_load(job.path.c_str(), &result.width, &result.height, &channels, STBI_rgb_alpha);
+            if (!result.pixels) {
+                std::cerr << "[EDEN] Failed to load texture for rendering: " << job.path << std::endl;
+            }
+        }
+        
+        std::lock_guard<std::mutex> lock(g_textureStreamMutex);
+        g_textureDecodeResults.push_back(std::move(result));
+    }
+}
+
+// Queue a texture for decoding (the workers are started on first use)
+static void requestTextureStream(const std::string& name, const std::string& path) {
+    if (g_textureStreamWorkers.empty()) {
+        g_textureStreamShutdown = false;
+        for (int i = 0; i < TEXTURE_STREAM_WORKERS; i++) {
+            g_textureStreamWorkers.emplace_back(textureStreamWorker);
+        }
+    }
+    {
+        std::lock_guard<std::mutex> lock(g_textureStreamMutex);
+        g_textureDecodeJobs.push_back({name, path});
+    }
+    g_textureStreamWake.notify_one();
+    g_texturesStreaming++;
+}
+
+// Point the current-texture globals at a cache entry (placeholder slot while it is streaming)
+static void selectCachedTexture(TextureResource& entry, const std::string& name) {
+    if (entry.resident) {
+        g_textureImage = entry.image;
+        g_textureImageMemory = entry.memory;
+        g_textureImageView = entry.view;
+    }
+    g_currentTexture = &entry;
+    g_currentTextureSlot = entry.slot;
+    g_currentRenderingTextureName = name;
+    entry.lastUsedSerial = nextSubmitSerial();
+}
+
+// Make every texture of a completed batch resident
+static void completeTextureUploadBatch(TextureUploadBatch& batch) {
+    for (const std::string& name : batch.names) {
+        auto it = g_textureCache.find(name);
+        if (it == g_textureCache.end()) continue;
+        TextureResource& entry = it->second;
+        
+        entry.view = createTextureView(entry.image, entry.format);
+        entry.slot = registerTextureSlot(entry.view);
+        entry.resident = true;
+        g_texturesStreaming--;
+        
+        // Draws issued from now on pick up the real texture
+        if (g_currentTexture == &entry) {
+            selectCachedTexture(entry, name);
+        }
+    }
+}
+
+// Create images for decoded textures and record their uploads (submitted with the frame's uploads)
+static void recordTextureUploadBatch(std::vector<TextureDecodeResult>& decoded) {
+    TextureUploadBatch batch;
+    batch.uploadSerial = pendingUploadSerial();
+    for (TextureDecodeResult& result : decoded) {
+        TextureResource& entry = g_textureCache[result.name];
+        if (result.cooked.data) {
+            bool uploaded = createCookedTexture(result.cooked, entry.image, entry.memory, entry.format);
+            unmapFile(result.cooked);  // Levels are in staging now
+            if (uploaded) {
+                entry.uploadSerial = batch.uploadSerial;
+                batch.names.push_back(result.name);
+                continue;
+            }
+            // No payload this device can sample - decode the source instead
+            int channels = 0;
+            result.pixels = stbi_load(result.path.c_str(), &result.width, &result.height, &channels, STBI_rgb_alpha);
+        }
+        entry.format = VK_FORMAT_R8G8B8A8_UNORM;
+        bool created = result.pixels && createTextureImage((uint32_t)result.width, (uint32_t)result.height, entry.image, entry.memory);
+        if (created && uploadToImage(entry.image, (uint32_t)result.width, (uint32_t)result.height, result.pixels)) {
+            entry.uploadSerial = batch.uploadSerial;
+            batch.names.push_back(result.name);
+        } else {
+            if (created) {
+                destroyImage(entry.image, entry.memory);
+            }
+            entry.failed = true;
+            g_texturesStreaming--;
+        }
+        if (result.pixels) stbi_image_free(result.pixels);
+        result.pixels = nullptr;
+    }
+    if (!batch.names.empty()) {
+        g_textureUploadBatches.push_back(batch);
+    }
+}
+
+// Called once per frame from heidic_begin_frame() (after collectUploads()): finish completed batches,
+// then upload what the workers have decoded since the last frame (bounded by count and bytes so
+// frame time stays flat)
+static void pumpTextureStreaming() {
+    size_t kept = 0;
+    for (size_t i = 0; i < g_textureUploadBatches.size(); i++) {
+        TextureUploadBatch& batch = g_textureUploadBatches[i];
+        if (isUploadSerialComplete(batch.uploadSerial)) {
+            completeTextureUploadBatch(batch);
+        } else {
+            g_textureUploadBatches[kept++] = std::move(batch);
+        }
+    }
+    g_textureUploadBatches.resize(kept);
+    
+    if (g_texturesStreaming == 0) return;
+    
+    std::vector<TextureDecodeResult> decoded;
+    {
+        std::lock_guard<std::mutex> lock(g_textureStreamMutex);
+        VkDeviceSize budget = 0;
+        while (!g_textureDecodeResults.empty() && (int)decoded.size() < TEXTURE_STREAM_UPLOADS_PER_FRAME) {
+            TextureDecodeResult& next = g_textureDecodeResults.front();
+            VkDeviceSize size = next.cooked.data ? (VkDeviceSize)next.cooked.size : (VkDeviceSize)next.width * next.height * 4;
+            if (!decoded.empty() && budget + size > TEXTURE_STREAM_BYTES_PER_FRAME) break;  // Next frame
+            budget += size;
+            decoded.push_back(std::move(next));
+            g_textureDecodeResults.pop_front();
+        }
+    }
+    
+    // Failed decodes stay in the cache as failed entries (drawn with the default texture)
+    size_t valid = 0;
+    for (size_t i = 0; i < decoded.size(); i++) {
+        if (!decoded[i].pixels && !decoded[i].cooked.data) {
+            g_textureCache[decoded[i].name].failed = true;
+            g_texturesStreaming--;
+        } else {
+            decoded[valid++] = std::move(decoded[i]);
+        }
+    }
+    decoded.resize(valid);
+    
+    if (!decoded.empty()) {
+        recordTextureUploadBatch(decoded);
+    }
+}
+
+// Stop the workers and release everything still in flight (uploads must be finished)
+static void shutdownTextureStreaming() {
+    {
+        std::lock_guard<std::mutex> lock(g_textureStreamMutex);
+        g_textureStreamShutdown = true;
+    }
+    g_textureStreamWake.notify_all();
+    for (std::thread& worker : g_textureStreamWorkers) {
+        worker.join();
+    }
+    g_textureStreamWorkers.clear();
+    
+    for (TextureUploadBatch& batch : g_textureUploadBatches) {
+        completeTextureUploadBatch(batch);
+    }
+    g_textureUploadBatches.clear();
+    for (TextureDecodeResult& result : g_textureDecodeResults) {
+        if (result.pixels) stbi_image_free(result.pixels);
+        unmapFile(result.cooked);
+    }
+    g_textureDecodeResults.clear();
+    g_textureDecodeJobs.clear();
+}
+
+// Enable/disable background streaming (disabled = decode and upload inside heidic_load_texture_for_rendering)
+extern "C" void heidic_set_texture_streaming(int enabled) {
+    g_textureStreamingEnabled = enabled != 0;
+}
+
+// Textures requested but not yet resident (0 once a level's textures have all streamed in)
+extern "C" int heidic_get_pending_texture_count() {
+    return static_cast<int>(g_texturesStreaming);
+}
+
 // Load texture file and update global texture (for cube rendering)
-// Returns 1 on success, 0 on failure
+// Returns 1 on success (the texture may still be streaming in), 0 on failure
 extern "C" int heidic_load_texture_for_rendering(const char* texture_name) {
     if (!texture_name || strlen(texture_name) == 0) {
         // Use default texture
@@ -3644,16 +6991,28 @@ extern "C" int heidic_load_texture_for_rendering(const char* texture_name) {
     
     // Check texture cache first
     auto cacheIt = g_textureCache.find(texture_name);
-    if (cacheIt != g_textureCache.end()) {
-        // Found in cache - use cached texture
-        g_textureImage = cacheIt->second.image;
-        g_textureImageMemory = cacheIt->second.memory;
-        g_textureImageView = cacheIt->second.view;
-        g_currentRenderingTextureName = texture_name;
-        return 1;  // Success - texture already loaded
+    if (cacheIt != g_textureCache.end() && !cacheIt->second.evicted) {
+        // Found in cache - use cached texture (or the default one until it is resident)
+        if (cacheIt->second.failed) return 0;
+        g_textureCacheHits++;
+        selectCachedTexture(cacheIt->second, texture_name);
+        return 1;  // Success - texture already loaded or streaming
+    }
+    g_textureCacheMisses++;
+    
+    if (g_nullRenderer) {
+        // No device: a resident entry with placeholder sets, so batches still split per texture
+        TextureResource& entry = g_textureCache[texture_name];
+        entry = TextureResource();
+        entry.resident = true;
+        for (uint32_t i = 0; i < g_maxFramesInFlight; i++) {
+            entry.descriptorSets.push_back(nullRendererHandle<VkDescriptorSet>());
+        }
+        selectCachedTexture(entry, texture_name);
+        return 1;
     }
     
-    // Not in cache - load from disk
+    // Not in cache (or evicted) - load from disk into the same entry
     if (g_texturesBaseDir.empty()) {
         heidic_load_texture_list();
     }
@@ -3661,166 +7020,918 @@ extern "C" int heidic_load_texture_for_rendering(const char* texture_name) {
     
     std::string full_path = g_texturesBaseDir + "/" + texture_name;
     
-    // Load texture
-    int texWidth, texHeight, texChannels;
-    stbi_uc* pixels = stbi_load(full_path.c_str(), &texWidth, &texHeight, &texChannels, STBI_rgb_alpha);
-    if (!pixels) {
-        std::cerr << "[EDEN] Failed to load texture for rendering: " << full_path << std::endl;
-        return 0;
+    if (g_textureStreamingEnabled) {
+        // Decode on a worker, upload from heidic_begin_frame(); draws use the default texture until then
+        TextureResource& entry = g_textureCache[texture_name];
+        entry.resident = false;
+        entry.evicted = false;
+        requestTextureStream(texture_name, full_path);
+        selectCachedTexture(entry, texture_name);
+        return 1;
     }
     
-    // Create new texture (similar to createTextureAndDescriptors)
-    VkDeviceSize imageSize = (VkDeviceSize)(texWidth) * texHeight * 4;
-    
-    // Create staging buffer
-    VkBuffer stagingBuffer;
-    VkDeviceMemory stagingBufferMemory;
-    createBuffer(imageSize, VK_BUFFER_USAGE_TRANSFER_SRC_BIT, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT, stagingBuffer, stagingBufferMemory);
-    
-    void* data;
-    vkMapMemory(g_device, stagingBufferMemory, 0, imageSize, 0, &data);
-    memcpy(data, pixels, (size_t)imageSize);
-    vkUnmapMemory(g_device, stagingBufferMemory);
-    stbi_image_free(pixels);
-    
-    // Create image
-    VkImageCreateInfo imageInfo = {};
-    imageInfo.sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
-    imageInfo.imageType = VK_IMAGE_TYPE_2D;
-    imageInfo.extent.width = texWidth;
-    imageInfo.extent.height = texHeight;
-    imageInfo.extent.depth = 1;
-    imageInfo.mipLevels = 1;
-    imageInfo.arrayLayers = 1;
-    imageInfo.format = VK_FORMAT_R8G8B8A8_UNORM;
-    imageInfo.tiling = VK_IMAGE_TILING_OPTIMAL;
-    imageInfo.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
-    imageInfo.usage = VK_IMAGE_USAGE_TRANSFER_DST_BIT | VK_IMAGE_USAGE_SAMPLED_BIT;
-    imageInfo.samples = VK_SAMPLE_COUNT_1_BIT;
-    imageInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
-    
-    vkCreateImage(g_device, &imageInfo, nullptr, &g_textureImage);
-    
-    VkMemoryRequirements memRequirements;
-    vkGetImageMemoryRequirements(g_device, g_textureImage, &memRequirements);
-    
-    VkMemoryAllocateInfo allocInfo = {};
-    allocInfo.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
-    allocInfo.allocationSize = memRequirements.size;
-    allocInfo.memoryTypeIndex = findMemoryType(memRequirements.memoryTypeBits, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
-    
-    vkAllocateMemory(g_device, &allocInfo, nullptr, &g_textureImageMemory);
-    vkBindImageMemory(g_device, g_textureImage, g_textureImageMemory, 0);
-    
-    // Transition and copy
-    transitionImageLayout(g_textureImage, imageInfo.format, VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL);
-    
-    VkCommandBufferAllocateInfo cbAlloc = {};
-    cbAlloc.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
-    cbAlloc.commandPool = g_commandPool;
-    cbAlloc.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
-    cbAlloc.commandBufferCount = 1;
-    
-    VkCommandBuffer cmd;
-    vkAllocateCommandBuffers(g_device, &cbAlloc, &cmd);
-    
-    VkCommandBufferBeginInfo beginInfo = {};
-    beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
-    beginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
-    vkBeginCommandBuffer(cmd, &beginInfo);
-    
-    VkBufferImageCopy region = {};
-    region.bufferOffset = 0;
-    region.bufferRowLength = 0;
-    region.bufferImageHeight = 0;
-    region.imageSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
-    region.imageSubresource.mipLevel = 0;
-    region.imageSubresource.baseArrayLayer = 0;
-    region.imageSubresource.layerCount = 1;
-    region.imageOffset = {0, 0, 0};
-    region.imageExtent = {(uint32_t)texWidth, (uint32_t)texHeight, 1};
-    
-    vkCmdCopyBufferToImage(cmd, stagingBuffer, g_textureImage, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1, &region);
-    
-    vkEndCommandBuffer(cmd);
-    
-    VkSubmitInfo submitInfo = {};
-    submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
-    submitInfo.commandBufferCount = 1;
-    submitInfo.pCommandBuffers = &cmd;
-    vkQueueSubmit(g_graphicsQueue, 1, &submitInfo, VK_NULL_HANDLE);
-    vkQueueWaitIdle(g_graphicsQueue);
+    // Create new texture; the copy is recorded into the upload context and submitted ahead of this frame
+    VkImage image;
+    GpuAllocation imageMemory;
+    VkFormat format = VK_FORMAT_R8G8B8A8_UNORM;
+    MappedFile cookedFile;
+    bool cooked = false;
+    if (openCookedTexture(full_path, cookedFile)) {
+        cooked = createCookedTexture(cookedFile, image, imageMemory, format);
+        unmapFile(cookedFile);
+    }
+    if (!cooked) {
+        int texWidth, texHeight, texChannels;
+        stbi_uc* pixels = stbi_load(full_path.c_str(), &texWidth, &texHeight, &texChannels, STBI_rgb_alpha);
+        if (!pixels) {
+            std::cerr << "[EDEN] Failed to load texture for rendering: " << full_path << std::endl;
+            return 0;
+        }
+        format = VK_FORMAT_R8G8B8A8_UNORM;
+        if (!createTextureImage((uint32_t)texWidth, (uint32_t)texHeight, image, imageMemory)) {
+            stbi_image_free(pixels);
+            return 0;
+        }
+        uploadToImage(image, (uint32_t)texWidth, (uint32_t)texHeight, pixels);
+        stbi_image_free(pixels);
+    }
     
-    vkFreeCommandBuffers(g_device, g_commandPool, 1, &cmd);
+    VkImageView newTextureImageView = createTextureView(image, format);
     
-    transitionImageLayout(g_textureImage, imageInfo.format, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
+    // Store in cache (kept until the residency budget evicts it)
+    TextureResource cached;
+    cached.image = image;
+    cached.memory = imageMemory;
+    cached.view = newTextureImageView;
+    cached.format = format;
+    cached.slot = registerTextureSlot(newTextureImageView);  // Written into the texture table once, here
+    cached.uploadSerial = pendingUploadSerial();
+    TextureResource& entry = g_textureCache[texture_name];
+    entry = cached;
     
-    vkDestroyBuffer(g_device, stagingBuffer, nullptr);
-    vkFreeMemory(g_device, stagingBufferMemory, nullptr);
+    // Update global handles to point to cached texture
+    selectCachedTexture(entry, texture_name);
     
-    // Create image view
-    VkImageViewCreateInfo viewInfo = {};
-    viewInfo.sType = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
-    viewInfo.image = g_textureImage;
-    viewInfo.viewType = VK_IMAGE_VIEW_TYPE_2D;
-    viewInfo.format = imageInfo.format;
-    viewInfo.subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
-    viewInfo.subresourceRange.baseMipLevel = 0;
-    viewInfo.subresourceRange.levelCount = 1;
-    viewInfo.subresourceRange.baseArrayLayer = 0;
-    viewInfo.subresourceRange.layerCount = 1;
+    // NOTE: Descriptor sets are never rewritten per batch. With bindless the texture is reached
+    // through its slot; otherwise heidic_flush_colored_cubes() binds this texture's own sets.
     
-    VkImageView newTextureImageView;
-    vkCreateImageView(g_device, &viewInfo, nullptr, &newTextureImageView);
+    return 1;
+}
+
+extern "C" void heidic_set_cube_pos(int index, float x, float y, float z) {
+    if (index < 0 || index >= (int)g_createdCubes.size()) return;
+    CubeStore& cubes = g_createdCubes;
+    if (cubes.x[index] == x && cubes.y[index] == y && cubes.z[index] == z) return;  // Unchanged - keep the baked geometry
+    cubes.x[index] = x;
+    cubes.y[index] = y;
+    cubes.z[index] = z;
+    if (cubes.active[index] == 1) {
+        markStaticCubeDirty(index);
+        sceneBvhCubeChanged(index);
+    }
+}
+
+// Overload that accepts float index (for HEIDIC compatibility)
+extern "C" void heidic_set_cube_pos_f(float index_f, float x, float y, float z) {
+    int index = (int)index_f;
+    if (index < 0 || index >= (int)g_createdCubes.size()) return;
+    CubeStore& cubes = g_createdCubes;
+    if (cubes.x[index] == x && cubes.y[index] == y && cubes.z[index] == z) return;  // Unchanged - keep the baked geometry
+    cubes.x[index] = x;
+    cubes.y[index] = y;
+    cubes.z[index] = z;
+    if (cubes.active[index] == 1) {
+        markStaticCubeDirty(index);
+        sceneBvhCubeChanged(index);
+    }
+}
+
+extern "C" void heidic_delete_cube(int index) {
+    if (index < 0 || index >= (int)g_createdCubes.size()) return;
+    if (g_createdCubes.active[index] != 1) return;
+    markStaticCubeDirty(index);
+    g_createdCubes.remove((uint32_t)index);
+    sceneBvhCubeChanged(index);
+    g_selectedCubeIndices.erase(index);  // The slot will be reused by the next created cube
+}
+
+// Storage index of the n-th active cube (0 <= n < heidic_get_cube_count()), -1 if out of range.
+// The order is arbitrary and changes when cubes are deleted, so walk it within one frame.
+extern "C" int heidic_get_live_cube_index(int n) {
+    if (n < 0 || n >= (int)g_createdCubes.live.size()) return -1;
+    return (int)g_createdCubes.live[n];
+}
+
+// Handle for a cube that stays unique after the cube is deleted and its slot reused; -1 if the
+// index is not an active cube
+extern "C" int heidic_get_cube_handle(int index) {
+    if (index < 0 || index >= (int)g_createdCubes.size() || g_createdCubes.active[index] != 1) return -1;
+    if ((uint32_t)index > CUBE_HANDLE_SLOT_MASK) return -1;
+    uint32_t generation = g_createdCubes.generation[index] & CUBE_HANDLE_GENERATION_MASK;
+    return (int)((generation << CUBE_HANDLE_SLOT_BITS) | (uint32_t)index);
+}
+
+// Storage index of the cube a handle refers to, or -1 if that cube has been deleted
+extern "C" int heidic_get_cube_index_from_handle(int handle) {
+    if (handle < 0) return -1;
+    uint32_t slot = (uint32_t)handle & CUBE_HANDLE_SLOT_MASK;
+    uint32_t generation = (uint32_t)handle >> CUBE_HANDLE_SLOT_BITS;
+    if (slot >= g_createdCubes.size() || g_createdCubes.active[slot] != 1) return -1;
+    if ((g_createdCubes.generation[slot] & CUBE_HANDLE_GENERATION_MASK) != generation) return -1;
+    return (int)slot;
+}
+
+extern "C" int heidic_find_next_active_cube_index(int start_index) {
+    // Lowest active slot >= start_index; walks the live list, so deleted slots cost nothing
+    int best = -1;
+    for (uint32_t slot : g_createdCubes.live) {
+        int i = (int)slot;
+        if (i >= start_index && (best < 0 || i < best)) {
+            best = i;
+        }
+    }
+    return best;  // -1 = no more active cubes
+}
+
+// ============================================================================
+// RAY-BOX KERNEL
+// ============================================================================
+// Nearest-hit slab test of one ray against a run of boxes stored as SoA min/max arrays, used by
+// the scene raycast for both the every-cube path and the BVH leaves. The inverse direction is
+// computed once per ray, and each axis reads its near and far planes from the min or max array
+// by the sign of the direction, so a box needs no per-axis min/max. An empty box (min > max)
+// never hits; deleted cubes are stored that way. The AVX2 path tests 8 boxes per iteration, SSE
+// 4, with a scalar tail. AVX2 is compiled with a function target attribute and picked at runtime
+// from CPUID, so it does not need -mavx2 / /arch:AVX2; EDEN_NO_SIMD forces the scalar path.
+
+struct BoxSoA {
+    std::vector<float> minX, minY, minZ;
+    std::vector<float> maxX, maxY, maxZ;
+    
+    size_t size() const { return minX.size(); }
+    void clear() {
+        minX.clear(); minY.clear(); minZ.clear();
+        maxX.clear(); maxY.clear(); maxZ.clear();
+    }
+    // New boxes are empty
+    void resize(size_t count) {
+        minX.resize(count, FLT_MAX); minY.resize(count, FLT_MAX); minZ.resize(count, FLT_MAX);
+        maxX.resize(count, -FLT_MAX); maxY.resize(count, -FLT_MAX); maxZ.resize(count, -FLT_MAX);
+    }
+    void set(size_t i, const glm::vec3& boundsMin, const glm::vec3& boundsMax) {
+        minX[i] = boundsMin.x; minY[i] = boundsMin.y; minZ[i] = boundsMin.z;
+        maxX[i] = boundsMax.x; maxY[i] = boundsMax.y; maxZ[i] = boundsMax.z;
+    }
+    void setEmpty(size_t i) {
+        set(i, glm::vec3(FLT_MAX), glm::vec3(-FLT_MAX));
+    }
+};
+
+static const uint32_t RAY_BOX_NONE = 0xFFFFFFFFu;
+
+// Same epsilon handling as rayAABB(), computed once per ray instead of once per box
+static glm::vec3 rayInverseDir(const glm::vec3& dir) {
+    const float epsilon = 1e-6f;
+    glm::vec3 invDir;
+    for (int i = 0; i < 3; i++) {
+        invDir[i] = (fabsf(dir[i]) < epsilon) ? (dir[i] >= 0.0f ? 1e6f : -1e6f) : (1.0f / dir[i]);
+    }
+    return invDir;
+}
+
+// Per-ray setup shared by every kernel: origin, inverse direction and the near/far plane arrays
+struct RayBoxQuery {
+    float origin[3];
+    float invDir[3];
+    const float* nearPlanes[3];
+    const float* farPlanes[3];
+};
+
+static RayBoxQuery makeRayBoxQuery(const glm::vec3& origin, const glm::vec3& invDir, const BoxSoA& boxes) {
+    RayBoxQuery query;
+    const std::vector<float>* mins[3] = {&boxes.minX, &boxes.minY, &boxes.minZ};
+    const std::vector<float>* maxs[3] = {&boxes.maxX, &boxes.maxY, &boxes.maxZ};
+    for (int i = 0; i < 3; i++) {
+        query.origin[i] = origin[i];
+        query.invDir[i] = invDir[i];
+        query.nearPlanes[i] = (invDir[i] >= 0.0f ? mins[i] : maxs[i])->data();
+        query.farPlanes[i] = (invDir[i] >= 0.0f ? maxs[i] : mins[i])->data();
+    }
+    return query;
+}
+
+// Boxes [begin, end): keeps the nearest entry distance <= closest in closest/nearest. The first
+// hit may equal closest, later ones must be strictly nearer, so ties go to the lower index.
+typedef void (*RayBoxesKernel)(const RayBoxQuery& query, uint32_t begin, uint32_t end, float& closest, uint32_t& nearest);
+
+static void rayBoxesScalar(const RayBoxQuery& query, uint32_t begin, uint32_t end, float& closest, uint32_t& nearest) {
+    for (uint32_t i = begin; i < end; i++) {
+        float tMin = 0.0f;
+        float tMax = closest;
+        for (int axis = 0; axis < 3; axis++) {
+            tMin = std::max(tMin, (query.nearPlanes[axis][i] - query.origin[axis]) * query.invDir[axis]);
+            tMax = std::min(tMax, (query.farPlanes[axis][i] - query.origin[axis]) * query.invDir[axis]);
+        }
+        if (tMin <= tMax && (nearest == RAY_BOX_NONE || tMin < closest)) {
+            closest = tMin;
+            nearest = i;
+        }
+    }
+}
+
+#if defined(EDEN_SIMD_AVX) || defined(EDEN_SIMD_SSE) || defined(EDEN_SIMD_AVX2_DISPATCH)
+// Scalar pass over the lanes that hit: tEntry holds the batch's entry distances
+static void rayBoxesResolveLanes(int mask, const float* tEntry, uint32_t base, float& closest, uint32_t& nearest) {
+    for (int k = 0; mask != 0; k++, mask >>= 1) {
+        if ((mask & 1) && tEntry[k] <= closest && (nearest == RAY_BOX_NONE || tEntry[k] < closest)) {
+            closest = tEntry[k];
+            nearest = base + k;
+        }
+    }
+}
+#endif
+
+#if defined(EDEN_SIMD_AVX) || defined(EDEN_SIMD_SSE)
+static void rayBoxesSse(const RayBoxQuery& query, uint32_t begin, uint32_t end, float& closest, uint32_t& nearest) {
+    __m128 origin[3], invDir[3];
+    for (int axis = 0; axis < 3; axis++) {
+        origin[axis] = _mm_set1_ps(query.origin[axis]);
+        invDir[axis] = _mm_set1_ps(query.invDir[axis]);
+    }
+    uint32_t i = begin;
+    for (; i + 4 <= end; i += 4) {
+        __m128 tMin = _mm_setzero_ps();
+        __m128 tMax = _mm_set1_ps(closest);
+        for (int axis = 0; axis < 3; axis++) {
+            tMin = _mm_max_ps(tMin, _mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(query.nearPlanes[axis] + i), origin[axis]), invDir[axis]));
+            tMax = _mm_min_ps(tMax, _mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(query.farPlanes[axis] + i), origin[axis]), invDir[axis]));
+        }
+        int mask = _mm_movemask_ps(_mm_cmple_ps(tMin, tMax));
+        if (mask != 0) {
+            alignas(16) float tEntry[4];
+            _mm_store_ps(tEntry, tMin);
+            rayBoxesResolveLanes(mask, tEntry, i, closest, nearest);
+        }
+    }
+    rayBoxesScalar(query, i, end, closest, nearest);
+}
+#endif
+
+#if defined(EDEN_SIMD_AVX2_DISPATCH)
+EDEN_TARGET_AVX2 static void rayBoxesAvx2(const RayBoxQuery& query, uint32_t begin, uint32_t end, float& closest, uint32_t& nearest) {
+    __m256 origin[3], invDir[3];
+    for (int axis = 0; axis < 3; axis++) {
+        origin[axis] = _mm256_set1_ps(query.origin[axis]);
+        invDir[axis] = _mm256_set1_ps(query.invDir[axis]);
+    }
+    uint32_t i = begin;
+    for (; i + 8 <= end; i += 8) {
+        __m256 tMin = _mm256_setzero_ps();
+        __m256 tMax = _mm256_set1_ps(closest);
+        for (int axis = 0; axis < 3; axis++) {
+            tMin = _mm256_max_ps(tMin, _mm256_mul_ps(_mm256_sub_ps(_mm256_loadu_ps(query.nearPlanes[axis] + i), origin[axis]), invDir[axis]));
+            tMax = _mm256_min_ps(tMax, _mm256_mul_ps(_mm256_sub_ps(_mm256_loadu_ps(query.farPlanes[axis] + i), origin[axis]), invDir[axis]));
+        }
+        int mask = _mm256_movemask_ps(_mm256_cmp_ps(tMin, tMax, _CMP_LE_OQ));
+        if (mask != 0) {
+            alignas(32) float tEntry[8];
+            _mm256_store_ps(tEntry, tMin);
+            rayBoxesResolveLanes(mask, tEntry, i, closest, nearest);
+        }
+    }
+#if defined(EDEN_SIMD_AVX) || defined(EDEN_SIMD_SSE)
+    rayBoxesSse(query, i, end, closest, nearest);  // BVH leaves are mostly shorter than 8: one 4-wide step, then scalar
+#else
+    rayBoxesScalar(query, i, end, closest, nearest);
+#endif
+}
+#endif
+
+struct RayBoxesKernelEntry {
+    const char* name;
+    RayBoxesKernel kernel;
+};
+
+// Kernels this build and CPU can run, best last
+static std::vector<RayBoxesKernelEntry> availableRayBoxesKernels() {
+    std::vector<RayBoxesKernelEntry> kernels = {{"scalar", rayBoxesScalar}};
+#if defined(EDEN_SIMD_AVX) || defined(EDEN_SIMD_SSE)
+    kernels.push_back({"sse", rayBoxesSse});
+#endif
+#if defined(EDEN_SIMD_AVX2_DISPATCH)
+    if (cpuSupportsAvx2()) kernels.push_back({"avx2", rayBoxesAvx2});
+#endif
+    return kernels;
+}
+
+static RayBoxesKernel g_rayBoxesKernel = nullptr;  // Chosen on first use
+
+static uint32_t rayBoxesNearest(const glm::vec3& origin, const glm::vec3& invDir, const BoxSoA& boxes, uint32_t begin, uint32_t count, float& closest) {
+    if (!g_rayBoxesKernel) {
+        RayBoxesKernelEntry best = availableRayBoxesKernels().back();
+        g_rayBoxesKernel = best.kernel;
+        std::cout << "[EDEN] Ray-box kernel: " << best.name << std::endl;
+    }
+    uint32_t nearest = RAY_BOX_NONE;
+    g_rayBoxesKernel(makeRayBoxQuery(origin, invDir, boxes), begin, begin + count, closest, nearest);
+    return nearest;
+}
+
+// Microbenchmark: boxCount random boxes in a 10000-unit cube, hit by rays from random points
+// toward random box centers, repeated `iterations` times per kernel. Prints every kernel this
+// CPU can run and returns boxes/ns of the one the raycasts use.
+extern "C" float heidic_benchmark_ray_boxes(int boxCount, int iterations) {
+    if (boxCount <= 0 || iterations <= 0) return 0.0f;
+    uint32_t seed = 12345;
+    auto random01 = [&seed]() {
+        seed = seed * 1103515245 + 12345;
+        return (float)(seed & 0x7FFFFFFF) / 2147483647.0f;
+    };
+    BoxSoA boxes;
+    boxes.resize(boxCount);
+    for (int i = 0; i < boxCount; i++) {
+        glm::vec3 center(random01() * 10000.0f, random01() * 10000.0f, random01() * 10000.0f);
+        glm::vec3 half(10.0f + random01() * 90.0f);
+        boxes.set(i, center - half, center + half);
+    }
+    const int rayCount = 64;
+    std::vector<glm::vec3> origins(rayCount), invDirs(rayCount);
+    for (int r = 0; r < rayCount; r++) {
+        origins[r] = glm::vec3(random01() * 10000.0f, random01() * 10000.0f, random01() * 10000.0f);
+        int target = (int)(random01() * (boxCount - 1));
+        glm::vec3 center = glm::vec3(boxes.minX[target] + boxes.maxX[target], boxes.minY[target] + boxes.maxY[target],
+                                     boxes.minZ[target] + boxes.maxZ[target]) * 0.5f;
+        glm::vec3 dir = center - origins[r];
+        invDirs[r] = rayInverseDir(glm::length(dir) > 0.0f ? glm::normalize(dir) : glm::vec3(0.0f, 0.0f, 1.0f));
+    }
+    
+    float dispatched = 0.0f;
+    float closest = 0.0f;
+    uint32_t checksum = 0;  // Keeps the results live
+    rayBoxesNearest(origins[0], invDirs[0], boxes, 0, 0, closest);  // Selects the dispatched kernel
+    for (const RayBoxesKernelEntry& entry : availableRayBoxesKernels()) {
+        auto start = std::chrono::steady_clock::now();
+        for (int it = 0; it < iterations; it++) {
+            int r = it % rayCount;
+            RayBoxQuery query = makeRayBoxQuery(origins[r], invDirs[r], boxes);
+            closest = FLT_MAX;
+            uint32_t nearest = RAY_BOX_NONE;
+            entry.kernel(query, 0, (uint32_t)boxCount, closest, nearest);
+            checksum += nearest;
+        }
+        double ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+        float boxesPerNs = ns > 0.0 ? (float)((double)boxCount * iterations / ns) : 0.0f;
+        std::cout << "[EDEN] Ray-box kernel " << entry.name << ": " << boxesPerNs << " boxes/ns" << std::endl;
+        if (entry.kernel == g_rayBoxesKernel) dispatched = boxesPerNs;
+    }
+    if (checksum == 0x7FFFFFFFu) std::cout << "[EDEN] Ray-box benchmark checksum " << checksum << std::endl;
+    return dispatched;
+}
+
+// ============================================================================
+// SCENE BVH
+// ============================================================================
+// Bounding volume hierarchy over the active created cubes, used by heidic_raycast_scene(). It is
+// built with a binned surface area heuristic on the first query after cubes are added or the
+// level is loaded. Moving a cube, or creating one in a recycled slot that is still in the tree,
+// only refits the bounds from that cube's leaf up. Deleted cubes stay in their leaf as empty
+// boxes until the next build. Leaf items and the every-cube path are tested with the ray-box
+// kernel. The runtime stores no wedges or mesh instances, so cubes are the only item kind.
+
+enum SceneHitKind {
+    SCENE_HIT_NONE = 0,
+    SCENE_HIT_CUBE = 1
+};
+
+struct BvhNode {
+    glm::vec3 boundsMin;
+    glm::vec3 boundsMax;
+    uint32_t first;   // Leaf: first entry in g_bvhItems; inner: left child (right child = first + 1)
+    uint32_t count;   // Items in a leaf, 0 for inner nodes
+    uint32_t parent;
+};
+
+struct SceneHit {
+    int kind = SCENE_HIT_NONE;
+    int index = -1;
+    float distance = 0.0f;
+    glm::vec3 point = glm::vec3(0.0f);
+};
+
+static const uint32_t BVH_NONE = 0xFFFFFFFFu;
+static const uint32_t BVH_LEAF_SIZE = 8;  // Never split below this many items (one AVX2 kernel batch)
+static const uint32_t BVH_SAH_BINS = 12;
+
+static std::vector<BvhNode> g_bvhNodes;
+static std::vector<uint32_t> g_bvhItems;       // Cube slots, contiguous per leaf
+static BoxSoA g_bvhBoxes;                      // Bounds per g_bvhItems entry (empty once deleted)
+static std::vector<uint32_t> g_bvhLeafOfSlot;  // Per cube slot: leaf holding it (BVH_NONE = not in the tree)
+static std::vector<uint32_t> g_bvhStack;       // Traversal stack, reused between queries
+static bool g_bvhEnabled = true;               // 0 = test every cube (for comparison)
+static bool g_bvhDirty = true;
+static uint32_t g_bvhRefits = 0;               // Refits since the last build
+static uint32_t g_bvhBuilds = 0;
+static SceneHit g_sceneHit;                    // Result of the last heidic_raycast_scene*
+static BoxSoA g_cubeBoxes;                     // Bounds per cube slot for the every-cube path (empty = not active)
+static bool g_cubeBoxesDirty = true;
+
+static void cubeBounds(uint32_t slot, glm::vec3& boundsMin, glm::vec3& boundsMax) {
+    const CubeStore& cubes = g_createdCubes;
+    glm::vec3 center(cubes.x[slot], cubes.y[slot], cubes.z[slot]);
+    glm::vec3 half(cubes.sx[slot] * 0.5f, cubes.sy[slot] * 0.5f, cubes.sz[slot] * 0.5f);
+    boundsMin = glm::min(center - half, center + half);
+    boundsMax = glm::max(center - half, center + half);
+}
+
+static void storeCubeBox(BoxSoA& boxes, size_t i, uint32_t slot) {
+    if (g_createdCubes.active[slot] != 1) {
+        boxes.setEmpty(i);
+        return;
+    }
+    glm::vec3 boundsMin, boundsMax;
+    cubeBounds(slot, boundsMin, boundsMax);
+    boxes.set(i, boundsMin, boundsMax);
+}
+
+static float boundsArea(const glm::vec3& boundsMin, const glm::vec3& boundsMax) {
+    glm::vec3 d = boundsMax - boundsMin;
+    return 2.0f * (d.x * d.y + d.y * d.z + d.z * d.x);
+}
+
+// Slab test against one box; tEntry is where the ray enters it (0 if the origin is inside)
+static bool raySlab(const glm::vec3& origin, const glm::vec3& invDir, const glm::vec3& boundsMin, const glm::vec3& boundsMax,
+                    float maxDistance, float& tEntry) {
+    glm::vec3 t0 = (boundsMin - origin) * invDir;
+    glm::vec3 t1 = (boundsMax - origin) * invDir;
+    glm::vec3 tNear = glm::min(t0, t1);
+    glm::vec3 tFar = glm::max(t0, t1);
+    float tMin = std::max(std::max(tNear.x, tNear.y), tNear.z);
+    float tMax = std::min(std::min(tFar.x, tFar.y), tFar.z);
+    tEntry = std::max(tMin, 0.0f);
+    return tMax >= tEntry && tEntry <= maxDistance;
+}
+
+static void setBvhLeaf(uint32_t nodeIndex) {
+    const BvhNode& node = g_bvhNodes[nodeIndex];
+    for (uint32_t i = node.first; i < node.first + node.count; i++) {
+        g_bvhLeafOfSlot[g_bvhItems[i]] = nodeIndex;
+    }
+}
+
+static void buildSceneBvh() {
+    const CubeStore& cubes = g_createdCubes;
+    g_bvhNodes.clear();
+    g_bvhItems.assign(cubes.live.begin(), cubes.live.end());
+    g_bvhLeafOfSlot.assign(cubes.size(), BVH_NONE);
+    g_bvhDirty = false;
+    g_bvhRefits = 0;
+    g_bvhBuilds++;
+    uint32_t itemCount = (uint32_t)g_bvhItems.size();
+    if (itemCount == 0) return;
+    
+    // Bounds and centroids per slot, gathered once
+    std::vector<glm::vec3> itemMin(cubes.size()), itemMax(cubes.size()), centroid(cubes.size());
+    for (uint32_t slot : g_bvhItems) {
+        cubeBounds(slot, itemMin[slot], itemMax[slot]);
+        centroid[slot] = (itemMin[slot] + itemMax[slot]) * 0.5f;
+    }
+    g_bvhBoxes.resize(itemCount);  // Filled in final item order once the tree is built
+    
+    g_bvhNodes.reserve(2 * itemCount);
+    g_bvhNodes.push_back({glm::vec3(0.0f), glm::vec3(0.0f), 0, itemCount, BVH_NONE});
+    std::vector<uint32_t> pending = {0};
+    while (!pending.empty()) {
+        uint32_t nodeIndex = pending.back();
+        pending.pop_back();
+        uint32_t first = g_bvhNodes[nodeIndex].first;
+        uint32_t count = g_bvhNodes[nodeIndex].count;
+        
+        glm::vec3 boundsMin(FLT_MAX), boundsMax(-FLT_MAX);
+        glm::vec3 centroidMin(FLT_MAX), centroidMax(-FLT_MAX);
+        for (uint32_t i = first; i < first + count; i++) {
+            uint32_t slot = g_bvhItems[i];
+            boundsMin = glm::min(boundsMin, itemMin[slot]);
+            boundsMax = glm::max(boundsMax, itemMax[slot]);
+            centroidMin = glm::min(centroidMin, centroid[slot]);
+            centroidMax = glm::max(centroidMax, centroid[slot]);
+        }
+        g_bvhNodes[nodeIndex].boundsMin = boundsMin;
+        g_bvhNodes[nodeIndex].boundsMax = boundsMax;
+        if (count <= BVH_LEAF_SIZE) {
+            setBvhLeaf(nodeIndex);
+            continue;
+        }
+        
+        // Binned SAH: bin centroids along each axis and sweep the BVH_SAH_BINS - 1 split planes
+        float bestCost = FLT_MAX;
+        int bestAxis = -1;
+        uint32_t bestSplit = 0;  // Bins [0, bestSplit] go left
+        for (int axis = 0; axis < 3; axis++) {
+            float extent = centroidMax[axis] - centroidMin[axis];
+            if (extent <= 0.0f) continue;
+            float binScale = BVH_SAH_BINS / extent;
+            
+            glm::vec3 binMin[BVH_SAH_BINS], binMax[BVH_SAH_BINS];
+            uint32_t binCount[BVH_SAH_BINS] = {};
+            for (uint32_t b = 0; b < BVH_SAH_BINS; b++) {
+                binMin[b] = glm::vec3(FLT_MAX);
+                binMax[b] = glm::vec3(-FLT_MAX);
+            }
+            for (uint32_t i = first; i < first + count; i++) {
+                uint32_t slot = g_bvhItems[i];
+                uint32_t b = std::min(BVH_SAH_BINS - 1, (uint32_t)((centroid[slot][axis] - centroidMin[axis]) * binScale));
+                binMin[b] = glm::min(binMin[b], itemMin[slot]);
+                binMax[b] = glm::max(binMax[b], itemMax[slot]);
+                binCount[b]++;
+            }
+            
+            float rightArea[BVH_SAH_BINS];
+            uint32_t rightCount[BVH_SAH_BINS];
+            glm::vec3 sweepMin(FLT_MAX), sweepMax(-FLT_MAX);
+            uint32_t sweepCount = 0;
+            for (uint32_t b = BVH_SAH_BINS - 1; b > 0; b--) {
+                sweepMin = glm::min(sweepMin, binMin[b]);
+                sweepMax = glm::max(sweepMax, binMax[b]);
+                sweepCount += binCount[b];
+                rightArea[b] = sweepCount > 0 ? boundsArea(sweepMin, sweepMax) : 0.0f;
+                rightCount[b] = sweepCount;
+            }
+            sweepMin = glm::vec3(FLT_MAX);
+            sweepMax = glm::vec3(-FLT_MAX);
+            sweepCount = 0;
+            for (uint32_t b = 0; b < BVH_SAH_BINS - 1; b++) {
+                sweepMin = glm::min(sweepMin, binMin[b]);
+                sweepMax = glm::max(sweepMax, binMax[b]);
+                sweepCount += binCount[b];
+                if (sweepCount == 0 || rightCount[b + 1] == 0) continue;
+                float cost = sweepCount * boundsArea(sweepMin, sweepMax) + rightCount[b + 1] * rightArea[b + 1];
+                if (cost < bestCost) {
+                    bestCost = cost;
+                    bestAxis = axis;
+                    bestSplit = b;
+                }
+            }
+        }
+        
+        // Keep a leaf when no split beats testing every item (or all centroids coincide)
+        if (bestAxis < 0 || bestCost >= count * boundsArea(boundsMin, boundsMax)) {
+            setBvhLeaf(nodeIndex);
+            continue;
+        }
+        
+        float binScale = BVH_SAH_BINS / (centroidMax[bestAxis] - centroidMin[bestAxis]);
+        uint32_t* begin = g_bvhItems.data() + first;
+        uint32_t* middle = std::partition(begin, begin + count, [&](uint32_t slot) {
+            uint32_t b = std::min(BVH_SAH_BINS - 1, (uint32_t)((centroid[slot][bestAxis] - centroidMin[bestAxis]) * binScale));
+            return b <= bestSplit;
+        });
+        uint32_t leftCount = (uint32_t)(middle - begin);
+        if (leftCount == 0 || leftCount == count) {
+            setBvhLeaf(nodeIndex);
+            continue;
+        }
+        
+        uint32_t left = (uint32_t)g_bvhNodes.size();
+        g_bvhNodes.push_back({glm::vec3(0.0f), glm::vec3(0.0f), first, leftCount, nodeIndex});
+        g_bvhNodes.push_back({glm::vec3(0.0f), glm::vec3(0.0f), first + leftCount, count - leftCount, nodeIndex});
+        g_bvhNodes[nodeIndex].first = left;
+        g_bvhNodes[nodeIndex].count = 0;
+        pending.push_back(left);
+        pending.push_back(left + 1);
+    }
+    for (uint32_t i = 0; i < itemCount; i++) {
+        g_bvhBoxes.set(i, itemMin[g_bvhItems[i]], itemMax[g_bvhItems[i]]);
+    }
+}
+
+// Recompute a leaf's bounds from its items, then its ancestors' until one is unchanged
+static void refitSceneBvh(uint32_t leaf) {
+    BvhNode& node = g_bvhNodes[leaf];
+    glm::vec3 boundsMin(FLT_MAX), boundsMax(-FLT_MAX);
+    for (uint32_t i = node.first; i < node.first + node.count; i++) {
+        glm::vec3 itemMin, itemMax;
+        cubeBounds(g_bvhItems[i], itemMin, itemMax);  // Deleted cubes keep their last bounds in the node
+        boundsMin = glm::min(boundsMin, itemMin);
+        boundsMax = glm::max(boundsMax, itemMax);
+        storeCubeBox(g_bvhBoxes, i, g_bvhItems[i]);
+    }
+    node.boundsMin = boundsMin;
+    node.boundsMax = boundsMax;
+    
+    for (uint32_t parent = node.parent; parent != BVH_NONE; parent = g_bvhNodes[parent].parent) {
+        BvhNode& inner = g_bvhNodes[parent];
+        const BvhNode& left = g_bvhNodes[inner.first];
+        const BvhNode& right = g_bvhNodes[inner.first + 1];
+        glm::vec3 refitMin = glm::min(left.boundsMin, right.boundsMin);
+        glm::vec3 refitMax = glm::max(left.boundsMax, right.boundsMax);
+        if (refitMin == inner.boundsMin && refitMax == inner.boundsMax) break;
+        inner.boundsMin = refitMin;
+        inner.boundsMax = refitMax;
+    }
+    g_bvhRefits++;
+}
+
+// A cube was created, moved or deleted: update its box, and refit if its slot is in the tree,
+// otherwise rebuild on next query
+static void sceneBvhCubeChanged(uint32_t slot) {
+    if (!g_cubeBoxesDirty) {
+        if (slot >= g_cubeBoxes.size()) g_cubeBoxes.resize(g_createdCubes.size());
+        storeCubeBox(g_cubeBoxes, slot, slot);
+    }
+    if (g_bvhDirty) return;
+    if (slot >= g_bvhLeafOfSlot.size() || g_bvhLeafOfSlot[slot] == BVH_NONE) {
+        g_bvhDirty = true;
+        return;
+    }
+    refitSceneBvh(g_bvhLeafOfSlot[slot]);
+}
+
+static void sceneBvhInvalidate() {
+    g_bvhDirty = true;
+    g_cubeBoxesDirty = true;
+}
+
+// Closest active cube along the ray (dir normalized) within maxDistance
+static SceneHit raycastScene(const glm::vec3& origin, const glm::vec3& dir, float maxDistance) {
+    const CubeStore& cubes = g_createdCubes;
+    glm::vec3 invDir = rayInverseDir(dir);
+    SceneHit hit;
+    float closest = maxDistance;
+    float tEntry = 0.0f;
     
-    // Store in cache (so we never destroy it)
-    TextureResource cached;
-    cached.image = g_textureImage;
-    cached.memory = g_textureImageMemory;
-    cached.view = newTextureImageView;
-    g_textureCache[texture_name] = cached;
+    if (!g_bvhEnabled) {
+        if (g_cubeBoxesDirty) {
+            g_cubeBoxes.clear();
+            g_cubeBoxes.resize(cubes.size());
+            for (uint32_t slot : cubes.live) storeCubeBox(g_cubeBoxes, slot, slot);
+            g_cubeBoxesDirty = false;
+        }
+        uint32_t nearest = rayBoxesNearest(origin, invDir, g_cubeBoxes, 0, (uint32_t)g_cubeBoxes.size(), closest);
+        if (nearest != RAY_BOX_NONE) {
+            hit.kind = SCENE_HIT_CUBE;
+            hit.index = (int)nearest;
+        }
+    } else {
+        // Refits loosen the tree over time; rebuild once they outnumber the items
+        if (g_bvhDirty || g_bvhRefits > std::max<size_t>(1024, g_bvhItems.size())) {
+            buildSceneBvh();
+        }
+        if (!g_bvhNodes.empty()) {
+            g_bvhStack.clear();
+            g_bvhStack.push_back(0);
+            while (!g_bvhStack.empty()) {
+                const BvhNode& node = g_bvhNodes[g_bvhStack.back()];
+                g_bvhStack.pop_back();
+                if (!raySlab(origin, invDir, node.boundsMin, node.boundsMax, closest, tEntry)) continue;
+                if (hit.kind != SCENE_HIT_NONE && tEntry >= closest) continue;
+                
+                if (node.count > 0) {
+                    float leafClosest = closest;
+                    uint32_t nearest = rayBoxesNearest(origin, invDir, g_bvhBoxes, node.first, node.count, leafClosest);
+                    if (nearest != RAY_BOX_NONE && (hit.kind == SCENE_HIT_NONE || leafClosest < closest)) {
+                        closest = leafClosest;
+                        hit.kind = SCENE_HIT_CUBE;
+                        hit.index = (int)g_bvhItems[nearest];
+                    }
+                    continue;
+                }
+                
+                // Visit the nearer child first (pushed last)
+                uint32_t left = node.first;
+                float tLeft = 0.0f, tRight = 0.0f;
+                bool hitLeft = raySlab(origin, invDir, g_bvhNodes[left].boundsMin, g_bvhNodes[left].boundsMax, closest, tLeft);
+                bool hitRight = raySlab(origin, invDir, g_bvhNodes[left + 1].boundsMin, g_bvhNodes[left + 1].boundsMax, closest, tRight);
+                if (hitLeft && hitRight) {
+                    g_bvhStack.push_back(tLeft <= tRight ? left + 1 : left);
+                    g_bvhStack.push_back(tLeft <= tRight ? left : left + 1);
+                } else if (hitLeft) {
+                    g_bvhStack.push_back(left);
+                } else if (hitRight) {
+                    g_bvhStack.push_back(left + 1);
+                }
+            }
+        }
+    }
     
-    // Update global handles to point to cached texture
-    g_textureImageView = newTextureImageView;
-    g_currentRenderingTextureName = texture_name;
+    if (hit.kind != SCENE_HIT_NONE) {
+        hit.distance = closest;
+        hit.point = origin + dir * closest;
+    }
+    return hit;
+}
+
+// Raycast the scene from the mouse cursor. Returns the hit kind (0 = nothing, 1 = cube); the
+// details stay available through heidic_get_scene_hit_* until the next raycast.
+extern "C" int heidic_raycast_scene(GLFWwindow* window) {
+    g_sceneHit = SceneHit();
+    if (!window) return SCENE_HIT_NONE;
     
-    // NOTE: We do NOT update descriptor sets here anymore.
-    // Instead, heidic_flush_colored_cubes() grabs a fresh descriptor set from the pool,
-    // updates it with g_textureImageView, and binds it for that specific batch.
-    // This avoids invalidating descriptor sets used by previous batches in the same command buffer.
+    double mouseX, mouseY;
+    glfwGetCursorPos(window, &mouseX, &mouseY);
+    int fbWidth, fbHeight;
+    glfwGetFramebufferSize(window, &fbWidth, &fbHeight);
+    glm::vec2 ndc = screenToNDC((float)mouseX, (float)mouseY, fbWidth, fbHeight);
     
-    return 1;
+    glm::vec3 rayOrigin, rayDir;
+    unproject(ndc, glm::inverse(g_currentProj), glm::inverse(g_currentView), rayOrigin, rayDir);
+    g_sceneHit = raycastScene(rayOrigin, rayDir, FLT_MAX);
+    return g_sceneHit.kind;
 }
 
-extern "C" void heidic_set_cube_pos(int index, float x, float y, float z) {
-    if (index < 0 || index >= (int)g_createdCubes.size()) return;
-    g_createdCubes[index].x = x;
-    g_createdCubes[index].y = y;
-    g_createdCubes[index].z = z;
+// Same with an explicit ray (direction need not be normalized), e.g. for gameplay or benchmarks
+extern "C" int heidic_raycast_scene_ray(float ox, float oy, float oz, float dx, float dy, float dz, float maxDistance) {
+    g_sceneHit = SceneHit();
+    glm::vec3 dir(dx, dy, dz);
+    float length = glm::length(dir);
+    if (length <= 0.0f) return SCENE_HIT_NONE;
+    g_sceneHit = raycastScene(glm::vec3(ox, oy, oz), dir / length, maxDistance > 0.0f ? maxDistance : FLT_MAX);
+    return g_sceneHit.kind;
 }
 
-// Overload that accepts float index (for HEIDIC compatibility)
-extern "C" void heidic_set_cube_pos_f(float index_f, float x, float y, float z) {
-    int index = (int)index_f;
-    if (index < 0 || index >= (int)g_createdCubes.size()) return;
-    g_createdCubes[index].x = x;
-    g_createdCubes[index].y = y;
-    g_createdCubes[index].z = z;
+extern "C" int heidic_get_scene_hit_kind() {
+    return g_sceneHit.kind;
 }
 
-extern "C" void heidic_delete_cube(int index) {
-    if (index < 0 || index >= (int)g_createdCubes.size()) return;
-    g_createdCubes[index].active = 0;
+extern "C" int heidic_get_scene_hit_index() {
+    return g_sceneHit.index;
 }
 
-extern "C" int heidic_find_next_active_cube_index(int start_index) {
-    // Find the next active cube starting from start_index
-    for (int i = start_index; i < (int)g_createdCubes.size(); i++) {
-        if (g_createdCubes[i].active == 1) {
-            return i;
+extern "C" float heidic_get_scene_hit_distance() {
+    return g_sceneHit.distance;
+}
+
+extern "C" Vec3 heidic_get_scene_hit_point() {
+    Vec3 result = {g_sceneHit.point.x, g_sceneHit.point.y, g_sceneHit.point.z};
+    return result;
+}
+
+extern "C" void heidic_set_scene_bvh(int enabled) {
+    g_bvhEnabled = (enabled != 0);
+}
+
+extern "C" int heidic_get_scene_bvh_node_count() {
+    if (g_bvhDirty) buildSceneBvh();
+    return (int)g_bvhNodes.size();
+}
+
+extern "C" int heidic_get_scene_bvh_build_count() {
+    return (int)g_bvhBuilds;
+}
+
+// ============================================================================
+// STATIC LEVEL GEOMETRY CACHE
+// ============================================================================
+// Created cubes are baked once into device-local vertex buffers grouped by texture. Only buckets
+// touched by heidic_create_cube*, heidic_set_cube_pos* or heidic_delete_cube are rebuilt; an
+// unedited level costs one queued draw per texture per frame.
+
+static uint32_t g_staticCubeRebuilds = 0;  // Bucket rebuilds since startup (for profiling)
+
+// Look up a texture in the cache, loading it on first use, without changing the texture that is
+// currently selected for rendering
+static TextureResource* acquireCachedTexture(const std::string& name) {
+    auto it = g_textureCache.find(name);
+    if (it != g_textureCache.end() && !it->second.evicted) return &it->second;
+    
+    VkImage prevImage = g_textureImage;
+    GpuAllocation prevMemory = g_textureImageMemory;
+    VkImageView prevView = g_textureImageView;
+    TextureResource* prevTexture = g_currentTexture;
+    uint32_t prevSlot = g_currentTextureSlot;
+    std::string prevName = g_currentRenderingTextureName;
+    
+    int loaded = heidic_load_texture_for_rendering(name.c_str());
+    
+    g_textureImage = prevImage;
+    g_textureImageMemory = prevMemory;
+    g_textureImageView = prevView;
+    g_currentTexture = prevTexture;
+    g_currentTextureSlot = prevSlot;
+    g_currentRenderingTextureName = prevName;
+    
+    if (!loaded) return nullptr;
+    it = g_textureCache.find(name);
+    return it != g_textureCache.end() ? &it->second : nullptr;
+}
+
+// Append the 36 world-space vertices of an (axis-aligned) created cube
+static void bakeStaticCube(size_t index, std::vector<Vertex>& out) {
+    const CubeStore& cubes = g_createdCubes;
+    for (const Vertex& v : g_coloredCubeUnitVertices) {
+        Vertex baked;
+        baked.pos[0] = cubes.x[index] + v.pos[0] * cubes.sx[index];
+        baked.pos[1] = cubes.y[index] + v.pos[1] * cubes.sy[index];
+        baked.pos[2] = cubes.z[index] + v.pos[2] * cubes.sz[index];
+        baked.uv[0] = v.uv[0];
+        baked.uv[1] = v.uv[1];
+        // White tint, like the editor's per-cube draw, so textures display at full brightness
+        baked.color[0] = v.color[0];
+        baked.color[1] = v.color[1];
+        baked.color[2] = v.color[2];
+        out.push_back(baked);
+    }
+}
+
+// Rebuild every dirty bucket with a single pass over the cube storage
+static void rebuildStaticCubeBuckets() {
+    std::map<std::string, std::vector<Vertex>> baked;
+    for (auto& entry : g_staticCubeBuckets) {
+        if (entry.second.dirty) baked[entry.first];
+    }
+    
+    // Resolve each interned texture to its bucket once instead of per cube
+    std::vector<std::vector<Vertex>*> bakedByTexture(g_cubeTextureNames.size(), nullptr);
+    for (size_t id = 0; id < bakedByTexture.size(); id++) {
+        auto it = baked.find(staticCubeBucketKey((uint32_t)id));
+        if (it != baked.end()) bakedByTexture[id] = &it->second;
+    }
+    
+    const CubeStore& cubes = g_createdCubes;
+    for (uint32_t i : cubes.live) {
+        std::vector<Vertex>* out = bakedByTexture[cubes.textureId[i]];
+        if (out) bakeStaticCube(i, *out);
+    }
+    
+    for (auto& entry : baked) {
+        StaticCubeBucket& bucket = g_staticCubeBuckets[entry.first];
+        // Earlier frames (or packets already queued this frame) may still use the old buffer
+        retireBuffer(bucket.buffer, bucket.memory);
+        bucket.buffer = VK_NULL_HANDLE;
+        bucket.memory = GpuAllocation();
+        bucket.vertexCount = 0;
+        bucket.dirty = false;
+        g_staticCubeRebuilds++;
+        
+        if (entry.second.empty()) continue;
+        VkDeviceSize size = sizeof(Vertex) * entry.second.size();
+        if (!createDeviceLocalBuffer(entry.second.data(), size, VK_BUFFER_USAGE_VERTEX_BUFFER_BIT, bucket.buffer, bucket.memory)) {
+            std::cerr << "[EDEN] Failed to upload static cube bucket '" << entry.first << "'" << std::endl;
+            continue;
+        }
+        bucket.vertexCount = static_cast<uint32_t>(entry.second.size());
+        bucket.texture = acquireCachedTexture(entry.first);
+        
+        glm::vec3 boundsMin(FLT_MAX), boundsMax(-FLT_MAX);
+        for (const Vertex& v : entry.second) {
+            boundsMin = glm::min(boundsMin, glm::vec3(v.pos[0], v.pos[1], v.pos[2]));
+            boundsMax = glm::max(boundsMax, glm::vec3(v.pos[0], v.pos[1], v.pos[2]));
+        }
+        bucket.boundsCenter = (boundsMin + boundsMax) * 0.5f;
+        bucket.boundsExtent = (boundsMax - boundsMin) * 0.5f;
+    }
+    
+    // Drop buckets whose last cube went away
+    for (auto it = g_staticCubeBuckets.begin(); it != g_staticCubeBuckets.end();) {
+        if (!it->second.dirty && it->second.vertexCount == 0) {
+            it = g_staticCubeBuckets.erase(it);
+        } else {
+            ++it;
+        }
+    }
+    g_staticCubesDirty = false;
+}
+
+// Draw all created cubes from the static cache (rebuilding edited buckets first)
+extern "C" void heidic_draw_static_cubes() {
+    if (!g_commandBufferStarted) return;
+    if (g_staticCubesDirty) {
+        rebuildStaticCubeBuckets();
+    }
+    
+    glm::mat4 identity(1.0f);  // Vertices are baked in world space
+    for (auto& entry : g_staticCubeBuckets) {
+        StaticCubeBucket& bucket = entry.second;
+        if (bucket.vertexCount == 0) continue;
+        if (bucket.texture) {
+            if (bucket.texture->evicted) acquireCachedTexture(entry.first);  // Reload (default texture until resident)
+            bucket.texture->lastUsedSerial = nextSubmitSerial();
         }
+        VkDescriptorSet set = bucket.texture ? getTextureDescriptorSet(*bucket.texture) : g_descriptorSets[g_currentFrame];
+        queueMeshDraw(bucket.buffer, bucket.vertexCount, set, identity, bucket.boundsCenter, bucket.boundsExtent);
+    }
+}
+
+// Force a rebuild of every bucket on the next heidic_draw_static_cubes() (e.g. after a bulk edit)
+extern "C" void heidic_invalidate_static_cubes() {
+    std::vector<uint8_t> used(g_cubeTextureNames.size(), 0);
+    for (uint32_t i : g_createdCubes.live) {
+        used[g_createdCubes.textureId[i]] = 1;
     }
-    return -1;  // No more active cubes
+    for (size_t id = 0; id < used.size(); id++) {
+        if (used[id]) g_staticCubeBuckets[staticCubeBucketKey((uint32_t)id)].dirty = true;
+    }
+    for (auto& entry : g_staticCubeBuckets) {
+        entry.second.dirty = true;
+    }
+    g_staticCubesDirty = true;
+}
+
+extern "C" int heidic_get_static_cube_bucket_count() {
+    return (int)g_staticCubeBuckets.size();
+}
+
+extern "C" int heidic_get_static_cube_rebuild_count() {
+    return (int)g_staticCubeRebuilds;
 }
 
 // Random number generator (simple LCG)
@@ -3844,22 +7955,23 @@ extern "C" int heidic_float_to_int(float value) {
 
 // ========== COMBINATION SYSTEM ==========
 
-// Check if two cubes are touching/connected (within a small threshold)
-static bool cubesAreTouching(const CreatedCube& cube1, const CreatedCube& cube2) {
+// Check if two cubes (storage indices) are touching/connected (within a small threshold)
+static bool cubesAreTouching(size_t i1, size_t i2) {
+    const CubeStore& cubes = g_createdCubes;
     // Calculate AABB bounds for both cubes
-    float c1_min_x = cube1.x - cube1.sx * 0.5f;
-    float c1_max_x = cube1.x + cube1.sx * 0.5f;
-    float c1_min_y = cube1.y - cube1.sy * 0.5f;
-    float c1_max_y = cube1.y + cube1.sy * 0.5f;
-    float c1_min_z = cube1.z - cube1.sz * 0.5f;
-    float c1_max_z = cube1.z + cube1.sz * 0.5f;
-    
-    float c2_min_x = cube2.x - cube2.sx * 0.5f;
-    float c2_max_x = cube2.x + cube2.sx * 0.5f;
-    float c2_min_y = cube2.y - cube2.sy * 0.5f;
-    float c2_max_y = cube2.y + cube2.sy * 0.5f;
-    float c2_min_z = cube2.z - cube2.sz * 0.5f;
-    float c2_max_z = cube2.z + cube2.sz * 0.5f;
+    float c1_min_x = cubes.x[i1] - cubes.sx[i1] * 0.5f;
+    float c1_max_x = cubes.x[i1] + cubes.sx[i1] * 0.5f;
+    float c1_min_y = cubes.y[i1] - cubes.sy[i1] * 0.5f;
+    float c1_max_y = cubes.y[i1] + cubes.sy[i1] * 0.5f;
+    float c1_min_z = cubes.z[i1] - cubes.sz[i1] * 0.5f;
+    float c1_max_z = cubes.z[i1] + cubes.sz[i1] * 0.5f;
+    
+    float c2_min_x = cubes.x[i2] - cubes.sx[i2] * 0.5f;
+    float c2_max_x = cubes.x[i2] + cubes.sx[i2] * 0.5f;
+    float c2_min_y = cubes.y[i2] - cubes.sy[i2] * 0.5f;
+    float c2_max_y = cubes.y[i2] + cubes.sy[i2] * 0.5f;
+    float c2_min_z = cubes.z[i2] - cubes.sz[i2] * 0.5f;
+    float c2_max_z = cubes.z[i2] + cubes.sz[i2] * 0.5f;
     
     // Check if cubes are touching/adjacent (within a small threshold)
     const float threshold = 1.0f;  // 1 unit tolerance for touching
@@ -3896,22 +8008,218 @@ static std::map<int, bool> g_combinationExpanded;  // Track which combinations a
 static std::map<int, std::string> g_combinationNames;  // Custom names for combinations (empty = use default)
 static std::map<int, std::string> g_combinationEditBuffers;  // Per-combination edit buffers
 
-// Multi-selection tracking
-static std::set<int> g_selectedCubeIndices;  // Set of selected cube storage indices
-
 // Texture swatch tracking
 static std::vector<std::string> g_textureList;  // List of texture filenames
 static std::string g_selectedTexture = "";  // Currently selected texture name
 static bool g_textureListLoaded = false;
 // Note: g_texturesBaseDir is declared earlier (before heidic_load_texture_for_rendering)
 
-// Texture preview cache (maps texture name to ImGui texture ID)
+// ============================================================================
+// TEXTURE PALETTE THUMBNAILS
+// ============================================================================
+// Palette swatches are THUMBNAIL_SIZE thumbnails packed into atlas pages (one image and one ImGui
+// descriptor per page). A preview id is -(thumbnail index + 1); heidic_imgui_image_button() turns it
+// into the page's descriptor and the cell's UVs. Downscaled pixels are cached on disk in
+// <textures>/cooked/thumbnails.cache keyed by source path and modification time, so reopening the
+// browser decodes nothing that has not changed.
+
+static const uint32_t THUMBNAIL_SIZE = 64;
+static const uint32_t THUMBNAIL_ATLAS_SIZE = 1024;  // 16x16 thumbnails (4 MB) per page
+static const uint32_t THUMBNAIL_CACHE_MAGIC = 0x4D485445;  // "ETHM"
+static const uint32_t THUMBNAIL_CACHE_VERSION = 1;
+
+struct ThumbnailAtlasPage {
+    VkImage image = VK_NULL_HANDLE;
+    GpuAllocation memory;
+    VkImageView view = VK_NULL_HANDLE;
+    VkDescriptorSet descriptorSet = VK_NULL_HANDLE;  // ImGui texture
+    uint32_t used = 0;  // Cells handed out
+};
+
 struct TexturePreview {
-    VkDescriptorSet descriptorSet;
-    int width;
+    uint32_t page;
+    uint32_t cell;
+    int width;   // Source image size
     int height;
 };
-static std::map<std::string, TexturePreview> g_texturePreviews;
+
+struct ThumbnailCacheEntry {
+    int64_t mtime = 0;
+    int width = 0;
+    int height = 0;
+    std::vector<unsigned char> pixels;  // THUMBNAIL_SIZE^2 RGBA8
+};
+
+static std::vector<ThumbnailAtlasPage> g_thumbnailPages;
+static std::vector<TexturePreview> g_thumbnails;
+static std::map<std::string, int> g_texturePreviews;  // Texture name -> index in g_thumbnails
+static std::map<std::string, ThumbnailCacheEntry> g_thumbnailDiskCache;  // Source path -> thumbnail
+static std::string g_thumbnailCachePath;
+static bool g_thumbnailCacheLoaded = false;
+static bool g_thumbnailCacheDirty = false;
+
+static int64_t fileModificationTime(const std::string& path) {
+    std::error_code ec;
+    auto time = std::filesystem::last_write_time(path, ec);
+    return ec ? 0 : (int64_t)time.time_since_epoch().count();
+}
+
+// Area-average an RGBA8 image down (or nearest-sample it up) to dstWidth x dstHeight
+static void resizeRgba8Box(const unsigned char* src, uint32_t srcWidth, uint32_t srcHeight,
+                           unsigned char* dst, uint32_t dstWidth, uint32_t dstHeight) {
+    for (uint32_t y = 0; y < dstHeight; y++) {
+        uint32_t y0 = y * srcHeight / dstHeight;
+        uint32_t y1 = std::max((y + 1) * srcHeight / dstHeight, y0 + 1);
+        for (uint32_t x = 0; x < dstWidth; x++) {
+            uint32_t x0 = x * srcWidth / dstWidth;
+            uint32_t x1 = std::max((x + 1) * srcWidth / dstWidth, x0 + 1);
+            uint32_t sum[4] = {0, 0, 0, 0};
+            for (uint32_t sy = y0; sy < y1; sy++) {
+                const unsigned char* row = src + ((size_t)sy * srcWidth + x0) * 4;
+                for (uint32_t sx = x0; sx < x1; sx++, row += 4) {
+                    sum[0] += row[0]; sum[1] += row[1]; sum[2] += row[2]; sum[3] += row[3];
+                }
+            }
+            uint32_t count = (y1 - y0) * (x1 - x0);
+            unsigned char* out = dst + ((size_t)y * dstWidth + x) * 4;
+            for (int c = 0; c < 4; c++) out[c] = (unsigned char)((sum[c] + count / 2) / count);
+        }
+    }
+}
+
+// Read <textures>/cooked/thumbnails.cache (missing or mismatched files just start an empty cache)
+static void loadThumbnailCache() {
+    g_thumbnailCacheLoaded = true;
+    g_thumbnailCachePath = g_texturesBaseDir + "/cooked/thumbnails.cache";
+    std::ifstream file(g_thumbnailCachePath, std::ios::binary);
+    if (!file) return;
+    
+    uint32_t header[4] = {0, 0, 0, 0};  // magic, version, thumbnail size, count
+    file.read((char*)header, sizeof(header));
+    if (!file || header[0] != THUMBNAIL_CACHE_MAGIC || header[1] != THUMBNAIL_CACHE_VERSION || header[2] != THUMBNAIL_SIZE) {
+        return;
+    }
+    const size_t pixelBytes = (size_t)THUMBNAIL_SIZE * THUMBNAIL_SIZE * 4;
+    for (uint32_t i = 0; i < header[3]; i++) {
+        uint32_t pathLength = 0;
+        file.read((char*)&pathLength, sizeof(pathLength));
+        if (!file || pathLength > 4096) break;
+        std::string path(pathLength, '\0');
+        ThumbnailCacheEntry entry;
+        int32_t size[2] = {0, 0};
+        file.read(&path[0], pathLength);
+        file.read((char*)&entry.mtime, sizeof(entry.mtime));
+        file.read((char*)size, sizeof(size));
+        entry.width = size[0];
+        entry.height = size[1];
+        entry.pixels.resize(pixelBytes);
+        file.read((char*)entry.pixels.data(), (std::streamsize)pixelBytes);
+        if (!file) break;
+        g_thumbnailDiskCache[path] = std::move(entry);
+    }
+}
+
+// Write the thumbnail cache if thumbnails were generated since it was loaded
+static void saveThumbnailCache() {
+    if (!g_thumbnailCacheDirty || g_thumbnailCachePath.empty()) return;
+    std::error_code ec;
+    std::filesystem::create_directories(std::filesystem::path(g_thumbnailCachePath).parent_path(), ec);
+    std::ofstream file(g_thumbnailCachePath, std::ios::binary | std::ios::trunc);
+    if (!file) {
+        std::cerr << "[EDEN] Failed to write thumbnail cache: " << g_thumbnailCachePath << std::endl;
+        return;
+    }
+    uint32_t header[4] = {THUMBNAIL_CACHE_MAGIC, THUMBNAIL_CACHE_VERSION, THUMBNAIL_SIZE, (uint32_t)g_thumbnailDiskCache.size()};
+    file.write((const char*)header, sizeof(header));
+    for (const auto& item : g_thumbnailDiskCache) {
+        uint32_t pathLength = (uint32_t)item.first.size();
+        int32_t size[2] = {item.second.width, item.second.height};
+        file.write((const char*)&pathLength, sizeof(pathLength));
+        file.write(item.first.data(), pathLength);
+        file.write((const char*)&item.second.mtime, sizeof(item.second.mtime));
+        file.write((const char*)size, sizeof(size));
+        file.write((const char*)item.second.pixels.data(), (std::streamsize)item.second.pixels.size());
+    }
+    g_thumbnailCacheDirty = false;
+}
+
+// Cached (or freshly generated) thumbnail for a source image; nullptr if it cannot be loaded
+static const ThumbnailCacheEntry* findThumbnail(const std::string& path) {
+    if (!g_thumbnailCacheLoaded) loadThumbnailCache();
+    int64_t mtime = fileModificationTime(path);
+    auto it = g_thumbnailDiskCache.find(path);
+    if (it != g_thumbnailDiskCache.end() && it->second.mtime == mtime) return &it->second;
+    
+    int width, height, channels;
+    stbi_uc* pixels = stbi_load(path.c_str(), &width, &height, &channels, STBI_rgb_alpha);
+    if (!pixels) {
+        std::cerr << "[EDEN] Failed to load texture: " << path << std::endl;
+        return nullptr;
+    }
+    ThumbnailCacheEntry& entry = g_thumbnailDiskCache[path];
+    entry.mtime = mtime;
+    entry.width = width;
+    entry.height = height;
+    entry.pixels.resize((size_t)THUMBNAIL_SIZE * THUMBNAIL_SIZE * 4);
+    resizeRgba8Box(pixels, (uint32_t)width, (uint32_t)height, entry.pixels.data(), THUMBNAIL_SIZE, THUMBNAIL_SIZE);
+    stbi_image_free(pixels);
+    g_thumbnailCacheDirty = true;
+    return &entry;
+}
+
+// Page with a free cell (a new one is created when the last page is full)
+static ThumbnailAtlasPage* thumbnailPageWithSpace() {
+    const uint32_t cellsPerPage = (THUMBNAIL_ATLAS_SIZE / THUMBNAIL_SIZE) * (THUMBNAIL_ATLAS_SIZE / THUMBNAIL_SIZE);
+    if (!g_thumbnailPages.empty() && g_thumbnailPages.back().used < cellsPerPage) return &g_thumbnailPages.back();
+    
+    ThumbnailAtlasPage page;
+    if (!createTextureImage(THUMBNAIL_ATLAS_SIZE, THUMBNAIL_ATLAS_SIZE, page.image, page.memory, VK_FORMAT_R8G8B8A8_UNORM, 1)) {
+        return nullptr;
+    }
+    // Cells are only ever sampled after their own copy, so the page starts out undefined
+    transitionImageLayout(page.image, VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
+    page.view = createTextureView(page.image);
+    page.descriptorSet = ImGui_ImplVulkan_AddTexture(g_textureSampler, page.view, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
+    g_thumbnailPages.push_back(page);
+    return &g_thumbnailPages.back();
+}
+
+// Record the copy of a thumbnail into a page cell (submitted with this frame's uploads)
+static bool uploadThumbnail(ThumbnailAtlasPage& page, uint32_t cell, const unsigned char* pixels) {
+    VkBuffer src;
+    VkDeviceSize srcOffset;
+    if (!stageUploadData(pixels, (VkDeviceSize)THUMBNAIL_SIZE * THUMBNAIL_SIZE * 4, src, srcOffset)) return false;
+    
+    const uint32_t cellsPerRow = THUMBNAIL_ATLAS_SIZE / THUMBNAIL_SIZE;
+    transitionImageLayout(page.image, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL);
+    VkBufferImageCopy region = {};
+    region.bufferOffset = srcOffset;
+    region.imageSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+    region.imageSubresource.mipLevel = 0;
+    region.imageSubresource.baseArrayLayer = 0;
+    region.imageSubresource.layerCount = 1;
+    region.imageOffset = {(int32_t)((cell % cellsPerRow) * THUMBNAIL_SIZE), (int32_t)((cell / cellsPerRow) * THUMBNAIL_SIZE), 0};
+    region.imageExtent = {THUMBNAIL_SIZE, THUMBNAIL_SIZE, 1};
+    vkCmdCopyBufferToImage(uploadCommandBuffer(), src, page.image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1, &region);
+    g_uploadCopyCount++;
+    transitionImageLayout(page.image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
+    return true;
+}
+
+// Atlas page descriptor and cell UVs for a preview id (half-texel inset so filtering stays in the cell)
+static bool thumbnailTextureRef(int64_t previewId, ImTextureRef& texture, ImVec2& uv0, ImVec2& uv1) {
+    int64_t index = -previewId - 1;
+    if (index < 0 || index >= (int64_t)g_thumbnails.size()) return false;
+    const TexturePreview& preview = g_thumbnails[(size_t)index];
+    const uint32_t cellsPerRow = THUMBNAIL_ATLAS_SIZE / THUMBNAIL_SIZE;
+    const float scale = 1.0f / (float)THUMBNAIL_ATLAS_SIZE;
+    float x = (float)((preview.cell % cellsPerRow) * THUMBNAIL_SIZE);
+    float y = (float)((preview.cell / cellsPerRow) * THUMBNAIL_SIZE);
+    texture = (ImTextureRef)(uintptr_t)g_thumbnailPages[preview.page].descriptorSet;
+    uv0 = ImVec2((x + 0.5f) * scale, (y + 0.5f) * scale);
+    uv1 = ImVec2((x + THUMBNAIL_SIZE - 0.5f) * scale, (y + THUMBNAIL_SIZE - 0.5f) * scale);
+    return true;
+}
 
 // Multi-selection functions
 extern "C" void heidic_clear_selection() {
@@ -3946,6 +8254,66 @@ extern "C" int heidic_get_selection_count() {
     return (int)g_selectedCubeIndices.size();
 }
 
+// Draw wireframe outlines (slightly larger than the cube) for every selected, active cube.
+// Pairs with heidic_draw_static_cubes() so the editor doesn't have to walk the whole level.
+extern "C" void heidic_draw_selected_cube_outlines(float r, float g, float b) {
+    for (int idx : g_selectedCubeIndices) {
+        if (idx < 0 || idx >= (int)g_createdCubes.size()) continue;
+        const CubeStore& cubes = g_createdCubes;
+        if (cubes.active[idx] != 1) continue;
+        heidic_draw_cube_wireframe(cubes.x[idx], cubes.y[idx], cubes.z[idx], 0.0f, 0.0f, 0.0f,
+                                   cubes.sx[idx] * 1.01f, cubes.sy[idx] * 1.01f, cubes.sz[idx] * 1.01f, r, g, b);
+    }
+}
+
+// Active cube indices grouped by texture ID, reused every frame by heidic_draw_all_cubes()
+static std::vector<uint32_t> g_drawAllOffsets;  // Per texture ID: first entry in g_drawAllOrder (+1 sentinel)
+static std::vector<uint32_t> g_drawAllCursor;
+static std::vector<uint32_t> g_drawAllOrder;
+
+// Draw every active created cube through the colored cube batches, one batch per texture
+// (white tint, like the editor's loop), plus white outlines around selected cubes if asked.
+// One call replaces the per-cube getter loop; unlike heidic_draw_static_cubes() nothing is
+// baked, so cubes that move every frame cause no rebuilds.
+extern "C" void heidic_draw_all_cubes(int selection_outlines) {
+    if (!g_commandBufferStarted) return;
+    const CubeStore& cubes = g_createdCubes;
+    
+    // Counting sort of the live cubes by texture ID
+    size_t textureCount = g_cubeTextureNames.size();
+    g_drawAllOffsets.assign(textureCount + 1, 0);
+    for (uint32_t i : cubes.live) {
+        g_drawAllOffsets[cubes.textureId[i] + 1]++;
+    }
+    for (size_t id = 0; id < textureCount; id++) {
+        g_drawAllOffsets[id + 1] += g_drawAllOffsets[id];
+    }
+    g_drawAllOrder.resize(g_drawAllOffsets[textureCount]);
+    g_drawAllCursor.assign(g_drawAllOffsets.begin(), g_drawAllOffsets.end() - 1);
+    for (uint32_t i : cubes.live) {
+        g_drawAllOrder[g_drawAllCursor[cubes.textureId[i]]++] = i;
+    }
+    
+    // Whatever the caller batched so far keeps the texture it was batched with
+    heidic_flush_colored_cubes();
+    for (size_t id = 0; id < textureCount; id++) {
+        uint32_t begin = g_drawAllOffsets[id];
+        uint32_t end = g_drawAllOffsets[id + 1];
+        if (begin == end) continue;
+        heidic_load_texture_for_rendering(staticCubeBucketKey((uint32_t)id).c_str());
+        for (uint32_t k = begin; k < end; k++) {
+            uint32_t i = g_drawAllOrder[k];
+            heidic_draw_cube_colored(cubes.x[i], cubes.y[i], cubes.z[i], 0.0f, 0.0f, 0.0f,
+                                     cubes.sx[i], cubes.sy[i], cubes.sz[i], 1.0f, 1.0f, 1.0f);
+        }
+        heidic_flush_colored_cubes();
+    }
+    
+    if (selection_outlines) {
+        heidic_draw_selected_cube_outlines(1.0f, 1.0f, 1.0f);
+    }
+}
+
 // Get all selected cube indices (returns array, caller must free)
 extern "C" int* heidic_get_selected_cube_indices() {
     static std::vector<int> temp_buffer;
@@ -3986,9 +8354,9 @@ extern "C" void heidic_combine_selected_cubes() {
             int idx2 = selected_vec[j];
             if (idx1 < 0 || idx1 >= (int)g_createdCubes.size()) continue;
             if (idx2 < 0 || idx2 >= (int)g_createdCubes.size()) continue;
-            if (g_createdCubes[idx1].active != 1 || g_createdCubes[idx2].active != 1) continue;
+            if (g_createdCubes.active[idx1] != 1 || g_createdCubes.active[idx2] != 1) continue;
             
-            if (cubesAreTouching(g_createdCubes[idx1], g_createdCubes[idx2])) {
+            if (cubesAreTouching(idx1, idx2)) {
                 unite(idx1, idx2);
             }
         }
@@ -3998,8 +8366,8 @@ extern "C" void heidic_combine_selected_cubes() {
     std::map<int, int> rootToCombinationId;
     for (int idx : g_selectedCubeIndices) {
         if (idx < 0 || idx >= (int)g_createdCubes.size()) continue;
-        if (g_createdCubes[idx].active != 1) continue;
-        if (g_createdCubes[idx].combination_id >= 0) continue;  // Skip already combined
+        if (g_createdCubes.active[idx] != 1) continue;
+        if (g_createdCubes.combinationId[idx] >= 0) continue;  // Skip already combined
         
         int root = find(idx);
         if (rootToCombinationId.find(root) == rootToCombinationId.end()) {
@@ -4007,7 +8375,7 @@ extern "C" void heidic_combine_selected_cubes() {
             rootToCombinationId[root] = newId;
             g_combinationExpanded[newId] = false;
         }
-        g_createdCubes[idx].combination_id = rootToCombinationId[root];
+        g_createdCubes.combinationId[idx] = rootToCombinationId[root];
     }
     
     // Clear selection after combining
@@ -4096,170 +8464,133 @@ extern "C" void heidic_set_selected_texture(const char* texture_name) {
     g_selectedTexture = new_texture;
 }
 
-// Load texture preview and return ImGui texture ID (VkDescriptorSet)
+// Load a texture's palette thumbnail and return its preview id for heidic_imgui_image_button()
 // Returns 0 if failed
 extern "C" int64_t heidic_get_texture_preview_id(const char* texture_name) {
     if (!texture_name || strlen(texture_name) == 0) return 0;
+    if (g_nullRenderer) return 0;  // No atlas without a device; callers fall back to text buttons
     
     std::string name = texture_name;
     
     // Check cache first
     auto it = g_texturePreviews.find(name);
     if (it != g_texturePreviews.end()) {
-        return (uint64_t)(uintptr_t)it->second.descriptorSet;
+        return -(int64_t)it->second - 1;
     }
     
-    // Load texture
     if (g_texturesBaseDir.empty()) {
         heidic_load_texture_list();
     }
     
     if (g_texturesBaseDir.empty()) return 0;
     
-    std::string full_path = g_texturesBaseDir + "/" + name;
-    
-    int texWidth, texHeight, texChannels;
-    stbi_uc* pixels = stbi_load(full_path.c_str(), &texWidth, &texHeight, &texChannels, STBI_rgb_alpha);
-    if (!pixels) {
-        std::cerr << "[EDEN] Failed to load texture: " << full_path << std::endl;
-        return 0;
-    }
-    
-    // Create Vulkan image (similar to createTextureAndDescriptors)
-    VkImage image;
-    VkDeviceMemory imageMemory;
-    VkImageView imageView;
-    
-    VkDeviceSize imageSize = (VkDeviceSize)(texWidth) * texHeight * 4;
-    
-    // Create staging buffer
-    VkBuffer stagingBuffer;
-    VkDeviceMemory stagingBufferMemory;
-    createBuffer(imageSize, VK_BUFFER_USAGE_TRANSFER_SRC_BIT, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT, stagingBuffer, stagingBufferMemory);
-    
-    void* data;
-    vkMapMemory(g_device, stagingBufferMemory, 0, imageSize, 0, &data);
-    memcpy(data, pixels, (size_t)imageSize);
-    vkUnmapMemory(g_device, stagingBufferMemory);
-    stbi_image_free(pixels);
-    
-    // Create image
-    VkImageCreateInfo imageInfo = {};
-    imageInfo.sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
-    imageInfo.imageType = VK_IMAGE_TYPE_2D;
-    imageInfo.extent.width = texWidth;
-    imageInfo.extent.height = texHeight;
-    imageInfo.extent.depth = 1;
-    imageInfo.mipLevels = 1;
-    imageInfo.arrayLayers = 1;
-    imageInfo.format = VK_FORMAT_R8G8B8A8_UNORM;
-    imageInfo.tiling = VK_IMAGE_TILING_OPTIMAL;
-    imageInfo.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
-    imageInfo.usage = VK_IMAGE_USAGE_TRANSFER_DST_BIT | VK_IMAGE_USAGE_SAMPLED_BIT;
-    imageInfo.samples = VK_SAMPLE_COUNT_1_BIT;
-    imageInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
-    
-    vkCreateImage(g_device, &imageInfo, nullptr, &image);
-    
-    VkMemoryRequirements memRequirements;
-    vkGetImageMemoryRequirements(g_device, image, &memRequirements);
-    
-    VkMemoryAllocateInfo allocInfo = {};
-    allocInfo.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
-    allocInfo.allocationSize = memRequirements.size;
-    allocInfo.memoryTypeIndex = findMemoryType(memRequirements.memoryTypeBits, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
-    
-    vkAllocateMemory(g_device, &allocInfo, nullptr, &imageMemory);
-    vkBindImageMemory(g_device, image, imageMemory, 0);
-    
-    // Transition and copy
-    transitionImageLayout(image, imageInfo.format, VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL);
-    
-    VkCommandBufferAllocateInfo cbAlloc = {};
-    cbAlloc.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
-    cbAlloc.commandPool = g_commandPool;
-    cbAlloc.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
-    cbAlloc.commandBufferCount = 1;
-    
-    VkCommandBuffer cmd;
-    vkAllocateCommandBuffers(g_device, &cbAlloc, &cmd);
-    
-    VkCommandBufferBeginInfo beginInfo = {};
-    beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
-    beginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
-    vkBeginCommandBuffer(cmd, &beginInfo);
-    
-    VkBufferImageCopy region = {};
-    region.bufferOffset = 0;
-    region.bufferRowLength = 0;
-    region.bufferImageHeight = 0;
-    region.imageSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
-    region.imageSubresource.mipLevel = 0;
-    region.imageSubresource.baseArrayLayer = 0;
-    region.imageSubresource.layerCount = 1;
-    region.imageOffset = {0, 0, 0};
-    region.imageExtent = {(uint32_t)texWidth, (uint32_t)texHeight, 1};
-    
-    vkCmdCopyBufferToImage(cmd, stagingBuffer, image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1, &region);
-    
-    vkEndCommandBuffer(cmd);
-    
-    VkSubmitInfo submitInfo = {};
-    submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
-    submitInfo.commandBufferCount = 1;
-    submitInfo.pCommandBuffers = &cmd;
-    vkQueueSubmit(g_graphicsQueue, 1, &submitInfo, VK_NULL_HANDLE);
-    vkQueueWaitIdle(g_graphicsQueue);
-    
-    vkFreeCommandBuffers(g_device, g_commandPool, 1, &cmd);
-    
-    transitionImageLayout(image, imageInfo.format, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
-    
-    vkDestroyBuffer(g_device, stagingBuffer, nullptr);
-    vkFreeMemory(g_device, stagingBufferMemory, nullptr);
-    
-    // Create image view
-    VkImageViewCreateInfo viewInfo = {};
-    viewInfo.sType = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
-    viewInfo.image = image;
-    viewInfo.viewType = VK_IMAGE_VIEW_TYPE_2D;
-    viewInfo.format = imageInfo.format;
-    viewInfo.subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
-    viewInfo.subresourceRange.baseMipLevel = 0;
-    viewInfo.subresourceRange.levelCount = 1;
-    viewInfo.subresourceRange.baseArrayLayer = 0;
-    viewInfo.subresourceRange.layerCount = 1;
-    
-    vkCreateImageView(g_device, &viewInfo, nullptr, &imageView);
-    
-    // Create ImGui descriptor set
-    VkDescriptorSet descriptorSet = ImGui_ImplVulkan_AddTexture(g_textureSampler, imageView, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
+    const ThumbnailCacheEntry* thumbnail = findThumbnail(g_texturesBaseDir + "/" + name);
+    if (!thumbnail) return 0;
+    ThumbnailAtlasPage* page = thumbnailPageWithSpace();
+    if (!page || !uploadThumbnail(*page, page->used, thumbnail->pixels.data())) return 0;
     
-    // Cache it
     TexturePreview preview;
-    preview.descriptorSet = descriptorSet;
-    preview.width = texWidth;
-    preview.height = texHeight;
-    g_texturePreviews[name] = preview;
+    preview.page = (uint32_t)(page - g_thumbnailPages.data());
+    preview.cell = page->used++;
+    preview.width = thumbnail->width;
+    preview.height = thumbnail->height;
+    g_thumbnails.push_back(preview);
+    int index = (int)g_thumbnails.size() - 1;
+    g_texturePreviews[name] = index;
     
-    return (uint64_t)(uintptr_t)descriptorSet;
+    return -(int64_t)index - 1;
 }
 
-// Get texture preview size
+// Get texture preview size (of the source image)
 extern "C" void heidic_get_texture_preview_size(const char* texture_name, int* width, int* height) {
     if (!texture_name || !width || !height) return;
     
     std::string name = texture_name;
     auto it = g_texturePreviews.find(name);
     if (it != g_texturePreviews.end()) {
-        *width = it->second.width;
-        *height = it->second.height;
+        *width = g_thumbnails[it->second].width;
+        *height = g_thumbnails[it->second].height;
     } else {
         *width = 0;
         *height = 0;
     }
 }
 
+// Write generated thumbnails to the on-disk cache now (also done by heidic_cleanup_renderer)
+extern "C" void heidic_save_texture_thumbnails() {
+    saveThumbnailCache();
+}
+
+// Release a cache entry's GPU resources; the entry stays in the cache marked evicted
+static void evictCachedTexture(TextureResource& entry) {
+    if (!entry.descriptorSets.empty() && entry.descriptorPool != VK_NULL_HANDLE) {
+        vkFreeDescriptorSets(g_device, entry.descriptorPool, (uint32_t)entry.descriptorSets.size(), entry.descriptorSets.data());
+    }
+    entry.descriptorSets.clear();
+    entry.descriptorPool = VK_NULL_HANDLE;
+    if (entry.view != VK_NULL_HANDLE) vkDestroyImageView(g_device, entry.view, nullptr);
+    entry.view = VK_NULL_HANDLE;
+    destroyImage(entry.image, entry.memory);
+    releaseTextureSlot(entry.slot);
+    entry.slot = 0;
+    entry.resident = false;
+    entry.evicted = true;
+}
+
+// Called once per frame from heidic_begin_frame() (after the slot's fence wait and collectUploads()):
+// while sampled texture memory is over budget, release the least recently used textures that no
+// frame in flight (by submit serial) or pending upload can still touch
+static void evictTextures() {
+    // The selection carries over into this frame's draws until it changes
+    if (g_currentTexture != nullptr) {
+        g_currentTexture->lastUsedSerial = nextSubmitSerial();
+    }
+    if (g_textureBudgetBytes == 0 || g_gpuMemoryStats.textureBytes <= g_textureBudgetBytes) return;
+    
+    struct EvictionCandidate {
+        uint64_t lastUsedSerial;
+        TextureResource* texture;
+    };
+    std::vector<EvictionCandidate> candidates;
+    for (auto it = g_textureCache.begin(); it != g_textureCache.end(); ++it) {
+        TextureResource& entry = it->second;
+        if (!entry.resident || &entry == g_currentTexture) continue;
+        if (entry.lastUsedSerial > g_completedSerial) continue;  // A frame in flight may still sample it
+        if (!isUploadSerialComplete(entry.uploadSerial)) continue;
+        candidates.push_back({entry.lastUsedSerial, &entry});
+    }
+    std::sort(candidates.begin(), candidates.end(), [](const EvictionCandidate& a, const EvictionCandidate& b) {
+        return a.lastUsedSerial < b.lastUsedSerial;
+    });
+    
+    for (EvictionCandidate& candidate : candidates) {
+        if (g_gpuMemoryStats.textureBytes <= g_textureBudgetBytes) break;
+        evictCachedTexture(*candidate.texture);
+        g_textureCacheEvictions++;
+    }
+}
+
+// Budget for cached textures in MB (0 = unlimited). Takes effect at the next frame.
+extern "C" void heidic_set_texture_budget_mb(int megabytes) {
+    g_textureBudgetBytes = megabytes > 0 ? (VkDeviceSize)megabytes * 1024 * 1024 : 0;
+}
+
+extern "C" int heidic_get_texture_budget_mb() {
+    return static_cast<int>(g_textureBudgetBytes / (1024 * 1024));
+}
+
+extern "C" int heidic_get_texture_cache_hits() {
+    return static_cast<int>(g_textureCacheHits);
+}
+
+extern "C" int heidic_get_texture_cache_misses() {
+    return static_cast<int>(g_textureCacheMisses);
+}
+
+extern "C" int heidic_get_texture_cache_evictions() {
+    return static_cast<int>(g_textureCacheEvictions);
+}
+
 // Note: g_editingCombinationId and g_combinationNameBuffer 
 // are declared earlier in the file (near top) so heidic_begin_frame() can access them
 
@@ -4271,17 +8602,13 @@ extern "C" void heidic_combine_connected_cubes() {
 extern "C" void heidic_combine_connected_cubes_from_selection(int selected_cube_storage_index) {
     std::cout << "[DEBUG] heidic_combine_connected_cubes_from_selection: START, selected_index=" << selected_cube_storage_index << std::endl;
     std::cout << "[DEBUG] Total cubes: " << g_createdCubes.size() << std::endl;
-    int active_count = 0;
-    for (const auto& cube : g_createdCubes) {
-        if (cube.active == 1) active_count++;
-    }
-    std::cout << "[DEBUG] Active cubes: " << active_count << std::endl;
+    std::cout << "[DEBUG] Active cubes: " << countActiveCubes() << std::endl;
     std::cout.flush();
     
     // If a cube is selected, validate it
     if (selected_cube_storage_index >= 0) {
         if (selected_cube_storage_index >= (int)g_createdCubes.size() || 
-            g_createdCubes[selected_cube_storage_index].active != 1) {
+            g_createdCubes.active[selected_cube_storage_index] != 1) {
             // Invalid selection, silently fail
             std::cout << "[DEBUG] heidic_combine_connected_cubes_from_selection: Invalid selection, silently failing" << std::endl;
             std::cout.flush();
@@ -4290,9 +8617,9 @@ extern "C" void heidic_combine_connected_cubes_from_selection(int selected_cube_
     }
     
     // Reset all combination IDs
-    for (auto& cube : g_createdCubes) {
-        if (cube.active == 1) {
-            cube.combination_id = -1;
+    for (size_t i = 0; i < g_createdCubes.size(); i++) {
+        if (g_createdCubes.active[i] == 1) {
+            g_createdCubes.combinationId[i] = -1;
         }
     }
     
@@ -4332,7 +8659,7 @@ extern "C" void heidic_combine_connected_cubes_from_selection(int selected_cube_
     if (selected_cube_storage_index >= 0) {
         // Only combine cubes connected to the selected cube that are NOT already in a combination
         // If the selected cube is already in a combination, do nothing (allow multiple separate combinations)
-        if (g_createdCubes[selected_cube_storage_index].combination_id >= 0) {
+        if (g_createdCubes.combinationId[selected_cube_storage_index] >= 0) {
             // Selected cube is already in a combination, skip
             return;
         }
@@ -4349,14 +8676,13 @@ extern "C" void heidic_combine_connected_cubes_from_selection(int selected_cube_
             toVisit.pop();
             
             // Check all other cubes for connectivity
-            for (size_t i = 0; i < g_createdCubes.size(); i++) {
-                if (g_createdCubes[i].active != 1) continue;
+            for (uint32_t i : g_createdCubes.live) {
                 if (visited[i]) continue;
                 if ((int)i == current) continue;
                 // Skip cubes that are already in a combination
-                if (g_createdCubes[i].combination_id >= 0) continue;
+                if (g_createdCubes.combinationId[i] >= 0) continue;
                 
-                if (cubesAreTouching(g_createdCubes[current], g_createdCubes[i])) {
+                if (cubesAreTouching(current, i)) {
                     unite(current, (int)i);
                     visited[i] = true;
                     toVisit.push((int)i);
@@ -4370,23 +8696,22 @@ extern "C" void heidic_combine_connected_cubes_from_selection(int selected_cube_
         g_combinationExpanded[newId] = false;  // Collapsed by default
         
         for (size_t i = 0; i < g_createdCubes.size(); i++) {
-            if (g_createdCubes[i].active != 1) continue;
-            if (g_createdCubes[i].combination_id >= 0) continue;  // Skip already combined cubes
+            if (g_createdCubes.active[i] != 1) continue;
+            if (g_createdCubes.combinationId[i] >= 0) continue;  // Skip already combined cubes
             if (find((int)i) == selectedRoot) {
-                g_createdCubes[i].combination_id = newId;
+                g_createdCubes.combinationId[i] = newId;
             }
         }
     } else {
         // Original behavior: combine all connected cubes
         // Check all pairs of active cubes for connectivity
         int connections_found = 0;
-        for (size_t i = 0; i < g_createdCubes.size(); i++) {
-            if (g_createdCubes[i].active != 1) continue;
-            
-            for (size_t j = i + 1; j < g_createdCubes.size(); j++) {
-                if (g_createdCubes[j].active != 1) continue;
-                
-                if (cubesAreTouching(g_createdCubes[i], g_createdCubes[j])) {
+        const std::vector<uint32_t>& live = g_createdCubes.live;
+        for (size_t a = 0; a < live.size(); a++) {
+            for (size_t b = a + 1; b < live.size(); b++) {
+                uint32_t i = live[a];
+                uint32_t j = live[b];
+                if (cubesAreTouching(i, j)) {
                     std::cout << "[DEBUG] Found connection between cube " << i << " and cube " << j << std::endl;
                     unite((int)i, (int)j);
                     connections_found++;
@@ -4400,7 +8725,7 @@ extern "C" void heidic_combine_connected_cubes_from_selection(int selected_cube_
         std::map<int, int> rootToCombinationId;
         
         for (size_t i = 0; i < g_createdCubes.size(); i++) {
-            if (g_createdCubes[i].active != 1) continue;
+            if (g_createdCubes.active[i] != 1) continue;
             
             int root = find((int)i);
             if (rootToCombinationId.find(root) == rootToCombinationId.end()) {
@@ -4410,7 +8735,7 @@ extern "C" void heidic_combine_connected_cubes_from_selection(int selected_cube_
                 g_combinationExpanded[newId] = false;  // Collapsed by default
                 std::cout << "[DEBUG] Created new combination group " << newId << " for root " << root << std::endl;
             }
-            g_createdCubes[i].combination_id = rootToCombinationId[root];
+            g_createdCubes.combinationId[i] = rootToCombinationId[root];
         }
         std::cout << "[DEBUG] Total combination groups created: " << g_nextCombinationId << std::endl;
         std::cout.flush();
@@ -4420,15 +8745,15 @@ extern "C" void heidic_combine_connected_cubes_from_selection(int selected_cube_
 // Get combination ID for a cube (-1 if not in a combination)
 extern "C" int heidic_get_cube_combination_id(int cube_index) {
     if (cube_index < 0 || cube_index >= (int)g_createdCubes.size()) return -1;
-    return g_createdCubes[cube_index].combination_id;
+    return g_createdCubes.combinationId[cube_index];
 }
 
 // Get number of cubes in a combination
 extern "C" int heidic_get_combination_cube_count(int combination_id) {
     if (combination_id < 0) return 0;
     int count = 0;
-    for (const auto& cube : g_createdCubes) {
-        if (cube.active == 1 && cube.combination_id == combination_id) {
+    for (uint32_t i : g_createdCubes.live) {
+        if (g_createdCubes.combinationId[i] == combination_id) {
             count++;
         }
     }
@@ -4439,7 +8764,7 @@ extern "C" int heidic_get_combination_cube_count(int combination_id) {
 extern "C" int heidic_get_combination_first_cube(int combination_id) {
     if (combination_id < 0) return -1;
     for (size_t i = 0; i < g_createdCubes.size(); i++) {
-        if (g_createdCubes[i].active == 1 && g_createdCubes[i].combination_id == combination_id) {
+        if (g_createdCubes.active[i] == 1 && g_createdCubes.combinationId[i] == combination_id) {
             return (int)i;
         }
     }
@@ -4449,12 +8774,12 @@ extern "C" int heidic_get_combination_first_cube(int combination_id) {
 // Get next cube in same combination (for iteration)
 extern "C" int heidic_get_combination_next_cube(int cube_index) {
     if (cube_index < 0 || cube_index >= (int)g_createdCubes.size()) return -1;
-    int combination_id = g_createdCubes[cube_index].combination_id;
+    int combination_id = g_createdCubes.combinationId[cube_index];
     if (combination_id < 0) return -1;
     
     // Find next cube with same combination_id
     for (size_t i = cube_index + 1; i < g_createdCubes.size(); i++) {
-        if (g_createdCubes[i].active == 1 && g_createdCubes[i].combination_id == combination_id) {
+        if (g_createdCubes.active[i] == 1 && g_createdCubes.combinationId[i] == combination_id) {
             return (int)i;
         }
     }
@@ -4702,21 +9027,17 @@ extern "C" int heidic_save_level(const char* filepath) {
     file << "EDEN_LEVEL v1\n";
     
     // Write cube count
-    int active_count = 0;
-    for (const auto& cube : g_createdCubes) {
-        if (cube.active == 1) active_count++;
-    }
-    file << "CUBE_COUNT " << active_count << "\n";
+    file << "CUBE_COUNT " << countActiveCubes() << "\n";
     
     // Write all active cubes
-    for (size_t i = 0; i < g_createdCubes.size(); i++) {
-        const auto& cube = g_createdCubes[i];
-        if (cube.active == 1) {
+    const CubeStore& cubes = g_createdCubes;
+    for (size_t i = 0; i < cubes.size(); i++) {
+        if (cubes.active[i] == 1) {
             file << "CUBE " << i << " " 
-                 << cube.x << " " << cube.y << " " << cube.z << " "
-                 << cube.sx << " " << cube.sy << " " << cube.sz << " "
-                 << cube.r << " " << cube.g << " " << cube.b << " "
-                 << cube.active << " " << cube.combination_id << "\n";
+                 << cubes.x[i] << " " << cubes.y[i] << " " << cubes.z[i] << " "
+                 << cubes.sx[i] << " " << cubes.sy[i] << " " << cubes.sz[i] << " "
+                 << cubes.r[i] << " " << cubes.g[i] << " " << cubes.b[i] << " "
+                 << (int)cubes.active[i] << " " << cubes.combinationId[i] << "\n";
         }
     }
     
@@ -4754,8 +9075,11 @@ extern "C" int heidic_load_level(const char* filepath) {
         return 0;  // Failed to open file
     }
     
-    // Clear existing cubes
+    // Clear existing cubes (stored indices would now refer to loaded cubes)
     g_createdCubes.clear();
+    g_selectedCubeIndices.clear();
+    sceneBvhInvalidate();
+    heidic_invalidate_static_cubes();  // An invalid file still leaves an empty level
     
     std::string line;
     std::string version;
@@ -4788,33 +9112,35 @@ extern "C" int heidic_load_level(const char* filepath) {
         iss >> token;
         
         if (token == "CUBE") {
-            CreatedCube cube;
-            int index;
-            iss >> index >> cube.x >> cube.y >> cube.z 
-                >> cube.sx >> cube.sy >> cube.sz 
-                >> cube.r >> cube.g >> cube.b >> cube.active;
+            int index = -1;
+            float x = 0.0f, y = 0.0f, z = 0.0f;
+            float sx = 0.0f, sy = 0.0f, sz = 0.0f;
+            float r = 0.0f, g = 0.0f, b = 0.0f;
+            int active = 0;
+            iss >> index >> x >> y >> z 
+                >> sx >> sy >> sz 
+                >> r >> g >> b >> active;
+            if (index < 0) continue;
             
             // Read combination_id if present (for backward compatibility)
-            cube.combination_id = -1;  // Default: no combination
-            if (iss >> cube.combination_id) {
-                // Successfully read combination_id
-            } else {
+            int combination_id = -1;  // Default: no combination
+            if (!(iss >> combination_id)) {
                 // Old format - no combination_id, set to -1
-                cube.combination_id = -1;
+                combination_id = -1;
             }
             
-            // Ensure vector is large enough
-            while ((int)g_createdCubes.size() <= index) {
-                CreatedCube empty;
-                empty.x = empty.y = empty.z = 0.0f;
-                empty.sx = empty.sy = empty.sz = 200.0f;
-                empty.r = empty.g = empty.b = 1.0f;
-                empty.active = 0;
-                empty.combination_id = -1;
-                g_createdCubes.push_back(empty);
+            // Ensure storage is large enough (gaps become deleted cubes)
+            if ((int)g_createdCubes.size() <= index) {
+                g_createdCubes.resize(index + 1);
             }
             
-            g_createdCubes[index] = cube;
+            CubeStore& cubes = g_createdCubes;
+            cubes.x[index] = x; cubes.y[index] = y; cubes.z[index] = z;
+            cubes.sx[index] = sx; cubes.sy[index] = sy; cubes.sz[index] = sz;
+            cubes.r[index] = r; cubes.g[index] = g; cubes.b[index] = b;
+            cubes.active[index] = (uint8_t)active;
+            cubes.combinationId[index] = combination_id;
+            cubes.textureId[index] = 0;  // Level files don't store textures
         } else if (token == "COMBINATION_NAME") {
             int combination_id;
             std::string name;
@@ -4831,6 +9157,8 @@ extern "C" int heidic_load_level(const char* filepath) {
         }
     }
     
+    g_createdCubes.rebuildIndex();
+    heidic_invalidate_static_cubes();  // Columns were written directly - rebake every bucket (old ones are retired)
     file.close();
     return 1;  // Success
 }
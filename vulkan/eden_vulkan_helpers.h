@@ -18,6 +18,10 @@ extern "C" {
     // Helpers
     void heidic_glfw_vulkan_hints();
     int heidic_init_renderer(GLFWwindow* window);
+    int heidic_init_renderer_headless(int width, int height);  // Offscreen images instead of a swapchain; no window, surface or glfwInit needed
+    int heidic_is_headless();
+    int heidic_init_renderer_null(int width, int height);  // No Vulkan device: CPU side of every frame runs, nothing is recorded (profiling)
+    int heidic_is_null_renderer();
     void heidic_cleanup_renderer();
     int heidic_window_should_close(GLFWwindow* window);
     void heidic_poll_events();
@@ -27,13 +31,54 @@ extern "C" {
     // Frame Control
     void heidic_begin_frame();
     void heidic_end_frame();
+    double heidic_get_renderer_init_ms();  // Wall time of heidic_init_renderer (logged with cold/warm pipeline cache)
+    void heidic_flush_uploads();  // Submit recorded buffer/texture uploads now (end of a load phase); also done every frame
+    int heidic_get_upload_submit_count();  // Upload submissions since startup
+    int heidic_get_upload_copy_count();  // Buffer/image copies recorded since startup
+    void heidic_set_frames_in_flight(int count);  // Call before heidic_init_renderer (default 2, clamped to swapchain image count)
+    int heidic_get_frames_in_flight();
+    double heidic_get_frame_time_ms();  // Wall time between the last two heidic_begin_frame calls
+    double heidic_get_end_frame_cpu_ms();  // CPU time of the last heidic_end_frame before submit/present
+    double heidic_get_time_ms();  // Monotonic clock for timing script sections
+    int heidic_save_frame(const char* path);  // Headless only: write the last finished frame to a .bmp (stalls the GPU)
+    
+    // Profiler (per-phase CPU scope timers and GPU timestamps; phase order: begin frame, cube batches,
+    // render queue, lines, ImGui, submit, present, frame)
+    void heidic_set_profiler_enabled(int enabled);  // 1 = time phases (default); GPU timestamps need a graphics queue with valid bits
+    void heidic_set_profiler_overlay(int visible);  // ImGui window with per-phase CPU/GPU ms and p50/p95/p99
+    int heidic_get_profile_phase_count();
+    const char* heidic_get_profile_phase_name(int phase);
+    float heidic_get_profile_cpu_ms(int phase);  // Last completed frame, -1 if none
+    float heidic_get_profile_gpu_ms(int phase);  // Last frame with a GPU result (frames in flight behind), -1 if none
+    float heidic_get_profile_cpu_percentile(int phase, float percentile);  // Over the last 240 frames, e.g. 95
+    float heidic_get_profile_gpu_percentile(int phase, float percentile);
+    
+    // GPU Memory (buffers and images are sub-allocated from large blocks)
+    float heidic_get_texture_memory_mb();  // Sampled texture images (cache, thumbnail atlas, default texture)
+    float heidic_get_gpu_memory_reserved_mb();  // Total size of device memory blocks
+    float heidic_get_gpu_memory_used_mb();  // Handed out to buffers and images (padding included)
+    float heidic_get_gpu_memory_wasted_mb();  // Alignment padding and unusable leftovers
+    int heidic_get_gpu_memory_block_count();  // Live vkAllocateMemory allocations
+    int heidic_get_gpu_allocation_count();  // Live sub-allocations
+    
+    // Render Queue (draws are sorted by pipeline/texture/mesh/depth and submitted in heidic_end_frame)
+    void heidic_set_render_queue_sorting(int enabled);  // 0 = submit in call order (for comparison)
+    int heidic_get_render_packet_count();        // Stats of the last submitted frame
+    int heidic_get_render_draw_calls();
+    int heidic_get_render_pipeline_binds();
+    int heidic_get_render_descriptor_binds();
+    int heidic_get_render_vertex_buffer_binds();
+    int heidic_get_render_instance_count();
+    void heidic_set_frustum_culling(int enabled);  // 1 = cull cubes/meshes outside the camera frustum (default)
+    int heidic_get_cull_visible_count();  // Boxes that passed the frustum test last frame
+    int heidic_get_cull_culled_count();   // Boxes rejected last frame
     
     // Drawing
     void heidic_draw_cube(float x, float y, float z, float rx, float ry, float rz, float sx, float sy, float sz);
     void heidic_draw_cube_grey(float x, float y, float z, float rx, float ry, float rz, float sx, float sy, float sz);
     void heidic_draw_cube_blue(float x, float y, float z, float rx, float ry, float rz, float sx, float sy, float sz);
     void heidic_draw_cube_colored(float x, float y, float z, float rx, float ry, float rz, float sx, float sy, float sz, float r, float g, float b);
-    void heidic_flush_colored_cubes();  // Flush current batch (draw immediately and clear)
+    void heidic_flush_colored_cubes();  // Flush current batch (queue it with the current texture and clear)
     void heidic_draw_line(float x1, float y1, float z1, float x2, float y2, float z2, float r, float g, float b);
     void heidic_draw_model_origin(float x, float y, float z, float rx, float ry, float rz, float length);
     void heidic_update_camera(float px, float py, float pz, float rx, float ry, float rz);
@@ -42,6 +87,7 @@ extern "C" {
     void heidic_update_camera_from_struct(Camera camera);
     
     // Mesh Loading
+    void heidic_set_mesh_vertex_format(int format);  // 0 = full 32-byte vertices, 1 = packed 16-byte (applies to meshes loaded afterwards)
     int heidic_load_ascii_model(const char* filename);
     void heidic_draw_mesh(int mesh_id, float x, float y, float z, float rx, float ry, float rz);
 
@@ -162,6 +208,18 @@ extern "C" {
     int heidic_raycast_ground_hit(float x, float y, float z, float maxDistance);
     Vec3 heidic_raycast_ground_hit_point(float x, float y, float z, float maxDistance);
     
+    // Scene raycast (closest created cube through an engine-maintained BVH)
+    int heidic_raycast_scene(GLFWwindow* window);  // From the mouse cursor; returns hit kind: 0 = none, 1 = cube
+    int heidic_raycast_scene_ray(float ox, float oy, float oz, float dx, float dy, float dz, float maxDistance);  // maxDistance <= 0 = unlimited
+    int heidic_get_scene_hit_kind();  // Last scene raycast
+    int heidic_get_scene_hit_index();  // Cube storage index, -1 if nothing was hit
+    float heidic_get_scene_hit_distance();
+    Vec3 heidic_get_scene_hit_point();
+    void heidic_set_scene_bvh(int enabled);  // 0 = test every cube (for comparison)
+    int heidic_get_scene_bvh_node_count();
+    int heidic_get_scene_bvh_build_count();  // Full rebuilds since startup (moves only refit)
+    float heidic_benchmark_ray_boxes(int boxCount, int iterations);  // Prints boxes/ns per ray-box kernel; returns the one raycasts use
+    
     // Debug: Print raycast info to console
     void heidic_debug_print_ray(GLFWwindow* window);
     // Draw mouse ray for visual debugging
@@ -174,8 +232,9 @@ extern "C" {
     // Dynamic Cube Storage System
     int heidic_create_cube(float x, float y, float z, float sx, float sy, float sz);
     int heidic_create_cube_with_color(float x, float y, float z, float sx, float sy, float sz, float r, float g, float b);
+    int heidic_create_cube_with_texture(float x, float y, float z, float sx, float sy, float sz, float r, float g, float b, const char* texture_name);  // "" = default texture
     int heidic_get_cube_count();  // Returns count of active cubes
-    int heidic_get_cube_total_count();  // Returns total count (including deleted)
+    int heidic_get_cube_total_count();  // Returns slot count (including deleted slots awaiting reuse)
     float heidic_get_cube_x(int index);
     float heidic_get_cube_y(int index);
     float heidic_get_cube_z(int index);
@@ -187,11 +246,29 @@ extern "C" {
     float heidic_get_cube_b(int index);
     const char* heidic_get_cube_texture_name(int index);  // Get cube texture name
     int heidic_load_texture_for_rendering(const char* texture_name);  // Load texture and update global texture for rendering
+    void heidic_set_texture_streaming(int enabled);  // 1 = decode/upload new textures in the background (default), 0 = load synchronously
+    int heidic_get_pending_texture_count();  // Textures still streaming in (default texture is bound until resident)
+    void heidic_set_texture_mipmaps(int enabled);  // 1 = full mip chains + trilinear sampling (default), 0 = level 0 only; call before heidic_init_renderer
+    int heidic_get_texture_mipmaps();
+    void heidic_set_texture_budget_mb(int megabytes);  // Cached textures are evicted LRU above this (default 256, 0 = unlimited)
+    int heidic_get_texture_budget_mb();
+    int heidic_get_texture_cache_hits();  // Lookups served from the cache
+    int heidic_get_texture_cache_misses();  // Loads (first use or reload after eviction)
+    int heidic_get_texture_cache_evictions();  // Textures released by the budget
+    int heidic_cook_texture(const char* source_path, const char* cooked_path, int compress);  // Write a .etex (mip chain, BC1/BC3 if compress = 1, RGBA8 fallback)
+    int heidic_cook_textures(const char* textures_dir, int compress);  // Cook stale .bmp files into <dir>/cooked/ ("" = texture list dir); returns count
     int heidic_get_cube_active(int index);
     void heidic_set_cube_pos(int index, float x, float y, float z);
     void heidic_set_cube_pos_f(float index, float x, float y, float z);  // Float index version
     void heidic_delete_cube(int index);
     int heidic_find_next_active_cube_index(int start_index);  // Returns -1 if no more
+    int heidic_get_live_cube_index(int n);  // Storage index of the n-th active cube, n < heidic_get_cube_count() (order changes on delete)
+    int heidic_get_cube_handle(int index);  // Generational handle, -1 if not an active cube
+    int heidic_get_cube_index_from_handle(int handle);  // -1 once the cube is deleted (its slot may be reused)
+    void heidic_draw_static_cubes();  // Draw all created cubes from the baked per-texture cache (rebuilds edited buckets)
+    void heidic_invalidate_static_cubes();  // Force a full rebuild on the next heidic_draw_static_cubes()
+    int heidic_get_static_cube_bucket_count();
+    int heidic_get_static_cube_rebuild_count();  // Bucket rebuilds since startup
     float heidic_int_to_float(int value);  // Convert i32 to f32
     int heidic_float_to_int(float value);  // Convert f32 to i32
     float heidic_random_float();  // Returns random float between 0.0 and 1.0
@@ -228,6 +305,8 @@ extern "C" {
     void heidic_toggle_selection(int cube_storage_index);
     int heidic_is_cube_selected(int cube_storage_index);
     int heidic_get_selection_count();
+    void heidic_draw_selected_cube_outlines(float r, float g, float b);  // Wireframe around every selected cube
+    void heidic_draw_all_cubes(int selection_outlines);  // Every active cube, batched per texture; 1 = also outline selected cubes
     int* heidic_get_selected_cube_indices();
     void heidic_combine_selected_cubes();
     
@@ -237,8 +316,9 @@ extern "C" {
     const char* heidic_get_texture_name(int index);
     const char* heidic_get_selected_texture();
     void heidic_set_selected_texture(const char* texture_name);
-    int64_t heidic_get_texture_preview_id(const char* texture_name);  // Get ImGui texture ID for preview
-    void heidic_get_texture_preview_size(const char* texture_name, int* width, int* height);  // Get texture size
+    int64_t heidic_get_texture_preview_id(const char* texture_name);  // 64x64 palette thumbnail id (atlas cell) for heidic_imgui_image_button
+    void heidic_get_texture_preview_size(const char* texture_name, int* width, int* height);  // Get texture size (source image)
+    void heidic_save_texture_thumbnails();  // Write new thumbnails to <textures>/cooked/thumbnails.cache (also done at cleanup)
     int heidic_imgui_input_text_combination_name();  // Input text for editing combination name (returns 1 on Enter)
     int heidic_imgui_should_stop_editing();  // Check if we should stop editing (Escape or click outside)
     void heidic_toggle_combination_expanded(int combination_id);  // Toggle expand/collapse state